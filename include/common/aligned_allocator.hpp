@@ -0,0 +1,38 @@
+#ifndef CHARGE_COMMON_ALIGNED_ALLOCATOR_HPP
+#define CHARGE_COMMON_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace charge::common {
+
+static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// Allocator for std::vector that starts the storage at an Alignment boundary
+template <typename T, std::size_t Alignment = CACHE_LINE_SIZE> class AlignedAllocator {
+  public:
+    using value_type = T;
+
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    T *allocate(const std::size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T *ptr, const std::size_t) noexcept {
+        ::operator delete(ptr, std::align_val_t{Alignment});
+    }
+
+    template <typename U> bool operator==(const AlignedAllocator<U, Alignment> &) const {
+        return true;
+    }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Alignment> &) const {
+        return false;
+    }
+};
+} // namespace charge::common
+
+#endif
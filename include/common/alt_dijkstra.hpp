@@ -0,0 +1,143 @@
+#ifndef CHARGE_COMMON_ALT_DIJKSTRA_HPP
+#define CHARGE_COMMON_ALT_DIJKSTRA_HPP
+
+#include "common/dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/landmarks.hpp"
+#include "common/lazy_clear_vector.hpp"
+
+#include <cmath>
+
+namespace charge::common {
+
+// Average potentials for bidirectional ALT:
+//   p_f(v) = (pi_t(v) - pi_s(v)) / 2 and p_r(v) = -p_f(v)
+// where pi_t and pi_s are the landmark lower bounds to the target and from the start.
+// Since p_f + p_r = 0 the usual sum criterion stays valid for the reduced keys.
+template <typename GraphT> class AverageLandmarkPotentials {
+  public:
+    using node_id_t = typename GraphT::node_id_t;
+    using key_t = std::int32_t;
+
+    AverageLandmarkPotentials(const Landmarks<GraphT> &landmarks)
+        : landmarks(landmarks), start(INVALID_ID), target(INVALID_ID),
+          cache(landmarks.num_nodes(), INF_WEIGHT) {}
+
+    void recompute(const node_id_t start_, const node_id_t target_) {
+        start = start_;
+        target = target_;
+        cache.clear();
+    }
+
+    key_t forward(const node_id_t node) const {
+        if (cache[node] == INF_WEIGHT) {
+            const auto to_target = landmarks.lower_bound(node, target);
+            const auto from_start = landmarks.lower_bound(start, node);
+            // rounding down on both directions keeps reduced weights non-negative
+            cache[node] = static_cast<key_t>(std::floor((to_target - from_start) / 2.0));
+        }
+        return cache[node];
+    }
+
+    key_t reverse(const node_id_t node) const { return -forward(node); }
+
+  private:
+    const Landmarks<GraphT> &landmarks;
+    node_id_t start;
+    node_id_t target;
+    mutable LazyClearVector<key_t> cache;
+};
+
+// Wraps a queue of the given type such that the keys are ordered by cost plus potential.
+// All keys that go in and out of this queue are plain costs, so it can be passed to
+// the usual dijkstra functions. The key including the potential is returned by min_key().
+template <typename QueueT, typename PotentialsT> class PotentialIDQueue {
+  public:
+    PotentialIDQueue(QueueT &queue, const PotentialsT &potentials, const bool reverse)
+        : queue(queue), potentials(potentials), reverse(reverse) {}
+
+    bool empty() const { return queue.empty(); }
+    unsigned size() const { return queue.size(); }
+    unsigned id_count() const { return queue.id_count(); }
+    bool contains_id(unsigned id) { return queue.contains_id(id); }
+    void clear() { queue.clear(); }
+
+    auto get_key(unsigned id) const { return queue.get_key(id) - potential(id); }
+
+    IDKeyPair peek() const {
+        auto top = queue.peek();
+        return IDKeyPair{top.id, top.key - potential(top.id)};
+    }
+
+    IDKeyPair pop() {
+        auto top = queue.pop();
+        return IDKeyPair{top.id, top.key - potential(top.id)};
+    }
+
+    void push(IDKeyPair p) { queue.push(IDKeyPair{p.id, p.key + potential(p.id)}); }
+
+    bool decrease_key(IDKeyPair p) {
+        return queue.decrease_key(IDKeyPair{p.id, p.key + potential(p.id)});
+    }
+
+    bool increase_key(IDKeyPair p) {
+        return queue.increase_key(IDKeyPair{p.id, p.key + potential(p.id)});
+    }
+
+    // Smallest key including the potential
+    auto min_key() const { return queue.peek().key; }
+
+  private:
+    std::int32_t potential(unsigned id) const {
+        return reverse ? potentials.reverse(id) : potentials.forward(id);
+    }
+
+    QueueT &queue;
+    const PotentialsT &potentials;
+    const bool reverse;
+};
+
+// Stops if one of the searches is exhausted or the reduced keys can't improve the best cost
+template <typename GraphT, typename QueueT>
+inline bool terminate_potential_sum_min(QueueT &forward_queue, QueueT &reverse_queue,
+                                        const typename GraphT::weight_t best_cost) {
+    return forward_queue.empty() || reverse_queue.empty() ||
+           forward_queue.min_key() + reverse_queue.min_key() >= best_cost;
+}
+
+// Bidirectional ALT: Bidirectional Dijkstra that orders both queues by the average
+// landmark potentials. Returns the shortest distance and sets the middle node.
+template <typename GraphT, typename QueueT, typename StallFn>
+auto alt_dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
+                  const GraphT &forward_graph, const GraphT &reverse_graph,
+                  AverageLandmarkPotentials<GraphT> &potentials, QueueT &forward_queue,
+                  QueueT &reverse_queue, CostVector<GraphT> &forward_costs,
+                  CostVector<GraphT> &reverse_costs, ParentVector<GraphT> &forward_parents,
+                  ParentVector<GraphT> &backward_parents, typename GraphT::node_id_t &middle,
+                  StallFn stall) {
+    using PotentialQueueT = PotentialIDQueue<QueueT, AverageLandmarkPotentials<GraphT>>;
+
+    potentials.recompute(start, target);
+    PotentialQueueT forward_potential_queue(forward_queue, potentials, false);
+    PotentialQueueT reverse_potential_queue(reverse_queue, potentials, true);
+
+    return dijkstra(start, target, forward_graph, reverse_graph, forward_potential_queue,
+                    reverse_potential_queue, forward_costs, reverse_costs, forward_parents,
+                    backward_parents, middle, terminate_potential_sum_min<GraphT, PotentialQueueT>,
+                    stall);
+}
+
+template <typename GraphT, typename QueueT>
+auto alt_dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
+                  const GraphT &forward_graph, const GraphT &reverse_graph,
+                  AverageLandmarkPotentials<GraphT> &potentials, QueueT &forward_queue,
+                  QueueT &reverse_queue, CostVector<GraphT> &forward_costs,
+                  CostVector<GraphT> &reverse_costs, ParentVector<GraphT> &forward_parents,
+                  ParentVector<GraphT> &backward_parents, typename GraphT::node_id_t &middle) {
+    return alt_dijkstra(start, target, forward_graph, reverse_graph, potentials, forward_queue,
+                        reverse_queue, forward_costs, reverse_costs, forward_parents,
+                        backward_parents, middle, no_stall<GraphT>);
+}
+} // namespace charge::common
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef CHARGE_COMMON_ARENA_HPP
+#define CHARGE_COMMON_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace charge::common {
+
+// Bump allocator for memory that lives exactly as long as one query.
+// reset() makes all memory available again in O(1) and keeps the blocks around for the next
+// query. Not thread safe, every search context owns its arena.
+//
+// Requests up to the block size are rounded up to a power of two. Deallocated buffers go to a
+// free list of their size class and are handed out again before the arena grows, so the
+// buffers that vectors leave behind when they grow are reused within the same query.
+class Arena : public std::pmr::memory_resource {
+  public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1u << 20;
+
+    explicit Arena(const std::size_t block_size = DEFAULT_BLOCK_SIZE)
+        : block_size(block_size), free_lists(size_class(block_size) + 1, nullptr), current(0),
+          offset(0) {}
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // All memory handed out so far is invalid after this call
+    void reset() {
+        current = 0;
+        offset = 0;
+        std::fill(free_lists.begin(), free_lists.end(), nullptr);
+    }
+
+    // Like reset but also returns all blocks to the system
+    void release() {
+        blocks.clear();
+        reset();
+    }
+
+    // Bytes of all blocks, used or not
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for (const auto &block : blocks)
+            total += block.size;
+        return total;
+    }
+
+  private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    // Buffers of a size class hold the pointer to the next free buffer of the same class
+    static constexpr std::size_t MIN_SIZE_CLASS = 4;
+
+    static std::size_t size_class(const std::size_t bytes) {
+        auto size_class = MIN_SIZE_CLASS;
+        while ((std::size_t{1} << size_class) < bytes)
+            ++size_class;
+        return size_class;
+    }
+
+    // Over-aligned and oversized requests are not pooled
+    bool is_pooled(const std::size_t bytes, const std::size_t alignment) const {
+        return alignment <= alignof(std::max_align_t) && bytes <= block_size;
+    }
+
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        if (!is_pooled(bytes, alignment))
+            return bump(bytes, alignment);
+
+        const auto index = size_class(bytes);
+        if (auto *ptr = free_lists[index]) {
+            free_lists[index] = *static_cast<void **>(ptr);
+            return ptr;
+        }
+        return bump(std::size_t{1} << index, alignof(std::max_align_t));
+    }
+
+    void do_deallocate(void *ptr, const std::size_t bytes, const std::size_t alignment) override {
+        if (!is_pooled(bytes, alignment))
+            return;
+
+        const auto index = size_class(bytes);
+        *static_cast<void **>(ptr) = free_lists[index];
+        free_lists[index] = ptr;
+    }
+
+    void *bump(const std::size_t bytes, const std::size_t alignment) {
+        while (current < blocks.size()) {
+            if (auto *ptr = allocate_from(blocks[current], bytes, alignment))
+                return ptr;
+            ++current;
+            offset = 0;
+        }
+
+        // oversized requests get a block of their own
+        const auto size = std::max(block_size, bytes + alignment);
+        blocks.push_back(Block{std::make_unique<std::byte[]>(size), size});
+        offset = 0;
+        return allocate_from(blocks.back(), bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    void *allocate_from(Block &block, const std::size_t bytes, const std::size_t alignment) {
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const auto aligned = (base + offset + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+        const auto begin = static_cast<std::size_t>(aligned - base);
+        if (begin + bytes > block.size)
+            return nullptr;
+
+        offset = begin + bytes;
+        return block.data.get() + begin;
+    }
+
+    std::size_t block_size;
+    std::vector<Block> blocks;
+    // head of the free list per size class
+    std::vector<void *> free_lists;
+    std::size_t current;
+    std::size_t offset;
+};
+} // namespace charge::common
+
+#endif
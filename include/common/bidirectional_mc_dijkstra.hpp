@@ -0,0 +1,450 @@
+#ifndef CHARGE_COMMON_BIDIRECTIONAL_MC_DIJKSTRA_HPP
+#define CHARGE_COMMON_BIDIRECTIONAL_MC_DIJKSTRA_HPP
+
+#include "common/deadline.hpp"
+#include "common/irange.hpp"
+#include "common/lower_envelop.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/node_label_container.hpp"
+#include "common/node_potentials.hpp"
+#include "common/skyline.hpp"
+#include "common/statistics.hpp"
+
+#include <algorithm>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace charge::common {
+
+// Solution of a bidirectional search: the cost of the whole path and the last label of the
+// forward search and the first label of the backward search on it. Both labels are settled, the
+// path is the forward path to forward_node followed by the backward path from backward_node.
+// Either of them is INVALID_ID if its half of the path is empty, backward_cost is the cost of the
+// path at backward_node.
+template <typename CostT, typename NodeIDT> struct MeetingLabel {
+    using cost_t = CostT;
+    using node_id_t = NodeIDT;
+
+    inline bool operator<(const MeetingLabel &other) const {
+        return std::tie(cost, forward_node, forward_entry, backward_node, backward_entry) <
+               std::tie(other.cost, other.forward_node, other.forward_entry, other.backward_node,
+                        other.backward_entry);
+    }
+
+    inline bool operator==(const MeetingLabel &other) const {
+        return std::tie(cost, forward_node, forward_entry, backward_node, backward_entry) ==
+               std::tie(other.cost, other.forward_node, other.forward_entry, other.backward_node,
+                        other.backward_entry);
+    }
+    inline bool operator!=(const MeetingLabel &other) const { return !operator==(other); }
+
+    cost_t cost;
+    node_id_t forward_node;
+    std::size_t forward_entry;
+    node_id_t backward_node;
+    std::size_t backward_entry;
+    cost_t backward_cost;
+};
+
+// Labels of the forward search from the start and the backward search from the target
+template <typename ForwardPolicyT, typename BackwardPolicyT> struct BidirectionalNodeLabels {
+    BidirectionalNodeLabels(const std::size_t num_nodes)
+        : forward(num_nodes), backward(num_nodes) {}
+
+    void clear() {
+        forward.clear();
+        backward.clear();
+    }
+
+    NodeLabels<ForwardPolicyT> forward;
+    NodeLabels<BackwardPolicyT> backward;
+};
+
+namespace detail {
+// Lets PolicyT::terminate look at the solutions of a bidirectional search as if they were the
+// settled labels of the target and the sum of the min keys of both sides was the min key of the
+// queue. Any path that was not combined yet costs at least that sum.
+template <typename CostT, typename NodeIDT> class MeetingTerminationView {
+  public:
+    using node_id_t = NodeIDT;
+
+    struct Solution {
+        CostT cost;
+    };
+
+    MeetingTerminationView(const Skyline<CostT> &solutions, const std::int32_t key)
+        : solutions(solutions), key(key) {}
+
+    IDKeyPair peek() const { return IDKeyPair{INVALID_ID, key}; }
+
+    // the solutions of all nodes, the fastest one first
+    const MeetingTerminationView &operator[](const node_id_t) const { return *this; }
+    bool empty() const { return solutions.empty(); }
+    Solution front() const { return Solution{solutions[0]}; }
+
+  private:
+    const Skyline<CostT> &solutions;
+    const std::int32_t key;
+};
+
+// Whether the search with the policy can charge at the node
+template <typename PolicyT>
+bool is_weighted(const PolicyT &policy, const typename PolicyT::node_id_t node) {
+    // clang-format off
+    if constexpr(has_node_weights<PolicyT>::value) {
+        return policy.weighted(node);
+    } else {
+        return false;
+    }
+    // clang-format on
+}
+
+template <typename T, typename = int> struct has_rest_costs : std::false_type {};
+
+template <typename T>
+struct has_rest_costs<T, decltype((void)&T::rest_bound, 0)> : std::true_type {};
+
+// The labels of a backward policy with rest costs (e.g.
+// ev::DurationConsumptionBackwardDijkstraPolicy) are no costs of the forward search, the policy
+// defines how they are combined with a forward cost. Otherwise the costs are additive and the
+// forward policy constrains the combined cost.
+template <typename ForwardPolicyT, typename BackwardPolicyT>
+bool meet(const ForwardPolicyT &forward_policy, const BackwardPolicyT &backward_policy,
+          const typename ForwardPolicyT::cost_t &forward,
+          const typename BackwardPolicyT::cost_t &rest, typename ForwardPolicyT::cost_t &cost) {
+    // clang-format off
+    if constexpr(has_rest_costs<BackwardPolicyT>::value) {
+        (void)forward_policy;
+        return backward_policy.meet(forward, rest, cost);
+    } else {
+        (void)backward_policy;
+        cost = ForwardPolicyT::link(forward, rest);
+        return forward_policy.constrain(cost);
+    }
+    // clang-format on
+}
+
+// Lower bound on the cost of any path that ends with the rest
+template <typename ForwardPolicyT, typename BackwardPolicyT>
+typename ForwardPolicyT::cost_t rest_bound(const typename BackwardPolicyT::cost_t &rest) {
+    // clang-format off
+    if constexpr(has_rest_costs<BackwardPolicyT>::value) {
+        return BackwardPolicyT::rest_bound(rest);
+    } else {
+        return rest;
+    }
+    // clang-format on
+}
+
+// Lower bound on the cost of any path that starts with the forward path
+template <typename BackwardPolicyT, typename CostT> CostT forward_bound(const CostT &forward) {
+    // clang-format off
+    if constexpr(has_rest_costs<BackwardPolicyT>::value) {
+        return BackwardPolicyT::forward_bound(forward);
+    } else {
+        return forward;
+    }
+    // clang-format on
+}
+
+// Cost of the path at the next node of the rest if it has the forward cost at the first one
+template <typename BackwardPolicyT, typename CostT>
+CostT advance(const CostT &forward, const typename BackwardPolicyT::cost_t &rest,
+              const typename BackwardPolicyT::cost_t &next_rest) {
+    // clang-format off
+    if constexpr(has_rest_costs<BackwardPolicyT>::value) {
+        return BackwardPolicyT::advance(forward, rest, next_rest);
+    } else {
+        return CostT{std::get<0>(forward) + std::get<0>(rest) - std::get<0>(next_rest),
+                     std::get<1>(forward) + std::get<1>(rest) - std::get<1>(next_rest)};
+    }
+    // clang-format on
+}
+
+// Same as mc_label_heap_step, but calls on_settle(node, label, entry_id) for the settled label,
+// which is only relaxed if it returns true, and on_push(node, label) for every pushed label
+template <typename PolicyT, typename NodePotentialsT, typename GraphT, typename OnSettleT,
+          typename OnPushT>
+void bidirectional_mc_step(LabelHeap<typename PolicyT::label_t> &heap, NodeLabels<PolicyT> &labels,
+                           const NodePotentialsT &potentials, const GraphT &graph,
+                           const typename PolicyT::node_id_t target, const PolicyT &policy,
+                           const OnSettleT &on_settle, const OnPushT &on_push) {
+    auto[top_id, label] = heap.pop();
+
+    // the label may have been dominated since it was pushed, clipping does nothing for points
+    if (std::get<0>(labels.clip_dominated(top_id, label, policy, potentials))) {
+        return;
+    }
+
+    const auto[top_label, top_entry_id] = labels.settle(top_id, std::move(label));
+    if (!on_settle(top_id, top_label, top_entry_id)) {
+        return;
+    }
+
+    mc_relax_label(top_id, top_label, top_entry_id, labels, potentials, graph, target, policy,
+                   [&](const auto node, auto new_label) {
+                       Statistics::get().count(StatisticsEvent::LABEL_PUSH);
+                       if (!labels.dominated(node, new_label.cost, policy)) {
+                           on_push(node, new_label);
+                           heap.push(node, std::move(new_label));
+                       }
+                   });
+}
+} // namespace detail
+
+// Bidirectional multi-criteria search for two criteria, the first one is the key. The backward
+// search runs on the reverse graph from the target, its labels hold the cost of the rest of the
+// path. Every settled or pushed label is combined with the settled labels of the other side at its
+// node. For additive costs the combined cost is linked and constrained with the forward policy
+// (e.g. the capacity of the battery), a backward policy with rest costs combines them itself.
+//
+// A path that was not combined yet has a part on each side that is not settled, and these parts
+// do not overlap. So a settled label is not relaxed if its cost plus the min key of the other side
+// is dominated by a known solution, and once one side has nothing left to settle all paths were
+// combined. The search stops earlier if the forward policy terminates on the sum of the min keys
+// of both sides (e.g. once the fastest solution is known), then only the solutions that are
+// faster than this sum are returned.
+//
+// If the forward policy has node weights (charging) only the forward search charges. A path is
+// combined behind its last charging stop, there the charged forward label meets the backward
+// labels of the charging node. The rest of such a path can be settled by the backward search
+// already, so the backward side adds at most the min key of the backward labels settled at any
+// node with a weight instead of its min key. The forward search keeps going after the backward
+// search ran out of labels, and a forward label is only bounded by its key since charging later
+// can lower its consumption.
+template <typename ForwardPolicyT, typename BackwardPolicyT, typename ForwardGraphT,
+          typename BackwardGraphT>
+auto bidirectional_mc_dijkstra(const typename ForwardPolicyT::node_id_t start,
+                               const typename ForwardPolicyT::node_id_t target,
+                               const ForwardGraphT &forward_graph,
+                               const BackwardGraphT &backward_graph,
+                               LabelHeap<typename ForwardPolicyT::label_t> &forward_heap,
+                               LabelHeap<typename BackwardPolicyT::label_t> &backward_heap,
+                               BidirectionalNodeLabels<ForwardPolicyT, BackwardPolicyT> &labels,
+                               const ForwardPolicyT &forward_policy,
+                               const BackwardPolicyT &backward_policy) {
+    using cost_t = typename ForwardPolicyT::cost_t;
+    using node_id_t = typename ForwardPolicyT::node_id_t;
+    using solution_t = MeetingLabel<cost_t, node_id_t>;
+    using backward_cost_t = typename BackwardPolicyT::cost_t;
+    static_assert(detail::has_rest_costs<BackwardPolicyT>::value ||
+                      std::is_same_v<cost_t, backward_cost_t>,
+                  "Both searches need to use the same cost");
+
+    forward_heap.clear();
+    backward_heap.clear();
+    labels.clear();
+
+    std::vector<solution_t> solutions;
+    // all costs of the solutions that were not dominated when they were found, used to prune
+    Skyline<cost_t> front(std::pmr::new_delete_resource());
+
+    // the forward and the backward label are at the same node, backward_node is this node or the
+    // parent of the backward label
+    const auto meet = [&](const auto &forward_label, const auto &backward_label,
+                          const node_id_t forward_node, const std::size_t forward_entry,
+                          const node_id_t backward_node, const std::size_t backward_entry) {
+        // like mc_relax_label the path does not turn around at the node
+        if (forward_label.parent != INVALID_ID && forward_label.parent == backward_label.parent) {
+            Statistics::get().count(StatisticsEvent::DIJKSTRA_PARENT_PRUNE);
+            return;
+        }
+        const auto &forward_cost = forward_label.cost;
+        const auto &backward_cost = backward_label.cost;
+        cost_t cost;
+        if (detail::meet(forward_policy, backward_policy, forward_cost, backward_cost, cost)) {
+            Statistics::get().count(StatisticsEvent::DIJKSTRA_CONTRAINT_CLIP);
+            return;
+        }
+        if (front.insert(cost)) {
+            auto backward_node_cost = forward_cost;
+            if (backward_node != INVALID_ID) {
+                backward_node_cost = detail::advance<BackwardPolicyT>(
+                    forward_cost, backward_cost,
+                    labels.backward[backward_node][backward_entry].cost);
+            }
+            solutions.push_back(solution_t{cost, forward_node, forward_entry, backward_node,
+                                           backward_entry, backward_node_cost});
+        }
+    };
+
+    constexpr bool forward_charges = detail::has_node_weights<ForwardPolicyT>::value;
+    // min key of the backward labels settled at a node with a weight
+    auto charging_key = INF_WEIGHT;
+
+    // lower bounds on the key that the not settled part of a path adds on each side
+    const auto forward_bound = [&]() {
+        return forward_heap.empty() ? INF_WEIGHT : forward_heap.peek().key;
+    };
+    const auto backward_bound = [&]() {
+        return std::min(backward_heap.empty() ? INF_WEIGHT : backward_heap.peek().key,
+                        charging_key);
+    };
+
+    // cost is a lower bound on the cost of the paths that contain the label
+    const auto is_bounded = [&](cost_t cost, const std::int32_t bound, const bool may_charge) {
+        if (front.empty() || bound == INF_WEIGHT)
+            return false;
+        std::get<0>(cost) += bound;
+        // charging can take the consumption down to zero
+        if (may_charge)
+            std::get<1>(cost) = 0;
+        if (forward_policy.dominates(front.range(), cost)) {
+            Statistics::get().count(StatisticsEvent::DIJKSTRA_STALL);
+            return true;
+        }
+        return false;
+    };
+
+    // a label that is not settled yet is referenced by its parent
+    const auto forward_settled = [&](const node_id_t node, const auto &label,
+                                     const std::size_t entry_id) {
+        const auto &backward_labels = labels.backward[node];
+        for (const auto index : irange<std::size_t>(0, backward_labels.size())) {
+            const auto &backward_label = backward_labels[index];
+            meet(label, backward_label, node, entry_id, backward_label.parent,
+                 backward_label.parent_entry);
+        }
+        return !is_bounded(detail::forward_bound<BackwardPolicyT>(label.cost), backward_bound(),
+                           forward_charges);
+    };
+    const auto forward_pushed = [&](const node_id_t node, const auto &label) {
+        // a charged label meets the backward labels once it is settled, so the charging stop
+        // stays on the path
+        if (label.parent == node)
+            return;
+        const auto &backward_labels = labels.backward[node];
+        for (const auto index : irange<std::size_t>(0, backward_labels.size())) {
+            meet(label, backward_labels[index], label.parent, label.parent_entry, node, index);
+        }
+    };
+
+    const auto backward_settled = [&](const node_id_t node, const auto &label, const std::size_t) {
+        if (detail::is_weighted(forward_policy, node))
+            charging_key = std::min(charging_key, label.key);
+        const auto &forward_labels = labels.forward[node];
+        for (const auto index : irange<std::size_t>(0, forward_labels.size())) {
+            meet(forward_labels[index], label, node, index, label.parent, label.parent_entry);
+        }
+        return !is_bounded(detail::rest_bound<ForwardPolicyT, BackwardPolicyT>(label.cost),
+                           forward_bound(), false);
+    };
+    const auto backward_pushed = [&](const node_id_t node, const auto &label) {
+        const auto &forward_labels = labels.forward[node];
+        for (const auto index : irange<std::size_t>(0, forward_labels.size())) {
+            meet(forward_labels[index], label, node, index, label.parent, label.parent_entry);
+        }
+    };
+
+    const ZeroNodePotentials<typename ForwardPolicyT::graph_t> forward_potentials;
+    const ZeroNodePotentials<typename BackwardPolicyT::graph_t> backward_potentials;
+    const auto forward_step = [&]() {
+        detail::bidirectional_mc_step(forward_heap, labels.forward, forward_potentials,
+                                      forward_graph, target, forward_policy, forward_settled,
+                                      forward_pushed);
+    };
+    const auto backward_step = [&]() {
+        detail::bidirectional_mc_step(backward_heap, labels.backward, backward_potentials,
+                                      backward_graph, start, backward_policy, backward_settled,
+                                      backward_pushed);
+    };
+
+    forward_heap.push(start, {0, cost_t{}, INVALID_ID, INVALID_ID});
+    backward_heap.push(target, {0, backward_cost_t{}, INVALID_ID, INVALID_ID});
+
+    // a path that is settled completely on one side still needs the start label of the other
+    forward_step();
+    backward_step();
+
+    // solutions that are slower than this bound are not known to be Pareto optimal
+    auto max_key = INF_WEIGHT;
+    while (forward_bound() != INF_WEIGHT && backward_bound() != INF_WEIGHT) {
+        const auto min_key = forward_bound() + backward_bound();
+        const detail::MeetingTerminationView<cost_t, node_id_t> view(front, min_key);
+        if (ForwardPolicyT::terminate(view, view, target)) {
+            max_key = min_key;
+            break;
+        }
+        if (Deadline::get().expired()) {
+            break;
+        }
+
+        // both sides advance to about the same key
+        if (backward_heap.empty() || forward_heap.peek().key <= backward_heap.peek().key) {
+            forward_step();
+        } else {
+            backward_step();
+        }
+    }
+
+    solutions.erase(std::remove_if(solutions.begin(), solutions.end(),
+                                   [max_key](const auto &solution) {
+                                       return ForwardPolicyT::key(solution.cost) >= max_key;
+                                   }),
+                    solutions.end());
+    return lower_envelop(std::move(solutions));
+}
+
+// Path and the cost at every node of it. On the backward half the costs are advanced from the
+// cost at the first node by the edges between the backward labels.
+template <typename ForwardPolicyT, typename BackwardPolicyT>
+auto get_path_with_costs(
+    const typename ForwardPolicyT::node_id_t start, const typename ForwardPolicyT::node_id_t target,
+    const MeetingLabel<typename ForwardPolicyT::cost_t, typename ForwardPolicyT::node_id_t>
+        &solution,
+    const BidirectionalNodeLabels<ForwardPolicyT, BackwardPolicyT> &labels) {
+    using node_id_t = typename ForwardPolicyT::node_id_t;
+    using cost_t = typename ForwardPolicyT::cost_t;
+
+    std::vector<node_id_t> path;
+    std::vector<cost_t> costs;
+
+    auto node = solution.forward_node;
+    std::size_t entry = solution.forward_entry;
+    while (node != INVALID_ID) {
+        const auto &label = labels.forward[node][entry];
+        path.push_back(node);
+        costs.push_back(label.cost);
+        node = label.parent;
+        entry = label.parent_entry;
+    }
+    std::reverse(path.begin(), path.end());
+    std::reverse(costs.begin(), costs.end());
+
+    // the parents of the backward labels point towards the target
+    node = solution.backward_node;
+    entry = solution.backward_entry;
+    auto cost = solution.backward_cost;
+    while (node != INVALID_ID) {
+        const auto &label = labels.backward[node][entry];
+        path.push_back(node);
+        costs.push_back(cost);
+        if (label.parent != INVALID_ID) {
+            cost = detail::advance<BackwardPolicyT>(
+                cost, label.cost, labels.backward[label.parent][label.parent_entry].cost);
+        }
+        node = label.parent;
+        entry = label.parent_entry;
+    }
+
+    (void)start;
+    (void)target;
+    assert(path.front() == start);
+    assert(path.back() == target);
+
+    return std::make_tuple(std::move(path), std::move(costs));
+}
+
+template <typename ForwardPolicyT, typename BackwardPolicyT>
+auto get_path(
+    const typename ForwardPolicyT::node_id_t start, const typename ForwardPolicyT::node_id_t target,
+    const MeetingLabel<typename ForwardPolicyT::cost_t, typename ForwardPolicyT::node_id_t>
+        &solution,
+    const BidirectionalNodeLabels<ForwardPolicyT, BackwardPolicyT> &labels) {
+    return std::get<0>(get_path_with_costs(start, target, solution, labels));
+}
+} // namespace charge::common
+
+#endif
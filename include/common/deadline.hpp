@@ -0,0 +1,92 @@
+#ifndef CHARGE_COMMON_DEADLINE_HPP
+#define CHARGE_COMMON_DEADLINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace charge::common {
+
+// Cooperative cancellation of the label-setting searches running on the current thread.
+// The searches call expired() once per label pop, the clock is only read every
+// CHECK_INTERVAL calls. Once expired a deadline stays expired until the next reset, the
+// search then returns the labels it found so far.
+//
+// The deadline is thread local and only covers the thread that set it. Worker threads of
+// the parallel searches don't see it: ParetoQueueSearch checks it on the calling thread
+// between rounds, DeltaStepping and parallel_dijkstra don't check it at all.
+class Deadline {
+  public:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::uint32_t CHECK_INTERVAL = 256;
+
+    static Deadline &get() {
+        static thread_local Deadline deadline;
+        return deadline;
+    }
+
+    // Expires after the given number of seconds, the default never expires
+    void reset(const double seconds = std::numeric_limits<double>::infinity()) {
+        has_end = std::isfinite(seconds);
+        if (has_end)
+            end = clock::now() + std::chrono::duration_cast<clock::duration>(
+                                     std::chrono::duration<double>(seconds));
+        calls = 0;
+        cancelled.store(has_end && seconds <= 0, std::memory_order_relaxed);
+    }
+
+    // Safe to call from other threads that hold a reference to this deadline
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    bool expired() {
+        if (cancelled.load(std::memory_order_relaxed))
+            return true;
+        if (!has_end || ++calls < CHECK_INTERVAL)
+            return false;
+
+        calls = 0;
+        if (clock::now() >= end) {
+            cancel();
+            return true;
+        }
+        return false;
+    }
+
+    // Did the last search stop because of this deadline
+    bool is_expired() const { return cancelled.load(std::memory_order_relaxed); }
+
+    // A deadline is set, searches without one run to completion
+    bool is_set() const { return has_end; }
+
+  private:
+    Deadline() = default;
+
+    clock::time_point end;
+    bool has_end = false;
+    std::uint32_t calls = 0;
+    std::atomic<bool> cancelled{false};
+};
+
+// Sets the deadline of the current thread for one query and removes it again when the
+// scope is left, also if the query throws.
+class ScopedDeadline {
+  public:
+    explicit ScopedDeadline(const double seconds) : deadline(Deadline::get()) {
+        deadline.reset(seconds);
+    }
+    ~ScopedDeadline() { deadline.reset(); }
+
+    ScopedDeadline(const ScopedDeadline &) = delete;
+    ScopedDeadline &operator=(const ScopedDeadline &) = delete;
+
+    // Did the query stop because of the deadline
+    bool is_expired() const { return deadline.is_expired(); }
+
+  private:
+    Deadline &deadline;
+};
+} // namespace charge::common
+
+#endif
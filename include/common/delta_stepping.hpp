@@ -0,0 +1,200 @@
+#ifndef CHARGE_COMMON_DELTA_STEPPING_HPP
+#define CHARGE_COMMON_DELTA_STEPPING_HPP
+
+#include "common/constants.hpp"
+#include "common/dijkstra.hpp"
+#include "common/irange.hpp"
+#include "common/worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace charge::common {
+
+// Parallel one-to-all search (Delta-stepping by Meyer and Sanders).
+// Nodes are grouped into buckets of width delta by their tentative distance. All nodes
+// of the smallest bucket are scanned in parallel until the bucket is empty, nodes that are
+// improved again are simply rescanned. Negative weights are fine as long as there are
+// no negative cycles: Improved nodes never go to a bucket before the current one.
+//
+// The worker threads are started once and reused by every run.
+// Can be passed instead of a queue to dijkstra_to_all(start, graph, queue, costs).
+class DeltaStepping {
+  public:
+    using node_id_t = std::uint32_t;
+    using weight_t = std::int32_t;
+
+    // A delta of 0 uses the average absolute edge weight of the searched graph
+    DeltaStepping(const std::size_t num_nodes,
+                  const std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency()),
+                  const weight_t delta = 0)
+        : num_threads(std::max<std::size_t>(1, num_threads)), delta(delta),
+          distances(num_nodes), thread_data(this->num_threads), workers(this->num_threads) {
+        for (auto &distance : distances)
+            distance.store(INF_WEIGHT, std::memory_order_relaxed);
+    }
+
+    // Copies only the configuration, the search state is always empty between searches
+    DeltaStepping(const DeltaStepping &other)
+        : DeltaStepping(other.distances.size(), other.num_threads, other.delta) {}
+    DeltaStepping &operator=(const DeltaStepping &) = delete;
+
+    std::size_t threads() const { return num_threads; }
+
+    template <typename GraphT>
+    void run(const typename GraphT::node_id_t start, const GraphT &graph,
+             CostVector<GraphT> &costs) {
+        static_assert(std::is_same_v<typename GraphT::weight_t, weight_t>,
+                      "Only integer weights are supported");
+        assert(graph.num_nodes() <= distances.size());
+
+        const std::int64_t width = delta > 0 ? delta : average_weight(graph);
+        const auto bucket_of = [width](const weight_t distance, const std::int64_t current) {
+            return std::max<std::int64_t>(current, distance / width);
+        };
+
+        buckets.clear();
+        frontier.clear();
+        current_bucket = 0;
+        done = false;
+        next_entry.store(0, std::memory_order_relaxed);
+
+        distances[start].store(0, std::memory_order_relaxed);
+        thread_data[0].touched.push_back(start);
+        frontier.push_back(Entry{start, 0});
+
+        detail::Barrier barrier(num_threads);
+
+        const auto work = [&](const std::size_t thread_index) {
+            auto &local = thread_data[thread_index];
+
+            while (true) {
+                for (auto begin = next_entry.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+                     begin < frontier.size();
+                     begin = next_entry.fetch_add(CHUNK_SIZE, std::memory_order_relaxed)) {
+                    const auto end = std::min(begin + CHUNK_SIZE, frontier.size());
+                    for (auto index = begin; index < end; ++index) {
+                        const auto entry = frontier[index];
+                        // the node was improved after this entry was created
+                        if (distances[entry.node].load(std::memory_order_relaxed) !=
+                            entry.distance)
+                            continue;
+
+                        for (const auto edge : graph.edges(entry.node)) {
+                            const auto target = graph.target(edge);
+                            const auto tentative = entry.distance + graph.weight(edge);
+                            auto old_distance =
+                                distances[target].load(std::memory_order_relaxed);
+                            while (tentative < old_distance &&
+                                   !distances[target].compare_exchange_weak(
+                                       old_distance, tentative, std::memory_order_relaxed)) {
+                            }
+                            if (tentative >= old_distance)
+                                continue;
+
+                            if (old_distance == INF_WEIGHT)
+                                local.touched.push_back(target);
+                            const auto bucket = bucket_of(tentative, current_bucket);
+                            if (bucket == current_bucket)
+                                local.current.push_back(Entry{target, tentative});
+                            else
+                                local.later.emplace_back(bucket, Entry{target, tentative});
+                        }
+                    }
+                }
+
+                barrier.wait();
+                if (thread_index == 0)
+                    next_frontier();
+                barrier.wait();
+
+                if (done)
+                    break;
+            }
+        };
+
+        workers.run(work);
+
+        costs.clear();
+        for (auto &local : thread_data) {
+            for (const auto node : local.touched) {
+                costs[node] = distances[node].load(std::memory_order_relaxed);
+                distances[node].store(INF_WEIGHT, std::memory_order_relaxed);
+            }
+            local.touched.clear();
+        }
+    }
+
+  private:
+    static constexpr std::size_t CHUNK_SIZE = 64;
+
+    struct Entry {
+        node_id_t node;
+        weight_t distance;
+    };
+
+    struct ThreadData {
+        std::vector<Entry> current;
+        std::vector<std::tuple<std::int64_t, Entry>> later;
+        std::vector<node_id_t> touched;
+    };
+
+    template <typename GraphT> static std::int64_t average_weight(const GraphT &graph) {
+        std::int64_t sum = 0;
+        for (const auto edge : irange<std::size_t>(0, graph.num_edges()))
+            sum += std::abs(graph.weight(edge));
+        return std::max<std::int64_t>(1, sum / std::max<std::size_t>(1, graph.num_edges()));
+    }
+
+    // Only called by one thread between the two barriers
+    void next_frontier() {
+        frontier.clear();
+        for (auto &local : thread_data) {
+            frontier.insert(frontier.end(), local.current.begin(), local.current.end());
+            local.current.clear();
+            for (const auto &[bucket, entry] : local.later)
+                buckets[bucket].push_back(entry);
+            local.later.clear();
+        }
+
+        // the current bucket is settled, continue with the next non-empty one
+        if (frontier.empty() && !buckets.empty()) {
+            auto first = buckets.begin();
+            current_bucket = first->first;
+            frontier = std::move(first->second);
+            buckets.erase(first);
+        }
+
+        done = frontier.empty();
+        next_entry.store(0, std::memory_order_relaxed);
+    }
+
+    const std::size_t num_threads;
+    const weight_t delta;
+    std::vector<std::atomic<weight_t>> distances;
+    std::vector<ThreadData> thread_data;
+    std::map<std::int64_t, std::vector<Entry>> buckets;
+    std::vector<Entry> frontier;
+    std::atomic<std::size_t> next_entry;
+    std::int64_t current_bucket;
+    bool done;
+    WorkerPool workers;
+};
+
+// Overload that makes DeltaStepping a drop-in replacement for the queue of a one-to-all search
+template <typename GraphT>
+void dijkstra_to_all(typename GraphT::node_id_t start, const GraphT &graph, DeltaStepping &search,
+                     CostVector<GraphT> &costs) {
+    search.run(start, graph, costs);
+}
+} // namespace charge::common
+
+#endif
@@ -3,28 +3,33 @@
 
 #include "common/id_queue.hpp"
 #include "common/lazy_clear_vector.hpp"
+#include "common/radix_id_queue.hpp"
 #include "common/weighted_graph.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace charge {
 namespace common {
 
-template <typename GraphT> using CostVector = LazyClearVector<typename GraphT::weight_t>;
-template <typename GraphT> using ParentVector = LazyClearVector<typename GraphT::node_id_t>;
+template <typename GraphT> using CostVector = PackedLazyClearVector<typename GraphT::weight_t>;
+template <typename GraphT> using ParentVector = PackedLazyClearVector<typename GraphT::node_id_t>;
+using SettledVector = LazyClearVector<bool>;
 
-template <typename GraphT>
-inline bool terminate_sum_min(MinIDQueue &forward_queue, MinIDQueue &reverse_queue,
+template <typename GraphT, typename QueueT = MinIDQueue>
+inline bool terminate_sum_min(QueueT &forward_queue, QueueT &reverse_queue,
                               const typename GraphT::weight_t best_cost) {
     return !forward_queue.empty() && !reverse_queue.empty() &&
            forward_queue.peek().key + reverse_queue.peek().key >= best_cost;
 }
 
-template <typename GraphT>
-inline bool terminate_queues_empty(MinIDQueue &, MinIDQueue &, const typename GraphT::weight_t) {
+template <typename GraphT, typename QueueT = MinIDQueue>
+inline bool terminate_queues_empty(QueueT &, QueueT &, const typename GraphT::weight_t) {
     return false;
 }
 
-template <typename GraphT>
-inline bool terminate_key_min(MinIDQueue &queue, const typename GraphT::weight_t target_cost) {
+template <typename GraphT, typename QueueT = MinIDQueue>
+inline bool terminate_key_min(QueueT &queue, const typename GraphT::weight_t target_cost) {
     return !queue.empty() && queue.peek().key >= target_cost;
 }
 
@@ -33,8 +38,8 @@ template <typename CostT> inline CostT unconstrained(const CostT cost) { return
 template <typename GraphT> inline bool no_stall(const typename GraphT::node_id_t) { return false; }
 
 namespace detail {
-template <typename GraphT, typename StallFn>
-void route_step(MinIDQueue &queue, CostVector<GraphT> &forward_costs,
+template <typename GraphT, typename StallFn, typename QueueT>
+void route_step(QueueT &queue, CostVector<GraphT> &forward_costs,
                 CostVector<GraphT> &reverse_costs, const GraphT &graph,
                 typename GraphT::node_id_t &middle, typename GraphT::weight_t &best_cost,
                 StallFn stall) {
@@ -72,8 +77,8 @@ void route_step(MinIDQueue &queue, CostVector<GraphT> &forward_costs,
     }
 }
 
-template <typename GraphT, typename StallFn>
-void route_step(MinIDQueue &queue, CostVector<GraphT> &forward_costs,
+template <typename GraphT, typename StallFn, typename QueueT>
+void route_step(QueueT &queue, CostVector<GraphT> &forward_costs,
                 CostVector<GraphT> &reverse_costs, ParentVector<GraphT> &forward_parents,
                 const GraphT &graph, typename GraphT::node_id_t &middle,
                 typename GraphT::weight_t &best_cost, StallFn stall) {
@@ -112,8 +117,8 @@ void route_step(MinIDQueue &queue, CostVector<GraphT> &forward_costs,
     }
 }
 
-template <typename GraphT, typename ConstrainFn>
-void constrained_route_step(MinIDQueue &queue, CostVector<GraphT> &costs, const GraphT &graph,
+template <typename GraphT, typename ConstrainFn, typename QueueT>
+void constrained_route_step(QueueT &queue, CostVector<GraphT> &costs, const GraphT &graph,
                             ConstrainFn constrain) {
     auto top = queue.pop();
     auto cost_to_top = top.key;
@@ -136,13 +141,13 @@ void constrained_route_step(MinIDQueue &queue, CostVector<GraphT> &costs, const
     }
 }
 
-template <typename GraphT>
-auto route_step(MinIDQueue &queue, CostVector<GraphT> &costs, const GraphT &graph) {
+template <typename GraphT, typename QueueT>
+auto route_step(QueueT &queue, CostVector<GraphT> &costs, const GraphT &graph) {
     return constrained_route_step(queue, costs, graph, unconstrained<typename GraphT::weight_t>);
 }
 
-template <typename GraphT>
-void route_step(MinIDQueue &queue, CostVector<GraphT> &costs, ParentVector<GraphT> &parents,
+template <typename GraphT, typename QueueT>
+void route_step(QueueT &queue, CostVector<GraphT> &costs, ParentVector<GraphT> &parents,
                 const GraphT &graph) {
     auto top = queue.pop();
     auto cost_to_top = top.key;
@@ -167,10 +172,10 @@ void route_step(MinIDQueue &queue, CostVector<GraphT> &costs, ParentVector<Graph
 }
 } // namespace detail
 
-template <typename GraphT, typename TerminateFn, typename StallFn>
+template <typename GraphT, typename TerminateFn, typename StallFn, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &forward_graph, const GraphT &reverse_graph, MinIDQueue &forward_queue,
-              MinIDQueue &reverse_queue, CostVector<GraphT> &forward_costs,
+              const GraphT &forward_graph, const GraphT &reverse_graph, QueueT &forward_queue,
+              QueueT &reverse_queue, CostVector<GraphT> &forward_costs,
               CostVector<GraphT> &reverse_costs, TerminateFn terminate, StallFn stall) {
     forward_costs.clear();
     reverse_costs.clear();
@@ -203,10 +208,10 @@ auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t targe
     return best_cost;
 }
 
-template <typename GraphT, typename TerminateFn, typename StallFn>
+template <typename GraphT, typename TerminateFn, typename StallFn, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &forward_graph, const GraphT &reverse_graph, MinIDQueue &forward_queue,
-              MinIDQueue &reverse_queue, CostVector<GraphT> &forward_costs,
+              const GraphT &forward_graph, const GraphT &reverse_graph, QueueT &forward_queue,
+              QueueT &reverse_queue, CostVector<GraphT> &forward_costs,
               CostVector<GraphT> &reverse_costs, ParentVector<GraphT> &forward_parents,
               ParentVector<GraphT> &backward_parents, typename GraphT::node_id_t &middle,
               TerminateFn terminate, StallFn stall) {
@@ -243,8 +248,8 @@ auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t targe
     return best_cost;
 }
 
-template <typename GraphT, typename TerminateFn>
-auto dijkstra_to_all(typename GraphT::node_id_t start, const GraphT &graph, MinIDQueue &queue,
+template <typename GraphT, typename TerminateFn, typename QueueT>
+auto dijkstra_to_all(typename GraphT::node_id_t start, const GraphT &graph, QueueT &queue,
                      CostVector<GraphT> &costs, TerminateFn terminate) {
     costs.clear();
     queue.clear();
@@ -261,10 +266,10 @@ auto dijkstra_to_all(typename GraphT::node_id_t start, const GraphT &graph, MinI
     }
 }
 
-template <typename GraphT, typename TerminateFn>
+template <typename GraphT, typename TerminateFn, typename QueueT>
 auto dijkstra_to_all(
     const std::vector<std::tuple<typename GraphT::node_id_t, typename GraphT::weight_t>> &sources,
-    const GraphT &graph, MinIDQueue &queue, CostVector<GraphT> &costs, TerminateFn terminate) {
+    const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs, TerminateFn terminate) {
     costs.clear();
     queue.clear();
 
@@ -284,9 +289,42 @@ auto dijkstra_to_all(
     }
 }
 
-template <typename GraphT>
-auto continue_dijkstra(typename GraphT::node_id_t target, const GraphT &graph, MinIDQueue &queue,
-                       CostVector<GraphT> &costs, std::vector<bool> &settled) {
+// Runs Dijkstra from start until all targets are settled, returns the costs
+// of the targets in the same order as given (INF_WEIGHT if not reachable).
+// The settle function is called for every settled node in order.
+template <typename GraphT, typename SettleFn, typename QueueT>
+auto dijkstra_to_targets(typename GraphT::node_id_t start,
+                         const std::vector<typename GraphT::node_id_t> &targets,
+                         const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs,
+                         SettleFn settle) {
+    auto pending = targets;
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+    auto num_pending = pending.size();
+
+    costs.clear();
+    queue.clear();
+    queue.push(IDKeyPair{start, 0});
+    costs[start] = 0;
+
+    while (!queue.empty() && num_pending > 0) {
+        const auto id = queue.peek().id;
+        settle(id);
+        if (std::binary_search(pending.begin(), pending.end(), id))
+            --num_pending;
+
+        detail::route_step(queue, costs, graph);
+    }
+
+    std::vector<typename GraphT::weight_t> target_costs(targets.size());
+    std::transform(targets.begin(), targets.end(), target_costs.begin(),
+                   [&](const auto target) { return costs[target]; });
+    return target_costs;
+}
+
+template <typename GraphT, typename QueueT>
+auto continue_dijkstra(typename GraphT::node_id_t target, const GraphT &graph, QueueT &queue,
+                       CostVector<GraphT> &costs, SettledVector &settled) {
     while (!queue.empty() && !settled[target]) {
         const auto id = queue.peek().id;
         settled[id] = true;
@@ -297,13 +335,13 @@ auto continue_dijkstra(typename GraphT::node_id_t target, const GraphT &graph, M
     return costs[target];
 }
 
-template <typename GraphT>
+template <typename GraphT, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t source, typename GraphT::node_id_t target,
-              const GraphT &graph, MinIDQueue &queue, CostVector<GraphT> &costs,
-              std::vector<bool> &settled) {
+              const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs,
+              SettledVector &settled) {
     queue.clear();
     costs.clear();
-    std::fill(settled.begin(), settled.end(), false);
+    settled.clear();
     costs[source] = 0;
     queue.push({source, 0});
 
@@ -322,9 +360,9 @@ auto dijkstra(typename GraphT::node_id_t source, typename GraphT::node_id_t targ
     return costs[target];
 }
 
-template <typename GraphT, typename TerminateFn>
+template <typename GraphT, typename TerminateFn, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &graph, MinIDQueue &queue, CostVector<GraphT> &costs,
+              const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs,
               ParentVector<GraphT> &parents, TerminateFn terminate) {
     costs.clear();
     queue.clear();
@@ -343,9 +381,9 @@ auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t targe
 
     return costs[target];
 }
-template <typename GraphT, typename TerminateFn, typename ConstrainFn>
+template <typename GraphT, typename TerminateFn, typename ConstrainFn, typename QueueT>
 auto constrained_dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-                          const GraphT &graph, MinIDQueue &queue, CostVector<GraphT> &costs,
+                          const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs,
                           TerminateFn terminate, ConstrainFn constrain) {
     costs.clear();
     queue.clear();
@@ -364,18 +402,18 @@ auto constrained_dijkstra(typename GraphT::node_id_t start, typename GraphT::nod
     return costs[target];
 }
 
-template <typename GraphT, typename TerminateFn>
+template <typename GraphT, typename TerminateFn, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &graph, MinIDQueue &queue, CostVector<GraphT> &costs,
+              const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs,
               TerminateFn terminate) {
     return dijkstra(start, target, graph, queue, costs, terminate,
                     unconstrained<typename GraphT::weight_t>);
 }
 
-template <typename GraphT, typename TerminateFn, typename ConstrainFn>
+template <typename GraphT, typename TerminateFn, typename ConstrainFn, typename QueueT>
 auto constrained_dijkstra(
     const std::vector<std::tuple<typename GraphT::node_id_t, typename GraphT::weight_t>> &sources,
-    typename GraphT::node_id_t target, const GraphT &graph, MinIDQueue &queue,
+    typename GraphT::node_id_t target, const GraphT &graph, QueueT &queue,
     CostVector<GraphT> &costs, TerminateFn terminate, ConstrainFn constrain) {
     costs.clear();
     queue.clear();
@@ -397,52 +435,60 @@ auto constrained_dijkstra(
     return costs[target];
 }
 
-template <typename GraphT, typename TerminateFn>
+template <typename GraphT, typename TerminateFn, typename QueueT>
 auto dijkstra(
     const std::vector<std::tuple<typename GraphT::node_id_t, typename GraphT::weight_t>> &sources,
-    typename GraphT::node_id_t target, const GraphT &graph, MinIDQueue &queue,
+    typename GraphT::node_id_t target, const GraphT &graph, QueueT &queue,
     CostVector<GraphT> &costs, TerminateFn terminate) {
     return dijkstra(sources, target, graph, queue, costs, terminate,
                     unconstrained<typename GraphT::weight_t>);
 }
 
-template <typename GraphT>
-auto dijkstra_to_all(typename GraphT::node_id_t start, const GraphT &graph, MinIDQueue &queue,
+template <typename GraphT, typename QueueT>
+auto dijkstra_to_all(typename GraphT::node_id_t start, const GraphT &graph, QueueT &queue,
                      CostVector<GraphT> &costs) {
     dijkstra_to_all(start, graph, queue, costs, [](const auto&) { return false; });
 }
 
-template <typename GraphT>
+template <typename GraphT, typename QueueT>
+auto dijkstra_to_targets(typename GraphT::node_id_t start,
+                         const std::vector<typename GraphT::node_id_t> &targets,
+                         const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs) {
+    return dijkstra_to_targets(start, targets, graph, queue, costs, [](const auto) {});
+}
+
+template <typename GraphT, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &graph, MinIDQueue &queue, CostVector<GraphT> &costs,
+              const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs,
               ParentVector<GraphT> &parents) {
-    return dijkstra(start, target, graph, queue, costs, parents, terminate_key_min<GraphT>);
+    return dijkstra(start, target, graph, queue, costs, parents, terminate_key_min<GraphT, QueueT>);
 }
 
-template <typename GraphT>
+template <typename GraphT, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &forward_graph, const GraphT &reverse_graph, MinIDQueue &forward_queue,
-              MinIDQueue &reverse_queue, CostVector<GraphT> &forward_costs,
+              const GraphT &forward_graph, const GraphT &reverse_graph, QueueT &forward_queue,
+              QueueT &reverse_queue, CostVector<GraphT> &forward_costs,
               CostVector<GraphT> &reverse_costs, ParentVector<GraphT> &forward_parents,
               ParentVector<GraphT> &backward_parents, typename GraphT::node_id_t &middle) {
     return dijkstra(start, target, forward_graph, reverse_graph, forward_queue, reverse_queue,
                     forward_costs, reverse_costs, forward_parents, backward_parents, middle,
-                    terminate_sum_min<GraphT>, no_stall<GraphT>);
+                    terminate_sum_min<GraphT, QueueT>, no_stall<GraphT>);
 }
 
-template <typename GraphT>
+template <typename GraphT, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &forward_graph, const GraphT &reverse_graph, MinIDQueue &forward_queue,
-              MinIDQueue &reverse_queue, CostVector<GraphT> &forward_costs,
+              const GraphT &forward_graph, const GraphT &reverse_graph, QueueT &forward_queue,
+              QueueT &reverse_queue, CostVector<GraphT> &forward_costs,
               CostVector<GraphT> &reverse_costs) {
     return dijkstra(start, target, forward_graph, reverse_graph, forward_queue, reverse_queue,
-                    forward_costs, reverse_costs, terminate_sum_min<GraphT>, no_stall<GraphT>);
+                    forward_costs, reverse_costs, terminate_sum_min<GraphT, QueueT>,
+                    no_stall<GraphT>);
 }
 
-template <typename GraphT, typename TerminateFn>
+template <typename GraphT, typename TerminateFn, typename QueueT>
 auto dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
-              const GraphT &forward_graph, const GraphT &reverse_graph, MinIDQueue &forward_queue,
-              MinIDQueue &reverse_queue, CostVector<GraphT> &forward_costs,
+              const GraphT &forward_graph, const GraphT &reverse_graph, QueueT &forward_queue,
+              QueueT &reverse_queue, CostVector<GraphT> &forward_costs,
               CostVector<GraphT> &reverse_costs, TerminateFn terminate) {
     return dijkstra(start, target, forward_graph, reverse_graph, forward_queue, reverse_queue,
                     forward_costs, reverse_costs, terminate, no_stall<GraphT>);
@@ -3,8 +3,13 @@
 
 #include "common/serialization.hpp"
 #include "common/coordinate.hpp"
+#include "common/landmarks.hpp"
 #include "common/weighted_graph.hpp"
 
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
 namespace charge {
 namespace common {
 namespace files {
@@ -72,6 +77,63 @@ inline void write_heights(const std::string &base_path, const std::vector<std::i
     BinaryWriter writer(base_path + "/heights");
     serialization::write(writer, heights);
 }
+
+inline bool has_landmarks(const std::string &base_path) {
+    return std::ifstream(base_path + "/landmarks").good();
+}
+
+// Throws if the distance tables don't fit a graph with num_nodes nodes, e.g. a stale file
+template <typename GraphT>
+Landmarks<GraphT> read_landmarks(const std::string &base_path, const std::size_t num_nodes) {
+    std::vector<typename GraphT::node_id_t> landmarks;
+    std::vector<typename GraphT::weight_t> forward_distances;
+    std::vector<typename GraphT::weight_t> backward_distances;
+
+    {
+        BinaryReader reader(base_path + "/landmarks");
+        serialization::read(reader, landmarks);
+    }
+    {
+        BinaryReader reader(base_path + "/forward_landmark_distances");
+        serialization::read(reader, forward_distances);
+    }
+    {
+        BinaryReader reader(base_path + "/backward_landmark_distances");
+        serialization::read(reader, backward_distances);
+    }
+
+    const auto expected_size = landmarks.size() * num_nodes;
+    if (forward_distances.size() != expected_size || backward_distances.size() != expected_size)
+        throw std::runtime_error("Landmark distances in " + base_path + " don't match the graph: " +
+                                 std::to_string(forward_distances.size()) + " and " +
+                                 std::to_string(backward_distances.size()) + " entries for " +
+                                 std::to_string(landmarks.size()) + " landmarks and " +
+                                 std::to_string(num_nodes) + " nodes");
+    for (const auto landmark : landmarks)
+        if (landmark >= num_nodes)
+            throw std::runtime_error("Invalid landmark id: " + std::to_string(landmark));
+
+    return Landmarks<GraphT>(std::move(landmarks), std::move(forward_distances),
+                             std::move(backward_distances));
+}
+
+template <typename GraphT>
+void write_landmarks(const std::string &base_path, const Landmarks<GraphT> &landmarks) {
+    auto [ids, forward_distances, backward_distances] = Landmarks<GraphT>::unwrap(landmarks);
+
+    {
+        BinaryWriter writer(base_path + "/landmarks");
+        serialization::write(writer, ids);
+    }
+    {
+        BinaryWriter writer(base_path + "/forward_landmark_distances");
+        serialization::write(writer, forward_distances);
+    }
+    {
+        BinaryWriter writer(base_path + "/backward_landmark_distances");
+        serialization::write(writer, backward_distances);
+    }
+}
 }
 }
 }
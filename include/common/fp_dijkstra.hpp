@@ -1,8 +1,10 @@
 #ifndef CHARGE_COMMON_FP_DIJKSTRA_HPP
 #define CHARGE_COMMON_FP_DIJKSTRA_HPP
 
+#include "common/deadline.hpp"
 #include "common/dijkstra_private.hpp"
 #include "common/domination.hpp"
+#include "common/irange.hpp"
 #include "common/limited_function.hpp"
 #include "common/memory_statistics.hpp"
 #include "common/minimize_combined_function.hpp"
@@ -10,6 +12,7 @@
 #include "common/node_potentials.hpp"
 #include "common/options.hpp"
 
+#include <memory_resource>
 #include <thread>
 
 namespace charge::common {
@@ -17,8 +20,8 @@ namespace charge::common {
 namespace function_propergation_traits {
 
 inline auto link_combine(const PiecewieseDecHypOrLinFunction &lhs,
-                         const LimitedHypOrLinFunction &rhs) {
-    return combine_minimal(lhs, rhs);
+                         const LimitedHypOrLinFunction &rhs, std::pmr::memory_resource *resource) {
+    return combine_minimal(lhs, rhs, resource);
 }
 
 template <typename OutIter>
@@ -104,8 +107,8 @@ clip_dominated(const Range &lhs_range, PiecewieseDecHypOrLinFunction &rhs,
 
 inline auto key(const PiecewieseDecHypOrLinFunction &cost) { return to_fixed(cost.min_x()); }
 
-template <typename NodeLabelsT>
-bool min_key_terminate(const MinIDQueue &queue, const NodeLabelsT &labels,
+template <typename QueueT, typename NodeLabelsT>
+bool min_key_terminate(const QueueT &queue, const NodeLabelsT &labels,
                        const typename NodeLabelsT::node_id_t target) {
     if (labels[target].empty())
         return false;
@@ -114,31 +117,35 @@ bool min_key_terminate(const MinIDQueue &queue, const NodeLabelsT &labels,
 }
 } // namespace function_propergation_traits
 
-template <typename GraphT, typename LabelEntryT> class FPDijkstraPolicy;
+template <typename GraphT, typename LabelEntryT, typename QueueT = MinIDQueue>
+class FPDijkstraPolicy;
 template <typename GraphT, typename LabelEntryT, typename NodeWeightsT>
 class FPDijkstraWeightedNodePolicy;
 
 using HypLinGraph = WeightedGraph<LimitedFunction<HypOrLinFunction, inf_bound, clamp_bound>>;
 
-template <typename LabelEntryT> class FPDijkstraPolicy<HypLinGraph, LabelEntryT> {
+template <typename LabelEntryT, typename QueueT>
+class FPDijkstraPolicy<HypLinGraph, LabelEntryT, QueueT> {
   public:
     using graph_t = WeightedGraph<LimitedHypOrLinFunction>;
     using label_t = LabelEntryT;
     using cost_t = typename label_t::cost_t;
     using weight_t = typename graph_t::weight_t;
     using node_id_t = typename graph_t::node_id_t;
-    using queue_t = MinIDQueue;
+    using queue_t = QueueT;
     using key_t = std::uint32_t;
 
     static constexpr bool enable_stalling = true;
 
     template <typename NodeLabelsT>
-    static bool terminate(const MinIDQueue &, const NodeLabelsT &, const node_id_t) {
+    static bool terminate(const queue_t &, const NodeLabelsT &, const node_id_t) {
         return false;
     }
 
-    static auto link(const cost_t &lhs, const weight_t &rhs) {
-        return function_propergation_traits::link_combine(lhs, rhs);
+    // The linked function and its delta are allocated from resource
+    static auto link(const cost_t &lhs, const weight_t &rhs,
+                     std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+        return function_propergation_traits::link_combine(lhs, rhs, resource);
     }
 
     // Unconstrained
@@ -195,10 +202,10 @@ class FPDijkstraWeightedNodePolicy<HypLinGraph, LabelEntryT, NodeWeightsT>
 };
 
 namespace detail {
-template <typename FnT, typename PolicyT, typename NodePotentialsT>
-void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
-                const NodePotentialsT &potentials, const FunctionGraph<FnT> &graph,
-                const typename PolicyT::node_id_t target, const PolicyT &policy) {
+template <typename PolicyT, typename NodePotentialsT, typename GraphT>
+void fp_route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
+                   const NodePotentialsT &potentials, const GraphT &graph,
+                   const typename PolicyT::node_id_t target, const PolicyT &policy) {
     const auto top = queue.peek();
 
     // special case we can run into in case set of
@@ -305,7 +312,8 @@ void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
 
         const auto &weight = graph.weight(edge);
         assert(potentials.check_consitency(top.id, target, weight));
-        auto[delta, tentative_cost] = PolicyT::link(top_label.cost, weight);
+        // the new label lives in the arena of the labels until they are cleared
+        auto[delta, tentative_cost] = PolicyT::link(top_label.cost, weight, labels.resource());
 
         // applying the constrain can clip away the whole function
         if (policy.constrain(tentative_cost)) {
@@ -325,12 +333,12 @@ void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
 }
 } // namespace detail
 
-template <typename PolicyT, typename NodePotentialsT>
+// GraphT only needs to provide the weights of PolicyT::graph_t, e.g. a TurnGraphView
+template <typename PolicyT, typename NodePotentialsT, typename GraphT>
 auto fp_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
-                 const typename PolicyT::weight_t start_weight,
-                 const typename PolicyT::graph_t &graph, typename PolicyT::queue_t &queue,
-                 NodeLabels<PolicyT> &labels, const NodePotentialsT &potentials,
-                 const PolicyT &policy) {
+                 const typename PolicyT::weight_t start_weight, const GraphT &graph,
+                 typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
+                 const NodePotentialsT &potentials, const PolicyT &policy) {
     queue.clear();
     labels.clear();
 
@@ -344,33 +352,36 @@ auto fp_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT
     queue.push(IDKeyPair{start, 0});
 
     while (!queue.empty()) {
-        if (PolicyT::terminate(queue, labels, target)) {
+        if (PolicyT::terminate(queue, labels, target) || Deadline::get().expired()) {
             break;
         }
-        detail::route_step(queue, labels, potentials, graph, target, policy);
+        detail::fp_route_step(queue, labels, potentials, graph, target, policy);
     }
 
-    auto result = labels[target];
+    std::vector<typename PolicyT::label_t> result;
+    result.reserve(labels[target].size());
+    for (const auto entry_id : irange<std::size_t>(0, labels[target].size()))
+        result.push_back(labels.label(target, entry_id));
     std::sort(result.begin(), result.end());
     return result;
 }
 
-template <typename PolicyT>
+template <typename PolicyT, typename GraphT>
 auto fp_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
-                 const typename PolicyT::graph_t &graph, typename PolicyT::queue_t &queue,
+                 const GraphT &graph, typename PolicyT::queue_t &queue,
                  NodeLabels<PolicyT> &labels, const PolicyT &policy) {
     using NodePotentialsT = ZeroNodePotentials<typename PolicyT::graph_t>;
     return fp_dijkstra(start, target, typename PolicyT::weight_t{}, graph, queue, labels,
                        NodePotentialsT{}, policy);
 }
 
-template <typename LabelEntryT, typename FnT>
+template <typename LabelEntryT, typename FnT, typename QueueT>
 auto fp_dijkstra(const typename FunctionGraph<FnT>::node_id_t start,
                  const typename FunctionGraph<FnT>::node_id_t target,
-                 const FunctionGraph<FnT> &graph, MinIDQueue &queue,
-                 NodeLabels<FPDijkstraPolicy<FunctionGraph<FnT>, LabelEntryT>> &labels) {
+                 const FunctionGraph<FnT> &graph, QueueT &queue,
+                 NodeLabels<FPDijkstraPolicy<FunctionGraph<FnT>, LabelEntryT, QueueT>> &labels) {
     using GraphT = FunctionGraph<FnT>;
-    using Policy = FPDijkstraPolicy<GraphT, LabelEntryT>;
+    using Policy = FPDijkstraPolicy<GraphT, LabelEntryT, QueueT>;
     using NodePotentialsT = ZeroNodePotentials<GraphT>;
     return fp_dijkstra(start, target, typename Policy::weight_t{0, 0, FnT{}}, graph, queue, labels,
                        NodePotentialsT{}, Policy{});
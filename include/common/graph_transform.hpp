@@ -2,10 +2,15 @@
 #define GRAPH_UTILS_HPP
 
 #include "common/constants.hpp"
+#include "common/coordinate.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -208,6 +213,157 @@ template <typename GraphT> auto edgeToStartNode(const GraphT &graph) {
     return edge_to_start_node;
 }
 
+namespace detail {
+// Numbers the nodes in the order they are visited by a graph search, component by component.
+// With Breadth = true that is a BFS, otherwise a DFS that numbers the nodes in preorder.
+template <bool Breadth, typename GraphT> auto searchOrder(const GraphT &graph) {
+    using node_id_t = typename GraphT::node_id_t;
+    const auto undirected_graph = toUndirected(graph);
+
+    std::vector<node_id_t> old_to_new(graph.num_nodes(), INVALID_ID);
+    node_id_t next_id = 0;
+    std::deque<node_id_t> nodes;
+    for (auto root : undirected_graph.nodes()) {
+        if (old_to_new[root] != INVALID_ID)
+            continue;
+
+        nodes.push_back(root);
+        if (Breadth) {
+            // a node gets its id when it is queued, so it is queued only once
+            old_to_new[root] = next_id++;
+            while (!nodes.empty()) {
+                const auto node = nodes.front();
+                nodes.pop_front();
+
+                for (auto edge : undirected_graph.edges(node)) {
+                    auto target = undirected_graph.target(edge);
+                    if (old_to_new[target] != INVALID_ID)
+                        continue;
+
+                    old_to_new[target] = next_id++;
+                    nodes.push_back(target);
+                }
+            }
+        } else {
+            // a node gets its id when it is visited, so it may be on the stack more than once
+            while (!nodes.empty()) {
+                const auto node = nodes.back();
+                nodes.pop_back();
+                if (old_to_new[node] != INVALID_ID)
+                    continue;
+
+                old_to_new[node] = next_id++;
+                // reversed, so the first edge is visited first
+                for (auto edge = undirected_graph.end(node); edge > undirected_graph.begin(node);) {
+                    auto target = undirected_graph.target(--edge);
+                    if (old_to_new[target] == INVALID_ID)
+                        nodes.push_back(target);
+                }
+            }
+        }
+    }
+    assert(next_id == graph.num_nodes());
+
+    return old_to_new;
+}
+
+// Position of (x, y) on the Hilbert curve that fills the 2^16 x 2^16 grid
+inline std::uint64_t hilbertIndex(std::uint32_t x, std::uint32_t y) {
+    constexpr std::uint32_t GRID_SIZE = 1u << 16;
+    std::uint64_t index = 0;
+    for (std::uint32_t s = GRID_SIZE / 2; s > 0; s /= 2) {
+        const std::uint32_t rx = (x & s) > 0;
+        const std::uint32_t ry = (y & s) > 0;
+        index += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        // rotate the quadrant
+        if (ry == 0) {
+            if (rx == 1) {
+                x = GRID_SIZE - 1 - x;
+                y = GRID_SIZE - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+} // namespace detail
+
+// The orders below return a permutation old -> new that places nodes that are close in the graph
+// (or on the map) close in memory, apply it with permuteGraph and permuteNodes.
+
+template <typename GraphT> auto bfsOrder(const GraphT &graph) {
+    return detail::searchOrder<true>(graph);
+}
+
+template <typename GraphT> auto dfsOrder(const GraphT &graph) {
+    return detail::searchOrder<false>(graph);
+}
+
+// Orders the nodes along a Hilbert curve over the bounding box of the coordinates
+inline std::vector<std::uint32_t> hilbertOrder(const std::vector<Coordinate> &coordinates) {
+    if (coordinates.empty())
+        return {};
+
+    auto[min_lon, max_lon] = std::minmax_element(
+        coordinates.begin(), coordinates.end(),
+        [](const auto &lhs, const auto &rhs) { return lhs.lon < rhs.lon; });
+    auto[min_lat, max_lat] = std::minmax_element(
+        coordinates.begin(), coordinates.end(),
+        [](const auto &lhs, const auto &rhs) { return lhs.lat < rhs.lat; });
+    const auto to_grid = [](const std::int32_t value, const std::int32_t min,
+                            const std::int32_t max) {
+        const auto range = std::max<std::int64_t>(1, std::int64_t{max} - min);
+        return static_cast<std::uint32_t>((std::int64_t{value} - min) * 0xFFFF / range);
+    };
+
+    std::vector<std::uint64_t> indices(coordinates.size());
+    std::transform(coordinates.begin(), coordinates.end(), indices.begin(),
+                   [&](const auto &coordinate) {
+                       return detail::hilbertIndex(
+                           to_grid(coordinate.lon, min_lon->lon, max_lon->lon),
+                           to_grid(coordinate.lat, min_lat->lat, max_lat->lat));
+                   });
+
+    std::vector<std::uint32_t> order(coordinates.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&indices](const auto lhs, const auto rhs) {
+        return indices[lhs] < indices[rhs];
+    });
+
+    std::vector<std::uint32_t> old_to_new(coordinates.size());
+    for (std::uint32_t new_id = 0; new_id < order.size(); ++new_id) {
+        old_to_new[order[new_id]] = new_id;
+    }
+    return old_to_new;
+}
+
+// Renumbers the nodes of the graph, the edges of every node are sorted by their new target id
+template <typename GraphT, typename NodeT>
+GraphT permuteGraph(const GraphT &graph, const std::vector<NodeT> &old_to_new) {
+    assert(old_to_new.size() == graph.num_nodes());
+    auto edges = graph.edges();
+    for (auto &e : edges) {
+        e.start = old_to_new[e.start];
+        e.target = old_to_new[e.target];
+    }
+    std::stable_sort(edges.begin(), edges.end(), [](const auto &lhs, const auto &rhs) {
+        return std::tie(lhs.start, lhs.target) < std::tie(rhs.start, rhs.target);
+    });
+
+    return GraphT{graph.num_nodes(), std::move(edges)};
+}
+
+// Moves the value of every node to its new id
+template <typename T, typename NodeT>
+std::vector<T> permuteNodes(const std::vector<T> &values, const std::vector<NodeT> &old_to_new) {
+    assert(old_to_new.size() == values.size());
+    std::vector<T> permuted(values.size());
+    for (std::size_t node = 0; node < values.size(); ++node) {
+        permuted[old_to_new[node]] = values[node];
+    }
+    return permuted;
+}
+
 } // namespace common
 } // namespace charge
 
@@ -8,8 +8,9 @@
 
 #include <algorithm>
 #include <cmath>
-#include <vector>
 #include <limits>
+#include <memory_resource>
+#include <vector>
 
 namespace charge::common {
 
@@ -32,10 +33,14 @@ struct InterpolatingFunction {
         : values{values_} {}
 
     InterpolatingFunction() noexcept = default;
+    // Copies use the default resource, moves keep the memory of other
     InterpolatingFunction(const InterpolatingFunction &other) noexcept { values = other.values; }
-    InterpolatingFunction(InterpolatingFunction &&other) noexcept {
-        values = std::move(other.values);
-    }
+    InterpolatingFunction(InterpolatingFunction &&other) noexcept
+        : values(std::move(other.values)) {}
+
+    // Empty function whose values are allocated from resource, e.g. the arena of a search
+    explicit InterpolatingFunction(std::pmr::memory_resource *resource) noexcept
+        : values(resource) {}
     InterpolatingFunction &operator=(const InterpolatingFunction &other) noexcept {
         values = other.values;
         return *this;
@@ -174,7 +179,7 @@ struct InterpolatingFunction {
     double max_x() const { return std::get<0>(values.back()); }
 
   private:
-    std::vector<std::tuple<double, double>> values;
+    std::pmr::vector<std::tuple<double, double>> values;
 };
 }
 
@@ -0,0 +1,302 @@
+#ifndef CHARGE_COMMON_LANDMARKS_HPP
+#define CHARGE_COMMON_LANDMARKS_HPP
+
+#include "common/constants.hpp"
+#include "common/dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/irange.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace charge::common {
+
+// Distances from and to a small set of landmarks that yield lower bounds
+// on the distance between any two nodes via the triangle inequality (ALT).
+template <typename GraphT> class Landmarks {
+  public:
+    using node_id_t = typename GraphT::node_id_t;
+    using weight_t = typename GraphT::weight_t;
+
+    Landmarks() = default;
+
+    // forward_distances[v * num_landmarks + l] is the distance from landmark l to v,
+    // backward_distances[v * num_landmarks + l] is the distance from v to landmark l.
+    // Entries of one node are stored consecutive since all landmarks are scanned per node.
+    Landmarks(std::vector<node_id_t> landmarks_, std::vector<weight_t> forward_distances_,
+              std::vector<weight_t> backward_distances_)
+        : landmarks(std::move(landmarks_)), forward_distances(std::move(forward_distances_)),
+          backward_distances(std::move(backward_distances_)) {
+        assert(forward_distances.size() == backward_distances.size());
+        assert(landmarks.size() == 0 || forward_distances.size() % landmarks.size() == 0);
+    }
+
+    // Takes one distance vector per landmark
+    Landmarks(std::vector<node_id_t> landmarks_,
+              const std::vector<std::vector<weight_t>> &forward_columns,
+              const std::vector<std::vector<weight_t>> &backward_columns)
+        : landmarks(std::move(landmarks_)) {
+        assert(forward_columns.size() == landmarks.size());
+        assert(backward_columns.size() == landmarks.size());
+        const auto num_nodes = landmarks.empty() ? 0 : forward_columns.front().size();
+        forward_distances.resize(num_nodes * landmarks.size());
+        backward_distances.resize(num_nodes * landmarks.size());
+        for (auto node : irange<std::size_t>(0, num_nodes)) {
+            for (auto index : irange<std::size_t>(0, landmarks.size())) {
+                forward_distances[node * landmarks.size() + index] = forward_columns[index][node];
+                backward_distances[node * landmarks.size() + index] =
+                    backward_columns[index][node];
+            }
+        }
+    }
+
+    std::size_t num_landmarks() const { return landmarks.size(); }
+
+    std::size_t num_nodes() const {
+        return landmarks.empty() ? 0 : forward_distances.size() / landmarks.size();
+    }
+
+    const std::vector<node_id_t> &ids() const { return landmarks; }
+
+    // Lower bound on the distance from `from` to `to`. Never INF_WEIGHT: landmarks
+    // that can't reach or can't be reached by one of the nodes are ignored.
+    weight_t lower_bound(const node_id_t from, const node_id_t to) const {
+        const auto num = landmarks.size();
+        const auto *from_forward = forward_distances.data() + from * num;
+        const auto *to_forward = forward_distances.data() + to * num;
+        const auto *from_backward = backward_distances.data() + from * num;
+        const auto *to_backward = backward_distances.data() + to * num;
+
+        weight_t bound = 0;
+        for (auto index = 0u; index < num; ++index) {
+            // d(from, to) >= d(l, to) - d(l, from)
+            if (to_forward[index] != INF_WEIGHT && from_forward[index] != INF_WEIGHT)
+                bound = std::max(bound, to_forward[index] - from_forward[index]);
+            // d(from, to) >= d(from, l) - d(to, l)
+            if (from_backward[index] != INF_WEIGHT && to_backward[index] != INF_WEIGHT)
+                bound = std::max(bound, from_backward[index] - to_backward[index]);
+        }
+        return bound;
+    }
+
+    static auto unwrap(Landmarks landmarks) {
+        return std::make_tuple(std::move(landmarks.landmarks),
+                               std::move(landmarks.forward_distances),
+                               std::move(landmarks.backward_distances));
+    }
+
+  private:
+    std::vector<node_id_t> landmarks;
+    std::vector<weight_t> forward_distances;
+    std::vector<weight_t> backward_distances;
+};
+
+namespace detail {
+template <typename GraphT>
+auto distances_from(const typename GraphT::node_id_t source, const GraphT &graph,
+                    MinIDQueue &queue, CostVector<GraphT> &costs) {
+    dijkstra_to_all(source, graph, queue, costs);
+    std::vector<typename GraphT::weight_t> distances(graph.num_nodes());
+    for (const auto node : graph.nodes()) {
+        distances[node] = costs[node];
+    }
+    return distances;
+}
+
+// Returns the node with the largest finite distance
+template <typename GraphT>
+auto farthest_node(const GraphT &graph, const CostVector<GraphT> &costs) {
+    auto farthest = INVALID_ID;
+    typename GraphT::weight_t max_cost = -1;
+    for (const auto node : graph.nodes()) {
+        if (costs[node] != INF_WEIGHT && costs[node] > max_cost) {
+            max_cost = costs[node];
+            farthest = node;
+        }
+    }
+    return farthest;
+}
+
+template <typename GraphT> class LandmarkSelection {
+  public:
+    using node_id_t = typename GraphT::node_id_t;
+    using weight_t = typename GraphT::weight_t;
+
+    LandmarkSelection(const GraphT &forward_graph, const GraphT &reverse_graph)
+        : forward_graph(forward_graph), reverse_graph(reverse_graph),
+          queue(forward_graph.num_nodes()), costs(forward_graph.num_nodes(), INF_WEIGHT),
+          is_landmark(forward_graph.num_nodes(), false) {}
+
+    void add(const node_id_t landmark) {
+        assert(!is_landmark[landmark]);
+        is_landmark[landmark] = true;
+        landmarks.push_back(landmark);
+        forward_columns.push_back(distances_from(landmark, forward_graph, queue, costs));
+        backward_columns.push_back(distances_from(landmark, reverse_graph, queue, costs));
+    }
+
+    weight_t lower_bound(const node_id_t from, const node_id_t to) const {
+        weight_t bound = 0;
+        for (auto index : irange<std::size_t>(0, landmarks.size())) {
+            const auto &forward = forward_columns[index];
+            const auto &backward = backward_columns[index];
+            if (forward[to] != INF_WEIGHT && forward[from] != INF_WEIGHT)
+                bound = std::max(bound, forward[to] - forward[from]);
+            if (backward[from] != INF_WEIGHT && backward[to] != INF_WEIGHT)
+                bound = std::max(bound, backward[from] - backward[to]);
+        }
+        return bound;
+    }
+
+    Landmarks<GraphT> finish() const {
+        return Landmarks<GraphT>{landmarks, forward_columns, backward_columns};
+    }
+
+    const GraphT &forward_graph;
+    const GraphT &reverse_graph;
+    MinIDQueue queue;
+    CostVector<GraphT> costs;
+    std::vector<bool> is_landmark;
+    std::vector<node_id_t> landmarks;
+    std::vector<std::vector<weight_t>> forward_columns;
+    std::vector<std::vector<weight_t>> backward_columns;
+};
+} // namespace detail
+
+// Farthest selection: Every new landmark is the node that maximizes the
+// distance to the closest landmark selected so far.
+template <typename GraphT>
+auto select_farthest_landmarks(const GraphT &forward_graph, const GraphT &reverse_graph,
+                               const std::size_t num_landmarks, const std::size_t seed) {
+    using node_id_t = typename GraphT::node_id_t;
+    using weight_t = typename GraphT::weight_t;
+
+    detail::LandmarkSelection<GraphT> selection(forward_graph, reverse_graph);
+    std::default_random_engine generator(seed);
+    std::uniform_int_distribution<node_id_t> distribution(0, forward_graph.num_nodes() - 1);
+
+    std::vector<std::tuple<node_id_t, weight_t>> sources{{distribution(generator), 0}};
+    while (selection.landmarks.size() < std::min<std::size_t>(num_landmarks, forward_graph.num_nodes())) {
+        dijkstra_to_all(sources, forward_graph, selection.queue, selection.costs,
+                        [](const auto &) { return false; });
+        auto landmark = detail::farthest_node(forward_graph, selection.costs);
+        // the remaining nodes are all landmarks or not reachable, restart somewhere else
+        if (landmark == INVALID_ID || selection.is_landmark[landmark]) {
+            landmark = distribution(generator);
+            if (selection.is_landmark[landmark])
+                continue;
+        }
+        selection.add(landmark);
+
+        sources.clear();
+        for (const auto l : selection.landmarks)
+            sources.emplace_back(l, 0);
+    }
+
+    return selection.finish();
+}
+
+// Avoid selection (Goldberg and Werneck): Grows a shortest path tree from a random root
+// and weights every node by how bad the current landmarks bound its distance to the root.
+// The next landmark is the leaf reached by following the heaviest subtrees
+// that do not contain a landmark yet.
+template <typename GraphT>
+auto select_avoid_landmarks(const GraphT &forward_graph, const GraphT &reverse_graph,
+                            const std::size_t num_landmarks, const std::size_t seed) {
+    using node_id_t = typename GraphT::node_id_t;
+
+    const auto num_nodes = forward_graph.num_nodes();
+    detail::LandmarkSelection<GraphT> selection(forward_graph, reverse_graph);
+    std::default_random_engine generator(seed);
+    std::uniform_int_distribution<node_id_t> distribution(0, num_nodes - 1);
+
+    ParentVector<GraphT> parents(num_nodes, INVALID_ID);
+    std::vector<node_id_t> settle_order;
+    std::vector<std::int64_t> sizes(num_nodes);
+    std::vector<bool> contains_landmark(num_nodes);
+    std::vector<std::vector<node_id_t>> children(num_nodes);
+
+    const auto max_landmarks = std::min<std::size_t>(num_landmarks, num_nodes);
+
+    // start with the node farthest from a random root
+    if (max_landmarks > 0) {
+        dijkstra_to_all(distribution(generator), forward_graph, selection.queue, selection.costs);
+        selection.add(detail::farthest_node(forward_graph, selection.costs));
+    }
+    while (selection.landmarks.size() < max_landmarks) {
+        const auto root = distribution(generator);
+
+        selection.costs.clear();
+        selection.queue.clear();
+        parents.clear();
+        settle_order.clear();
+        selection.costs[root] = 0;
+        selection.queue.push({root, 0});
+        while (!selection.queue.empty()) {
+            settle_order.push_back(selection.queue.peek().id);
+            detail::route_step(selection.queue, selection.costs, parents, forward_graph);
+        }
+
+        for (const auto node : settle_order) {
+            sizes[node] = selection.costs[node] - selection.lower_bound(root, node);
+            contains_landmark[node] = selection.is_landmark[node];
+            children[node].clear();
+        }
+        // children are settled after their parents
+        for (auto iter = settle_order.rbegin(); iter != settle_order.rend(); ++iter) {
+            const auto node = *iter;
+            if (contains_landmark[node])
+                sizes[node] = 0;
+
+            const auto parent = parents[node];
+            if (parent != INVALID_ID) {
+                sizes[parent] += sizes[node];
+                contains_landmark[parent] = contains_landmark[parent] || contains_landmark[node];
+                children[parent].push_back(node);
+            }
+        }
+
+        if (contains_landmark[root] && sizes[root] == 0) {
+            // every subtree already has a landmark, fall back to a random node
+            const auto landmark = distribution(generator);
+            if (!selection.is_landmark[landmark])
+                selection.add(landmark);
+            continue;
+        }
+
+        auto current = root;
+        while (!children[current].empty()) {
+            const auto heaviest = *std::max_element(
+                children[current].begin(), children[current].end(),
+                [&](const auto lhs, const auto rhs) { return sizes[lhs] < sizes[rhs]; });
+            if (sizes[heaviest] == 0)
+                break;
+            current = heaviest;
+        }
+
+        if (!selection.is_landmark[current])
+            selection.add(current);
+    }
+
+    return selection.finish();
+}
+
+template <typename GraphT>
+auto select_landmarks(const std::string &method, const GraphT &forward_graph,
+                      const GraphT &reverse_graph, const std::size_t num_landmarks,
+                      const std::size_t seed) {
+    if (method == "avoid") {
+        return select_avoid_landmarks(forward_graph, reverse_graph, num_landmarks, seed);
+    } else if (method == "farthest") {
+        return select_farthest_landmarks(forward_graph, reverse_graph, num_landmarks, seed);
+    }
+
+    throw std::runtime_error("Unknown landmark selection method " + method);
+}
+} // namespace charge::common
+
+#endif
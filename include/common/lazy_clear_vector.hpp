@@ -1,24 +1,28 @@
 #ifndef WEIGHT_CONTAINER_HPP
 #define WEIGHT_CONTAINER_HPP
 
+#include <algorithm>
 #include <cstdint>
-#include <vector>
 #include <limits>
+#include <vector>
 
 namespace charge
 {
 namespace common
 {
 
-template <typename ElementT> class LazyClearVector {
+// Vector that is cleared in O(1) by bumping a generation counter, every entry that is not of
+// the current generation reads as the default value. Only once the counter overflows all
+// generations are reset in O(n), with the default 32 bit counter that never happens in practice.
+template <typename ElementT, typename CounterT = std::uint32_t> class LazyClearVector {
   public:
 	using value_t = ElementT;
-	using counter_t = std::uint8_t;
+	using counter_t = CounterT;
     static const constexpr counter_t INVALID_GENERATION = std::numeric_limits<counter_t>::max();
 
 	LazyClearVector(std::size_t size_, value_t default_value_)
-		: default_value(std::move(default_value_)), generations(size_, 0),
-		  elements(size_, default_value), generation_counter(0) {}
+		: default_value(std::move(default_value_)), generation_counter(0), generations(size_, 0),
+		  elements(size_, default_value) {}
 
 	void clear() {
         ++generation_counter;
@@ -60,15 +64,15 @@ template <typename ElementT> class LazyClearVector {
 	std::vector<value_t> elements;
 };
 
-template<> class LazyClearVector<bool> {
+template <typename CounterT> class LazyClearVector<bool, CounterT> {
   public:
 	using value_t = bool;
-	using counter_t = std::uint8_t;
+	using counter_t = CounterT;
     static const constexpr counter_t INVALID_GENERATION = std::numeric_limits<counter_t>::max();
 
 	LazyClearVector(std::size_t size_, value_t default_value_)
-		: default_value(std::move(default_value_)), generations(size_, 0),
-		  elements(size_, default_value), generation_counter(0) {}
+		: default_value(std::move(default_value_)), generation_counter(0), generations(size_, 0),
+		  elements(size_, default_value) {}
 
 	void clear() {
         ++generation_counter;
@@ -110,6 +114,61 @@ template<> class LazyClearVector<bool> {
 	std::vector<value_t> elements;
 };
 
+// Same interface as LazyClearVector but every value is stored next to its generation.
+// Checking the generation and reading the value then only touches one cache line,
+// which pays off for random access patterns like the tentative costs of a search.
+template <typename ElementT, typename CounterT = std::uint32_t> class PackedLazyClearVector {
+  public:
+    using value_t = ElementT;
+    using counter_t = CounterT;
+    static const constexpr counter_t INVALID_GENERATION = std::numeric_limits<counter_t>::max();
+
+    PackedLazyClearVector(std::size_t size_, value_t default_value_)
+        : default_value(std::move(default_value_)), generation_counter(0),
+          entries(size_, Entry{0, default_value}) {}
+
+    void clear() {
+        ++generation_counter;
+
+        if (generation_counter == INVALID_GENERATION) {
+            for (auto &entry : entries)
+                entry.generation = INVALID_GENERATION;
+            generation_counter = 0;
+        }
+    }
+
+    const value_t &peek(std::size_t index) const { return (*this)[index]; }
+
+    const value_t &operator[](std::size_t index) const {
+        const auto &entry = entries[index];
+        if (entry.generation == generation_counter) {
+            return entry.value;
+        }
+        return default_value;
+    }
+
+    value_t &operator[](std::size_t index) {
+        auto &entry = entries[index];
+        if (entry.generation != generation_counter) {
+            entry.value = default_value;
+            entry.generation = generation_counter;
+        }
+        return entry.value;
+    }
+
+    std::size_t size() const { return entries.size(); }
+
+  private:
+    struct Entry {
+        counter_t generation;
+        value_t value;
+    };
+
+    value_t default_value;
+    counter_t generation_counter;
+    std::vector<Entry> entries;
+};
+
 }
 }
 
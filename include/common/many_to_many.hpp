@@ -0,0 +1,90 @@
+#ifndef CHARGE_COMMON_MANY_TO_MANY_HPP
+#define CHARGE_COMMON_MANY_TO_MANY_HPP
+
+#include "common/constants.hpp"
+#include "common/dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/irange.hpp"
+#include "common/parallel_for.hpp"
+
+#include <vector>
+
+namespace charge::common {
+
+// Computes distance tables between a set of sources and a set of targets.
+// Runs one search per node of the smaller set that stops as soon as all nodes of the
+// other set are settled, forward from the sources or backward from the targets.
+// Requires non-negative weights, graphs with negative weights need to be shifted first
+// (e.g. by ev::shift_negative_weights) and the shifting potential passed along.
+template <typename GraphT, typename QueueT = MinIDQueue> class ManyToMany {
+  public:
+    using node_id_t = typename GraphT::node_id_t;
+    using weight_t = typename GraphT::weight_t;
+
+    ManyToMany(const GraphT &forward_graph, const GraphT &reverse_graph)
+        : forward_graph(forward_graph), reverse_graph(reverse_graph) {}
+
+    // The weights of the graphs are w(u, v) + potential[u] - potential[v],
+    // the returned table contains the distances of the original weights.
+    ManyToMany(const GraphT &forward_graph, const GraphT &reverse_graph,
+               std::vector<std::int32_t> shifting_potential)
+        : forward_graph(forward_graph), reverse_graph(reverse_graph),
+          shifting_potential(std::move(shifting_potential)) {}
+
+    // Returns the |sources| x |targets| table in row-major order,
+    // unreachable entries are INF_WEIGHT.
+    std::vector<weight_t> operator()(const std::vector<node_id_t> &sources,
+                                     const std::vector<node_id_t> &targets,
+                                     const std::size_t num_threads = 1) const {
+        std::vector<weight_t> table(sources.size() * targets.size(), INF_WEIGHT);
+        if (sources.empty() || targets.empty())
+            return table;
+
+        const bool forward = sources.size() <= targets.size();
+        const auto &graph = forward ? forward_graph : reverse_graph;
+        const auto &starts = forward ? sources : targets;
+        const auto &ends = forward ? targets : sources;
+
+        QueueT queue_example(graph.num_nodes());
+        CostVector<GraphT> costs_example(graph.num_nodes(), INF_WEIGHT);
+
+        parallel_for(
+            irange<std::size_t>(0, starts.size()),
+            [&](const auto &range) {
+                auto queue = queue_example;
+                auto costs = costs_example;
+
+                for (auto index : range) {
+                    const auto row = dijkstra_to_targets(starts[index], ends, graph, queue, costs);
+                    for (auto end_index : irange<std::size_t>(0, ends.size())) {
+                        if (forward)
+                            table[index * targets.size() + end_index] = row[end_index];
+                        else
+                            table[end_index * targets.size() + index] = row[end_index];
+                    }
+                }
+            },
+            num_threads);
+
+        if (!shifting_potential.empty()) {
+            for (auto source_index : irange<std::size_t>(0, sources.size())) {
+                for (auto target_index : irange<std::size_t>(0, targets.size())) {
+                    auto &cost = table[source_index * targets.size() + target_index];
+                    if (cost != INF_WEIGHT)
+                        cost += shifting_potential[targets[target_index]] -
+                                shifting_potential[sources[source_index]];
+                }
+            }
+        }
+
+        return table;
+    }
+
+  private:
+    const GraphT &forward_graph;
+    const GraphT &reverse_graph;
+    std::vector<std::int32_t> shifting_potential;
+};
+} // namespace charge::common
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef CHARGE_COMMON_MULTI_CRITERIA_DIJKSTRA_HPP
 #define CHARGE_COMMON_MULTI_CRITERIA_DIJKSTRA_HPP
 
+#include "common/deadline.hpp"
 #include "common/dijkstra_private.hpp"
 #include "common/domination.hpp"
 #include "common/id_queue.hpp"
@@ -114,8 +115,8 @@ template <typename T1, typename T2> auto first_entry(const std::tuple<T1, T2> &t
     return std::get<0>(tuple);
 }
 
-template <typename NodeLabelsT>
-bool min_key_terminate(const MinIDQueue &queue, const NodeLabelsT &labels,
+template <typename QueueT, typename NodeLabelsT>
+bool min_key_terminate(const QueueT &queue, const NodeLabelsT &labels,
                        const typename NodeLabelsT::node_id_t target) {
     if (labels[target].empty())
         return false;
@@ -129,10 +130,11 @@ namespace multi_criteria_traits {
 using namespace bi_criterial_traits;
 } // namespace multi_criteria_traits
 
-template <typename GraphT, typename NodeEntryT> class MCDijkstraPolicy {
+template <typename GraphT, typename NodeEntryT, typename QueueT = MinIDQueue>
+class MCDijkstraPolicy {
   public:
     using graph_t = GraphT;
-    using queue_t = MinIDQueue;
+    using queue_t = QueueT;
     using key_t = std::int32_t;
     using weight_t = typename GraphT::weight_t;
     using cost_t = typename GraphT::weight_t;
@@ -140,9 +142,12 @@ template <typename GraphT, typename NodeEntryT> class MCDijkstraPolicy {
     using label_t = NodeEntryT;
 
     static constexpr bool enable_stalling = true;
+    // NodeLabels keeps the settled costs as a sorted skyline, see SkylineRange
+    static constexpr bool sorted_skyline =
+        std::is_same_v<cost_t, std::tuple<std::int32_t, std::int32_t>>;
 
-    template <typename NodeLabelsT>
-    static bool terminate(const MinIDQueue &, const NodeLabelsT &, const node_id_t) {
+    template <typename AnyQueueT, typename NodeLabelsT>
+    static bool terminate(const AnyQueueT &, const NodeLabelsT &, const node_id_t) {
         return false;
     }
 
@@ -178,6 +183,12 @@ template <typename GraphT, typename NodeEntryT> class MCDijkstraPolicy {
         return std::make_tuple(false, false);
     }
 
+    static auto clip_dominated(const SkylineRange<cost_t> &skyline, const cost_t &rhs) {
+        Statistics::get().count(StatisticsEvent::DOMINATION);
+        const auto is_dominated = skyline.any_within(std::get<0>(rhs), std::get<1>(rhs));
+        return std::make_tuple(is_dominated, is_dominated);
+    }
+
     static auto key(const cost_t &cost) { return multi_criteria_traits::first_entry(cost); }
 };
 
@@ -211,33 +222,15 @@ class MCDijkstraWeightedNodePolicy : public MCDijkstraPolicy<GraphT, LabelEntryT
 
 namespace detail {
 
-template <typename PolicyT, typename NodePotentialsT>
-void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
-                const NodePotentialsT &potentials, const typename PolicyT::graph_t &graph,
-                const typename PolicyT::node_id_t target, const PolicyT &policy) {
-    const auto top = queue.peek();
-    // special case we can run into in case set of
-    // unsettled labels was emptied after a pop
-    if (labels.empty(top.id)) {
-        queue.pop();
-        return;
-    }
-
-    const auto[top_label, top_entry_id] = labels.pop(top.id, policy, potentials);
-    if (labels.empty(top.id)) {
-        queue.pop();
-    } else {
-        // sync the queue key with the new min label key
-        const auto top_key = labels.min(top.id).key;
-        assert(top_key >= 0);
-
-        const auto current_top_key = queue.get_key(top.id);
-        assert(top_key >= current_top_key);
-
-        if (top_key > current_top_key) {
-            queue.increase_key(IDKeyPair{top.id, top_key});
-        }
-    }
+// Relaxes the node weight and all edges of a label that was just settled at top_id.
+// New labels are handed to insert(node, label).
+template <typename PolicyT, typename NodePotentialsT, typename GraphT, typename InsertT>
+void mc_relax_label(const typename PolicyT::node_id_t top_id,
+                    const typename PolicyT::label_t &top_label, const std::size_t top_entry_id,
+                    NodeLabels<PolicyT> &labels, const NodePotentialsT &potentials,
+                    const GraphT &graph, const typename PolicyT::node_id_t target,
+                    const PolicyT &policy, const InsertT &insert) {
+    using label_t = typename PolicyT::label_t;
 
     // clang-format off
     if constexpr(PolicyT::enable_stalling) {
@@ -248,8 +241,8 @@ void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
     }
     // clang-format on
 
-    Statistics::get().max(StatisticsEvent::LABEL_MAX_NUM_UNSETTLED, labels.size(top.id));
-    Statistics::get().max(StatisticsEvent::LABEL_MAX_NUM_SETTLED, labels[top.id].size());
+    Statistics::get().max(StatisticsEvent::LABEL_MAX_NUM_UNSETTLED, labels.size(top_id));
+    Statistics::get().max(StatisticsEvent::LABEL_MAX_NUM_SETTLED, labels[top_id].size());
 
 #ifdef CHARGE_ENABLE_MEMORY_STATISTICS
     if (Options::get().tail_memory) {
@@ -263,10 +256,10 @@ void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
 
     // clang-format off
     if constexpr (has_node_weights<PolicyT>::value) {
-        if (policy.weighted(top.id)) {
+        if (policy.weighted(top_id)) {
             bool pruned = false;
             if constexpr(is_parent_label<typename PolicyT::label_t>::value) {
-                if (top.id == top_label.parent)
+                if (top_id == top_label.parent)
                 {
                     Statistics::get().count(StatisticsEvent::DIJKSTRA_PARENT_PRUNE);
                     pruned = true;
@@ -290,20 +283,20 @@ void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
                             assert(std::get<1>(tentative_cost) >= 0);
                             const auto label_key =
                                 potentials.key(target, PolicyT::key(tentative_cost), tentative_cost);
-                            insert_label(queue, labels, policy, potentials, top.id,
-                                         {label_key, std::move(tentative_cost), top.id, parent_entry});
+                            insert(top_id, label_t{label_key, std::move(tentative_cost), top_id,
+                                                   parent_entry});
                         }
                     }
                 };
 
-                policy.link_node(top_label.cost, top.id, make_sink_iter(std::ref(insert_solution)));
-                labels.cleanup_unsettled(top.id);
+                policy.link_node(top_label.cost, top_id, make_sink_iter(std::ref(insert_solution)));
+                labels.cleanup_unsettled(top_id);
             }
         }
     }
     // clang-format on
 
-    for (auto edge = graph.begin(top.id); edge < graph.end(top.id); ++edge) {
+    for (auto edge = graph.begin(top_id); edge < graph.end(top_id); ++edge) {
         const auto target = graph.target(edge);
         // clang-format off
         if constexpr(is_parent_label<typename PolicyT::label_t>::value) {
@@ -325,16 +318,50 @@ void route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
         assert(std::get<0>(tentative_cost) >= std::get<0>(top_label.cost));
         assert(std::get<1>(tentative_cost) >= 0);
         const auto label_key = potentials.key(target, PolicyT::key(tentative_cost), tentative_cost);
-        insert_label(
-            queue, labels, policy, potentials, target,
-            {label_key, std::move(tentative_cost), top.id, static_cast<unsigned>(top_entry_id)});
+        insert(target, label_t{label_key, std::move(tentative_cost), top_id,
+                               static_cast<unsigned>(top_entry_id)});
     }
 }
+
+template <typename PolicyT, typename NodePotentialsT, typename GraphT>
+void mc_route_step(typename PolicyT::queue_t &queue, NodeLabels<PolicyT> &labels,
+                   const NodePotentialsT &potentials, const GraphT &graph,
+                   const typename PolicyT::node_id_t target, const PolicyT &policy) {
+    const auto top = queue.peek();
+    // special case we can run into in case set of
+    // unsettled labels was emptied after a pop
+    if (labels.empty(top.id)) {
+        queue.pop();
+        return;
+    }
+
+    const auto[top_label, top_entry_id] = labels.pop(top.id, policy, potentials);
+    if (labels.empty(top.id)) {
+        queue.pop();
+    } else {
+        // sync the queue key with the new min label key
+        const auto top_key = labels.min(top.id).key;
+        assert(top_key >= 0);
+
+        const auto current_top_key = queue.get_key(top.id);
+        assert(top_key >= current_top_key);
+
+        if (top_key > current_top_key) {
+            queue.increase_key(IDKeyPair{top.id, top_key});
+        }
+    }
+
+    mc_relax_label(top.id, top_label, top_entry_id, labels, potentials, graph, target, policy,
+                   [&](const auto node, auto label) {
+                       insert_label(queue, labels, policy, potentials, node, std::move(label));
+                   });
+}
 } // namespace detail
 
-template <typename PolicyT, typename NodePotentialsT>
+// GraphT only needs to provide the weights of PolicyT::graph_t, e.g. a TurnGraphView
+template <typename PolicyT, typename NodePotentialsT, typename GraphT>
 auto mc_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
-                 const typename PolicyT::graph_t &graph, typename PolicyT::queue_t &queue,
+                 const GraphT &graph, typename PolicyT::queue_t &queue,
                  NodeLabels<PolicyT> &labels, const NodePotentialsT &potentials,
                  const PolicyT &policy) {
     queue.clear();
@@ -344,30 +371,32 @@ auto mc_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT
     queue.push(IDKeyPair{start, 0});
 
     while (!queue.empty()) {
-        if (PolicyT::terminate(queue, labels, target)) {
+        if (PolicyT::terminate(queue, labels, target) || Deadline::get().expired()) {
             break;
         }
-        detail::route_step(queue, labels, potentials, graph, target, policy);
+        detail::mc_route_step(queue, labels, potentials, graph, target, policy);
     }
 
-    auto solutions = lower_envelop(labels[target]);
+    const auto &target_labels = labels[target];
+    auto solutions = lower_envelop(
+        std::vector<typename PolicyT::label_t>(target_labels.begin(), target_labels.end()));
     return solutions;
 }
 
-template <typename PolicyT>
+template <typename PolicyT, typename GraphT>
 auto mc_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
-                 const typename PolicyT::graph_t &graph, typename PolicyT::queue_t &queue,
+                 const GraphT &graph, typename PolicyT::queue_t &queue,
                  NodeLabels<PolicyT> &labels, const PolicyT &policy) {
     return mc_dijkstra(start, target, graph, queue, labels,
                        ZeroNodePotentials<typename PolicyT::graph_t>{}, policy);
 }
 
-template <typename LabelEntryT, typename GraphT>
+template <typename LabelEntryT, typename GraphT, typename QueueT>
 auto mc_dijkstra(const typename GraphT::node_id_t start, const typename GraphT::node_id_t target,
-                 const GraphT &graph, MinIDQueue &queue,
-                 NodeLabels<MCDijkstraPolicy<GraphT, LabelEntryT>> &labels) {
+                 const GraphT &graph, QueueT &queue,
+                 NodeLabels<MCDijkstraPolicy<GraphT, LabelEntryT, QueueT>> &labels) {
     return mc_dijkstra(start, target, graph, queue, labels, ZeroNodePotentials<GraphT>{},
-                       MCDijkstraPolicy<GraphT, LabelEntryT>{});
+                       MCDijkstraPolicy<GraphT, LabelEntryT, QueueT>{});
 }
 
 template <typename LabelEntryT, typename GraphT, typename NodeWeightsT>
@@ -379,6 +408,135 @@ auto mc_dijkstra(
         start, target, graph, queue, labels, ZeroNodePotentials<GraphT>{},
         MCDijkstraWeightedNodePolicy<GraphT, LabelEntryT, NodeWeightsT>{node_weights});
 }
+
+// One heap for the unsettled labels of all nodes, ordered lexicographically by key and cost.
+// Pushing never touches the labels of the node and nothing is removed from the heap when it
+// becomes dominated, dominated labels are only dropped once they are popped (lazy deletion).
+template <typename LabelT> class LabelHeap {
+  public:
+    using label_t = LabelT;
+    using node_id_t = typename label_t::node_id_t;
+
+    struct Entry {
+        node_id_t node;
+        label_t label;
+    };
+
+    LabelHeap() {}
+
+    // Same signature as the node queues, reserves room for one label per node
+    explicit LabelHeap(const std::size_t num_nodes) { entries.reserve(num_nodes); }
+
+    bool empty() const { return entries.empty(); }
+
+    std::size_t size() const { return entries.size(); }
+
+    void clear() { entries.clear(); }
+
+    IDKeyPair peek() const {
+        assert(!empty());
+        return IDKeyPair{entries.front().node, entries.front().label.key};
+    }
+
+    void push(const node_id_t node, label_t label) {
+        Statistics::get().count(StatisticsEvent::QUEUE_PUSH);
+        entries.push_back(Entry{node, std::move(label)});
+        std::push_heap(entries.begin(), entries.end(), greater);
+    }
+
+    Entry pop() {
+        Statistics::get().count(StatisticsEvent::QUEUE_POP);
+        assert(!empty());
+        std::pop_heap(entries.begin(), entries.end(), greater);
+        auto top = std::move(entries.back());
+        entries.pop_back();
+        return top;
+    }
+
+  private:
+    static bool greater(const Entry &lhs, const Entry &rhs) {
+        if (lhs.label.key != rhs.label.key)
+            return lhs.label.key > rhs.label.key;
+        return rhs.label < lhs.label;
+    }
+
+    std::vector<Entry> entries;
+};
+
+namespace detail {
+template <typename PolicyT, typename NodePotentialsT, typename GraphT>
+void mc_label_heap_step(LabelHeap<typename PolicyT::label_t> &heap, NodeLabels<PolicyT> &labels,
+                        const NodePotentialsT &potentials, const GraphT &graph,
+                        const typename PolicyT::node_id_t target, const PolicyT &policy) {
+    auto[top_id, label] = heap.pop();
+
+    // the label may have been dominated since it was pushed
+    const auto old_key = label.key;
+    const auto[is_dominated, was_modified] =
+        labels.clip_dominated(top_id, label, policy, potentials);
+    if (is_dominated) {
+        return;
+    }
+    if (was_modified) {
+        // clang-format off
+        if constexpr(is_delta_label<typename PolicyT::label_t>::value) {
+            label.delta.limit_from_x(label.cost.min_x(), label.cost.max_x());
+            label.delta.shrink_to_fit();
+        }
+        shrink_cost(label.cost);
+        // clang-format on
+        // clipping can only make the label worse, it needs to wait for its new key
+        if (label.key > old_key) {
+            heap.push(top_id, std::move(label));
+            return;
+        }
+    }
+
+    const auto[top_label, top_entry_id] = labels.settle(top_id, std::move(label));
+
+    mc_relax_label(top_id, top_label, top_entry_id, labels, potentials, graph, target, policy,
+                   [&](const auto node, auto new_label) {
+                       Statistics::get().count(StatisticsEvent::LABEL_PUSH);
+                       if (!labels.dominated(node, new_label.cost, policy)) {
+                           heap.push(node, std::move(new_label));
+                       }
+                   });
+}
+} // namespace detail
+
+// Same search as mc_dijkstra but with one global LabelHeap instead of a node queue plus a heap
+// of unsettled labels per node. There is no key of a node to keep in sync, every new label costs
+// one dominance check against the settled labels and one heap push.
+template <typename PolicyT, typename NodePotentialsT, typename GraphT>
+auto mc_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
+                 const GraphT &graph, LabelHeap<typename PolicyT::label_t> &heap,
+                 NodeLabels<PolicyT> &labels, const NodePotentialsT &potentials,
+                 const PolicyT &policy) {
+    heap.clear();
+    labels.clear();
+
+    heap.push(start, {0, typename PolicyT::cost_t{}, INVALID_ID, INVALID_ID});
+
+    while (!heap.empty()) {
+        if (PolicyT::terminate(heap, labels, target) || Deadline::get().expired()) {
+            break;
+        }
+        detail::mc_label_heap_step(heap, labels, potentials, graph, target, policy);
+    }
+
+    const auto &target_labels = labels[target];
+    auto solutions = lower_envelop(
+        std::vector<typename PolicyT::label_t>(target_labels.begin(), target_labels.end()));
+    return solutions;
+}
+
+template <typename PolicyT, typename GraphT>
+auto mc_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
+                 const GraphT &graph, LabelHeap<typename PolicyT::label_t> &heap,
+                 NodeLabels<PolicyT> &labels, const PolicyT &policy) {
+    return mc_dijkstra(start, target, graph, heap, labels,
+                       ZeroNodePotentials<typename PolicyT::graph_t>{}, policy);
+}
 } // namespace charge::common
 
 #endif
@@ -64,10 +64,10 @@ std::string memory_statistics(
     std::size_t settled_functions_delta_capacity = 0;
     if
         constexpr(is_delta_label<label_t>::value) {
-            for (const auto &settled : labels.settled_labels) {
-                for (const auto &label : settled) {
-                    settled_functions_delta_size += label.delta.size() * sizeof(double) * 2;
-                    settled_functions_delta_capacity += label.delta.capacity() * sizeof(double) * 2;
+            for (const auto &deltas : labels.settled_deltas) {
+                for (const auto &delta : deltas) {
+                    settled_functions_delta_size += delta.size() * sizeof(double) * 2;
+                    settled_functions_delta_capacity += delta.capacity() * sizeof(double) * 2;
                 }
             }
         }
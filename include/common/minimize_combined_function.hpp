@@ -11,6 +11,7 @@
 #include "common/shift_function.hpp"
 #include "common/sink_iter.hpp"
 
+#include <memory_resource>
 #include <tuple>
 
 namespace charge::common {
@@ -627,9 +628,15 @@ inline auto combine_minimal(const LimitedHypOrLinFunction &f, const LimitedHypOr
     return solution;
 }
 
+// The delta and the function of the solution are allocated from resource
 inline auto combine_minimal(const PiecewieseDecHypOrLinFunction &f,
-                            const LimitedHypOrLinFunction &g) {
-    PiecewieseSolution solution;
+                            const LimitedHypOrLinFunction &g,
+                            std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+    PiecewieseSolution solution{InterpolatingIncFunction(resource),
+                                PiecewieseDecHypOrLinFunction(resource)};
+    // mostly one segment per segment of f and one for g
+    std::get<0>(solution).reserve(f.size());
+    std::get<1>(solution).reserve(f.size());
     combine_minimal(
         f, g, make_sink_iter([&](auto &&partial_solution) {
             auto & [ pwf_delta, pwf_h ] = solution;
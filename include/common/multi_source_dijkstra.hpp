@@ -0,0 +1,188 @@
+#ifndef CHARGE_COMMON_MULTI_SOURCE_DIJKSTRA_HPP
+#define CHARGE_COMMON_MULTI_SOURCE_DIJKSTRA_HPP
+
+#include "common/constants.hpp"
+#include "common/id_queue.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace charge::common {
+
+// Costs of one node for K searches. The fixed width loops over the lanes are vectorized
+// by the compiler, with K = 8 one node fits into a single AVX2 register.
+template <std::size_t K> struct alignas(sizeof(std::int32_t) * K) CostLanes {
+    std::int32_t costs[K];
+
+    static CostLanes filled(const std::int32_t value) {
+        CostLanes lanes;
+        std::fill(lanes.costs, lanes.costs + K, value);
+        return lanes;
+    }
+};
+
+// Runs up to K one-to-all searches with non-negative weights in one graph traversal.
+// Every node keeps one cost per search, scanning a node relaxes all lanes at once.
+// The queue key of a node is the smallest cost that improved since it was last scanned,
+// so a node might be scanned more than once (label correcting).
+// A lane stops improving costs that are not smaller than the cost of its farthest target,
+// so lanes with close targets don't follow the wavefront of the farthest one.
+template <std::size_t K, typename GraphT, typename QueueT = MinIDQueue>
+class MultiSourceDijkstra {
+  public:
+    using node_id_t = typename GraphT::node_id_t;
+    using weight_t = typename GraphT::weight_t;
+    using lanes_t = CostLanes<K>;
+    static constexpr std::size_t num_lanes = K;
+
+    MultiSourceDijkstra(const GraphT &graph)
+        : graph(graph), queue(graph.num_nodes()),
+          costs(graph.num_nodes(), lanes_t::filled(INF_WEIGHT)),
+          is_reached(graph.num_nodes(), false), is_target(graph.num_nodes(), false) {}
+
+    // Lane i is a search from sources[i] to targets[i]. Stops as soon as the costs of the
+    // targets of every lane are final, then all nodes with a smaller cost in a lane are final
+    // as well. Without targets all costs are final.
+    void run(const std::vector<node_id_t> &sources,
+             const std::vector<std::vector<node_id_t>> &targets) {
+        assert(sources.size() <= K);
+        assert(targets.empty() || targets.size() == sources.size());
+        clear();
+
+        lane_targets = targets;
+        for (const auto &targets_of_lane : lane_targets) {
+            for (const auto target : targets_of_lane)
+                is_target[target] = true;
+        }
+        for (auto lane = 0u; lane < sources.size(); ++lane) {
+            const auto source = sources[lane];
+            reach(source);
+            costs[source].costs[lane] = 0;
+            if (!queue.contains_id(source))
+                queue.push(IDKeyPair{source, 0});
+        }
+        targets_changed = true;
+
+        while (!queue.empty()) {
+            // all further improvements are at least as large as the smallest key
+            if (max_bound() <= queue.peek().key)
+                break;
+
+            const auto node = queue.pop().id;
+            const auto node_costs = costs[node];
+            for (auto edge = graph.begin(node); edge < graph.end(node); ++edge) {
+                relax(node_costs, graph.target(edge), graph.weight(edge));
+            }
+        }
+    }
+
+    weight_t cost(const node_id_t node, const std::size_t lane) const {
+        return costs[node].costs[lane];
+    }
+
+    const lanes_t &lanes(const node_id_t node) const { return costs[node]; }
+
+    // All nodes that were reached by at least one search
+    const std::vector<node_id_t> &reached() const { return reached_nodes; }
+
+  private:
+    void reach(const node_id_t node) {
+        if (!is_reached[node]) {
+            is_reached[node] = true;
+            reached_nodes.push_back(node);
+        }
+    }
+
+    void clear() {
+        for (const auto node : reached_nodes) {
+            costs[node] = lanes_t::filled(INF_WEIGHT);
+            is_reached[node] = false;
+        }
+        reached_nodes.clear();
+        for (const auto &targets_of_lane : lane_targets) {
+            for (const auto target : targets_of_lane)
+                is_target[target] = false;
+        }
+        lane_targets.clear();
+        queue.clear();
+    }
+
+    // Updates the largest target cost of every lane, improvements that are not smaller
+    // can't change the cost of a target
+    weight_t max_bound() {
+        if (targets_changed) {
+            bounds = lanes_t::filled(lane_targets.empty() ? INF_WEIGHT : 0);
+            for (auto lane = 0u; lane < lane_targets.size(); ++lane) {
+                for (const auto target : lane_targets[lane])
+                    bounds.costs[lane] = std::max(bounds.costs[lane], costs[target].costs[lane]);
+            }
+            max_cost = *std::max_element(bounds.costs, bounds.costs + K);
+            targets_changed = false;
+        }
+        return max_cost;
+    }
+
+    void relax(const lanes_t &from, const node_id_t to, const weight_t weight) {
+        auto &to_costs = costs[to];
+
+        std::int32_t key = INF_WEIGHT;
+        for (auto lane = 0u; lane < K; ++lane) {
+            const auto tentative = std::min<std::int32_t>(from.costs[lane] + weight, INF_WEIGHT);
+            const auto improved =
+                tentative < to_costs.costs[lane] && tentative < bounds.costs[lane];
+            key = std::min(key, improved ? tentative : INF_WEIGHT);
+            to_costs.costs[lane] = improved ? tentative : to_costs.costs[lane];
+        }
+
+        if (key == INF_WEIGHT)
+            return;
+
+        reach(to);
+        if (is_target[to]) {
+            targets_changed = true;
+            max_bound();
+        }
+
+        if (!queue.contains_id(to))
+            queue.push(IDKeyPair{to, key});
+        else if (key < queue.get_key(to))
+            queue.decrease_key(IDKeyPair{to, key});
+    }
+
+    const GraphT &graph;
+    QueueT queue;
+    std::vector<lanes_t> costs;
+    std::vector<bool> is_reached;
+    std::vector<bool> is_target;
+    std::vector<node_id_t> reached_nodes;
+    std::vector<std::vector<node_id_t>> lane_targets;
+    lanes_t bounds = lanes_t::filled(INF_WEIGHT);
+    bool targets_changed = true;
+    weight_t max_cost = INF_WEIGHT;
+};
+
+// counts[i].costs[lane] is the number of reached nodes with a cost in lane
+// smaller than thresholds[i].costs[lane]
+template <typename SearchT>
+auto count_smaller(const SearchT &search,
+                   const std::vector<typename SearchT::lanes_t> &thresholds) {
+    using lanes_t = typename SearchT::lanes_t;
+    std::vector<lanes_t> counts(thresholds.size(), lanes_t::filled(0));
+
+    for (const auto node : search.reached()) {
+        const auto &node_costs = search.lanes(node);
+        for (auto index = 0u; index < thresholds.size(); ++index) {
+            for (auto lane = 0u; lane < SearchT::num_lanes; ++lane) {
+                counts[index].costs[lane] +=
+                    node_costs.costs[lane] < thresholds[index].costs[lane];
+            }
+        }
+    }
+
+    return counts;
+}
+} // namespace charge::common
+
+#endif
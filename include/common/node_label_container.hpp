@@ -2,17 +2,22 @@
 #define CHARGE_COMMON_NODE_LABEL_CONTAINER_HPP
 
 #include "common/adapter_iter.hpp"
+#include "common/arena.hpp"
 #include "common/constants.hpp"
 #include "common/function_graph.hpp"
 #include "common/interpolating_function.hpp"
 #include "common/linear_function.hpp"
 #include "common/piecewise_function.hpp"
 #include "common/range.hpp"
+#include "common/skyline.hpp"
 #include "common/statistics.hpp"
 #include "common/tuple_helper.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <memory_resource>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace charge::common {
@@ -148,6 +153,47 @@ struct LabelEntryWithParent<LimitedFunction<FnT, inf_bound, clamp_bound>,
     node_id_t parent_entry;
 };
 
+// Same as LabelEntryWithParent but drops the delta function that maps the time at this label to
+// the time at its parent. Only the few labels on a final path ever need it, so get_path_with_deltas
+// recomputes it by linking the parent cost again instead of keeping it on every label.
+template <typename CostT, typename NodeIDT> struct LabelEntryWithParentOnly;
+
+template <typename FnT>
+struct LabelEntryWithParentOnly<LimitedFunction<FnT, inf_bound, clamp_bound>,
+                                typename FunctionGraph<FnT>::node_id_t> {
+    using GraphT = FunctionGraph<FnT>;
+    using cost_t = PiecewieseFunction<FnT, inf_bound, clamp_bound, monotone_decreasing>;
+    using delta_t = InterpolatingFunction<inf_bound, clamp_bound, monotone_increasing>;
+    using node_id_t = typename GraphT::node_id_t;
+
+    LabelEntryWithParentOnly(key_t key, cost_t cost_, const delta_t &, const node_id_t parent,
+                             const node_id_t parent_entry)
+        : key(key), cost(std::move(cost_)), parent(parent), parent_entry(parent_entry) {}
+    LabelEntryWithParentOnly() noexcept = default;
+    LabelEntryWithParentOnly(const LabelEntryWithParentOnly &) noexcept = default;
+    LabelEntryWithParentOnly(LabelEntryWithParentOnly &&) noexcept = default;
+    LabelEntryWithParentOnly &operator=(const LabelEntryWithParentOnly &) noexcept = default;
+    LabelEntryWithParentOnly &operator=(LabelEntryWithParentOnly &&) noexcept = default;
+
+    inline bool operator<(const LabelEntryWithParentOnly &other) const {
+        return cost.min_x() < other.cost.min_x();
+    }
+
+    inline bool operator==(const LabelEntryWithParentOnly &other) const {
+        return (cost.min_x() == other.cost.min_x()) &&
+               std::tie(parent, parent_entry) == std::tie(other.parent, other.parent_entry);
+    }
+
+    inline bool operator!=(const LabelEntryWithParentOnly &other) const {
+        return !operator==(other);
+    }
+
+    key_t key;
+    cost_t cost;
+    node_id_t parent;
+    node_id_t parent_entry;
+};
+
 template <typename T, typename = int> struct is_parent_label : std::false_type {};
 
 template <typename T> struct is_parent_label<T, decltype((void)T::parent, 0)> : std::true_type {};
@@ -156,6 +202,25 @@ template <typename T, typename = int> struct is_delta_label : std::false_type {}
 
 template <typename T> struct is_delta_label<T, decltype((void)T::delta, 0)> : std::true_type {};
 
+// Type of the labels in the settled lists of NodeLabels. Labels with a delta are settled
+// without it, the deltas are kept apart since only backtracking a path reads them.
+template <typename LabelT> struct settled_label { using type = LabelT; };
+
+template <typename FnT>
+struct settled_label<LabelEntryWithParent<LimitedFunction<FnT, inf_bound, clamp_bound>,
+                                          typename FunctionGraph<FnT>::node_id_t>> {
+    using type = LabelEntryWithParentOnly<LimitedFunction<FnT, inf_bound, clamp_bound>,
+                                          typename FunctionGraph<FnT>::node_id_t>;
+};
+
+namespace detail {
+template <typename T, typename = int> struct label_delta { using type = std::nullptr_t; };
+
+template <typename T> struct label_delta<T, decltype((void)T::delta, 0)> {
+    using type = typename T::delta_t;
+};
+} // namespace detail
+
 // Label container for every every node.
 //
 // Labels for nodes are split into two lists:
@@ -172,32 +237,111 @@ template <typename T> struct is_delta_label<T, decltype((void)T::delta, 0)> : st
 //
 // To ensure 1. we use a sorting in the heap that only places undominated labels as min.
 // To ensure 2. we need do dominance checks every time we updated the minimum (push or pop)
+//
+// The label lists of all nodes are allocated from one arena that is reset by clear(),
+// so growing a list during a query never calls into the global allocator once the arena
+// is warm, and the buffers a list leaves behind when it grows are reused by other lists.
+// Searches can allocate the costs of new labels from the same arena through resource(), FP
+// links the functions and deltas of its labels there.
+//
+// Only nodes that got a label since the last clear() own a pair of label lists. The lists are
+// kept in the order the nodes were touched and a node finds its lists through a dense slot
+// index, which is the only array that is sized by the number of nodes (4 bytes per node).
+//
+// Settled labels are split into a hot and a cold part. The hot settled lists keep what the
+// dominance checks and the searches read: key, cost and parent ids. Labels with a delta (FP and
+// FPC with parents) are settled as LabelEntryWithParentOnly and their deltas go to a cold list
+// of the node, which is only read by label() when a path is backtracked. This keeps the large
+// delta functions out of the lists that the dominance checks scan.
+//
+// If the policy sets sorted_skyline (two criteria) the settled costs are also indexed as a
+// Pareto skyline sorted by the first criterion that keeps each criterion in its own array.
+// Costs dominated by a newer settled cost are dropped from it and the policy checks dominance
+// with SkylineRange::any_within.
 template <typename PolicyT> class NodeLabels {
   public:
     using label_t = typename PolicyT::label_t;
+    using settled_label_t = typename settled_label<label_t>::type;
     using cost_t = typename label_t::cost_t;
     using node_id_t = typename label_t::node_id_t;
+    using labels_t = std::pmr::vector<label_t>;
+    using settled_labels_t = std::pmr::vector<settled_label_t>;
+
+    static constexpr bool has_skyline =
+        std::is_trivially_destructible_v<cost_t> && has_sorted_skyline<PolicyT>::value;
+    static constexpr bool has_cold_deltas = is_delta_label<label_t>::value;
+
+    using costs_t = std::conditional_t<has_skyline, Skyline<cost_t>, std::nullptr_t>;
+    using deltas_t = std::pmr::vector<typename detail::label_delta<label_t>::type>;
 
     NodeLabels(const std::size_t num_nodes)
-        : unsettled_labels(num_nodes, std::vector<label_t>{}),
-          settled_labels(num_nodes, std::vector<label_t>{}) {}
+        : arena(std::make_unique<Arena>()), slots(num_nodes, INVALID_SLOT) {}
+
+    // The copy gets its own arena
+    NodeLabels(const NodeLabels &other)
+        : arena(std::make_unique<Arena>()), slots(other.slots), touched(other.touched) {
+        settled_labels.reserve(touched.size());
+        unsettled_labels.reserve(touched.size());
+        for (std::size_t slot = 0; slot < touched.size(); ++slot) {
+            settled_labels.emplace_back(other.settled_labels[slot].begin(),
+                                        other.settled_labels[slot].end(), arena.get());
+            unsettled_labels.emplace_back(other.unsettled_labels[slot].begin(),
+                                          other.unsettled_labels[slot].end(), arena.get());
+        }
+        // clang-format off
+        if constexpr(has_skyline) {
+            settled_costs.reserve(other.settled_costs.size());
+            for (const auto &costs : other.settled_costs) {
+                settled_costs.emplace_back(costs, arena.get());
+            }
+        }
+        // clang-format on
+        settled_deltas.reserve(other.settled_deltas.size());
+        for (const auto &deltas : other.settled_deltas) {
+            settled_deltas.emplace_back(deltas.begin(), deltas.end(), arena.get());
+        }
+    }
+    NodeLabels(NodeLabels &&) = default;
+    NodeLabels &operator=(NodeLabels &&other) {
+        // our lists still point into our arena, drop them before the arena
+        settled_labels = std::move(other.settled_labels);
+        unsettled_labels = std::move(other.unsettled_labels);
+        settled_costs = std::move(other.settled_costs);
+        settled_deltas = std::move(other.settled_deltas);
+        arena = std::move(other.arena);
+        slots = std::move(other.slots);
+        touched = std::move(other.touched);
+        return *this;
+    }
 
+    // Only resets the nodes that got a label since the last clear, the arena is released in O(1)
     void clear() {
-        for (auto &labels : unsettled_labels) {
-            labels.clear();
-        }
-        for (auto &labels : settled_labels) {
-            labels.clear();
+        for (const auto node : touched) {
+            slots[node] = INVALID_SLOT;
         }
+        touched.clear();
+        settled_labels.clear();
+        unsettled_labels.clear();
+        settled_costs.clear();
+        settled_deltas.clear();
+        arena->reset();
     }
 
+    // Memory that stays valid until the next clear(), copies of labels do not use it
+    std::pmr::memory_resource *resource() const { return arena.get(); }
+
+    // All nodes that got a label since the last clear in the order of their first label
+    const std::vector<node_id_t> &touched_nodes() const { return touched; }
+
+    // Returns the memory of the arena and of the list slots to the system
     void shrink_to_fit() {
-        for (auto &labels : unsettled_labels) {
-            labels.shrink_to_fit();
-        }
-        for (auto &labels : settled_labels) {
-            labels.shrink_to_fit();
-        }
+        clear();
+        settled_labels.shrink_to_fit();
+        unsettled_labels.shrink_to_fit();
+        settled_costs.shrink_to_fit();
+        settled_deltas.shrink_to_fit();
+        touched.shrink_to_fit();
+        arena->release();
     }
 
     template <typename NodePotentialsT>
@@ -205,7 +349,7 @@ template <typename PolicyT> class NodeLabels {
               const NodePotentialsT &potentials) {
         Statistics::get().count(StatisticsEvent::LABEL_PUSH);
 
-        auto &unsettled = unsettled_labels[node];
+        auto &unsettled = unsettled_labels[touch(node)];
 
         bool modified_min = true;
         if (unsettled.size() > 0) {
@@ -237,8 +381,12 @@ template <typename PolicyT> class NodeLabels {
         if constexpr(std::is_same_v<typename label_t::cost_t, std::tuple<std::int32_t, std::int32_t>>) {
             Statistics::get().count(StatisticsEvent::LABEL_CLEANUP);
 
-            unsettled_labels[node] = lower_envelop(std::move(unsettled_labels[node]));
-            std::make_heap(unsettled_labels[node].begin(), unsettled_labels[node].end(),
+            auto &unsettled = unsettled_labels[touch(node)];
+            auto envelop = lower_envelop(std::vector<label_t>(
+                std::make_move_iterator(unsettled.begin()), std::make_move_iterator(unsettled.end())));
+            unsettled.assign(std::make_move_iterator(envelop.begin()),
+                             std::make_move_iterator(envelop.end()));
+            std::make_heap(unsettled.begin(), unsettled.end(),
                            [&](const auto &lhs, const auto &rhs) {
                                return rhs.key <
                                       lhs.key;
@@ -249,13 +397,7 @@ template <typename PolicyT> class NodeLabels {
 
     bool dominated(const node_id_t node, const cost_t &tentative_cost,
                    const PolicyT &policy) const {
-        const auto label_to_cost = [](const label_t &label) -> const cost_t & {
-            return label.cost;
-        };
-
-        auto labels_begin = make_adapter_iter(settled_labels[node].begin(), label_to_cost);
-        auto labels_end = make_adapter_iter(settled_labels[node].end(), label_to_cost);
-        auto range = make_range(labels_begin, labels_end);
+        const auto range = settled_cost_range(node);
 
         return policy.dominates(range, tentative_cost);
     }
@@ -264,13 +406,7 @@ template <typename PolicyT> class NodeLabels {
     std::tuple<bool, bool> clip_dominated(const node_id_t node, label_t &label,
                                           const PolicyT &policy,
                                           const NodePotentialsT &potentials) const {
-        const auto label_to_cost = [](const label_t &label) -> const cost_t & {
-            return label.cost;
-        };
-
-        auto labels_begin = make_adapter_iter(settled_labels[node].begin(), label_to_cost);
-        auto labels_end = make_adapter_iter(settled_labels[node].end(), label_to_cost);
-        auto range = make_range(labels_begin, labels_end);
+        const auto range = settled_cost_range(node);
 
         auto[dominated, modified] = policy.clip_dominated(range, label.cost);
         if (modified && !dominated) {
@@ -280,47 +416,79 @@ template <typename PolicyT> class NodeLabels {
     }
 
     auto &min(const node_id_t node) const {
-        assert(!unsettled_labels[node].empty());
-        return unsettled_labels[node].front();
+        assert(!empty(node));
+        return unsettled_labels[slots[node]].front();
     }
 
     auto &min(const node_id_t node) {
-        assert(!unsettled_labels[node].empty());
-        return unsettled_labels[node].front();
+        assert(!empty(node));
+        return unsettled_labels[slots[node]].front();
     }
 
-    auto empty(const node_id_t node) const { return unsettled_labels[node].empty(); }
+    auto empty(const node_id_t node) const {
+        return slots[node] == INVALID_SLOT || unsettled_labels[slots[node]].empty();
+    }
 
-    auto size(const node_id_t node) const { return unsettled_labels[node].size(); }
+    auto size(const node_id_t node) const {
+        return slots[node] == INVALID_SLOT ? 0 : unsettled_labels[slots[node]].size();
+    }
 
     template <typename NodePotentialsT>
     auto pop(const node_id_t node, const PolicyT &policy, const NodePotentialsT &potentials) {
         Statistics::get().count(StatisticsEvent::LABEL_POP);
-        auto &unsettled = unsettled_labels[node];
-        auto &settled = settled_labels[node];
+        assert(!empty(node));
+        auto &unsettled = unsettled_labels[slots[node]];
+        auto &settled = settled_labels[slots[node]];
 
-        assert(!unsettled.empty());
         std::pop_heap(unsettled.begin(), unsettled.end(),
                       [&](const auto &lhs, const auto &rhs) { return rhs.key < lhs.key; });
         auto top_entry_id = settled.size();
         // assert(!dominated(node, unsettled.back().cost));
-        settled.push_back(std::move(unsettled.back()));
+        append_settled(slots[node], std::move(unsettled.back()));
         unsettled.pop_back();
 
         ensure_undominated_minium(node, policy, potentials);
 
-        return std::tuple<const label_t &, std::size_t>{settled.back(), top_entry_id};
+        return std::tuple<const settled_label_t &, std::size_t>{settled.back(), top_entry_id};
+    }
+
+    // Settles a label that never was in the unsettled labels of the node. Used by searches that
+    // keep the unsettled labels in their own queue, the caller ensures the label is undominated.
+    auto settle(const node_id_t node, label_t label) {
+        Statistics::get().count(StatisticsEvent::LABEL_POP);
+        const auto slot = touch(node);
+        const auto top_entry_id = settled_labels[slot].size();
+        append_settled(slot, std::move(label));
+
+        return std::tuple<const settled_label_t &, std::size_t>{settled_labels[slot].back(),
+                                                                top_entry_id};
     }
 
     // Returns all _settled_ labels of the given node
-    const std::vector<label_t> &operator[](const node_id_t node) const {
-        return settled_labels[node];
+    const settled_labels_t &operator[](const node_id_t node) const {
+        return slots[node] == INVALID_SLOT ? no_labels : settled_labels[slots[node]];
+    }
+
+    // The settled label with the given entry id including its cold delta
+    label_t label(const node_id_t node, const std::size_t entry_id) const {
+        assert(slots[node] != INVALID_SLOT);
+        const auto &settled = settled_labels[slots[node]][entry_id];
+        // clang-format off
+        if constexpr(has_cold_deltas) {
+            return label_t{settled.key, settled.cost, settled_deltas[slots[node]][entry_id],
+                           settled.parent, settled.parent_entry};
+        } else {
+            return settled;
+        }
+        // clang-format on
     }
 
     template <typename NodePotentialsT>
     void ensure_undominated_minium(const node_id_t node, const PolicyT &policy,
                                    const NodePotentialsT &potentials) {
-        auto &unsettled = unsettled_labels[node];
+        if (slots[node] == INVALID_SLOT)
+            return;
+        auto &unsettled = unsettled_labels[slots[node]];
         bool modified_min = true;
         while (!unsettled.empty() && modified_min) {
             auto &current_min = min(node);
@@ -366,8 +534,77 @@ template <typename PolicyT> class NodeLabels {
         // assert(unsettled.empty() || !dominated(node, min(node).cost));
     }
 
-    std::vector<std::vector<label_t>> settled_labels;
-    std::vector<std::vector<label_t>> unsettled_labels;
+  private:
+    static constexpr std::uint32_t INVALID_SLOT = INVALID_ID;
+
+    // Returns the slot of the node, the node gets empty label lists on first use
+    std::uint32_t touch(const node_id_t node) {
+        if (slots[node] == INVALID_SLOT) {
+            slots[node] = touched.size();
+            touched.push_back(node);
+            settled_labels.emplace_back(arena.get());
+            unsettled_labels.emplace_back(arena.get());
+            // clang-format off
+            if constexpr(has_skyline) {
+                settled_costs.emplace_back(arena.get());
+            }
+            if constexpr(has_cold_deltas) {
+                settled_deltas.emplace_back(arena.get());
+            }
+            // clang-format on
+        }
+        return slots[node];
+    }
+
+    void append_settled(const std::uint32_t slot, label_t label) {
+        // clang-format off
+        if constexpr(has_cold_deltas) {
+            settled_deltas[slot].push_back(std::move(label.delta));
+            settled_labels[slot].push_back(settled_label_t{
+                label.key, std::move(label.cost), {}, label.parent, label.parent_entry});
+        } else {
+            settled_labels[slot].push_back(std::move(label));
+        }
+        if constexpr(has_skyline) {
+            settled_costs[slot].insert(settled_labels[slot].back().cost);
+        }
+        // clang-format on
+    }
+
+    // Costs of all settled labels of the node, taken from the skyline if there is one
+    auto settled_cost_range(const node_id_t node) const {
+        // clang-format off
+        if constexpr(has_skyline) {
+            if (slots[node] == INVALID_SLOT)
+                return SkylineRange<cost_t>(nullptr, nullptr, 0);
+            return settled_costs[slots[node]].range();
+        } else {
+            const auto label_to_cost = [](const settled_label_t &label) -> const cost_t & {
+                return label.cost;
+            };
+            const auto &settled = (*this)[node];
+            return make_range(make_adapter_iter(settled.begin(), label_to_cost),
+                              make_adapter_iter(settled.end(), label_to_cost));
+        }
+        // clang-format on
+    }
+
+    // needs to outlive the label lists
+    std::unique_ptr<Arena> arena;
+
+  public:
+    // indexed by slot, not by node
+    std::vector<settled_labels_t> settled_labels;
+    std::vector<labels_t> unsettled_labels;
+    // only used if has_skyline
+    std::vector<costs_t> settled_costs;
+    // cold deltas by entry id, only used if has_cold_deltas
+    std::vector<deltas_t> settled_deltas;
+
+  private:
+    const settled_labels_t no_labels;
+    std::vector<std::uint32_t> slots;
+    std::vector<node_id_t> touched;
 };
 } // namespace charge::common
 
@@ -44,7 +44,7 @@ template <typename GraphT> class LandmarkNodePotentials {
         return to_upper_fixed(f_uv.min_x) - cost_to_target[u] + cost_to_target[v] >= 0;
     }
 
-    void recompute(MinIDQueue& queue, const node_id_t target) {
+    template <typename QueueT> void recompute(QueueT &queue, const node_id_t target) {
         dijkstra_to_all(target, reverse_graph, queue, cost_to_target);
     }
 
@@ -53,7 +53,7 @@ template <typename GraphT> class LandmarkNodePotentials {
     CostVector<GraphT> cost_to_target;
 };
 
-template <typename GraphT> class LazyLandmarkNodePotentials {
+template <typename GraphT, typename QueueT = MinIDQueue> class LazyLandmarkNodePotentials {
   public:
     using node_id_t = typename GraphT::node_id_t;
     using key_t = std::int32_t;
@@ -84,8 +84,8 @@ template <typename GraphT> class LazyLandmarkNodePotentials {
 
   private:
     const GraphT &reverse_graph;
-    mutable MinIDQueue queue;
-    mutable std::vector<bool> settled;
+    mutable QueueT queue;
+    mutable SettledVector settled;
     mutable CostVector<GraphT> cost_to_target;
 };
 }
@@ -0,0 +1,99 @@
+#ifndef CHARGE_COMMON_PACKED_GRAPH_HPP
+#define CHARGE_COMMON_PACKED_GRAPH_HPP
+
+#include "common/aligned_allocator.hpp"
+#include "common/constants.hpp"
+#include "common/edge.hpp"
+#include "common/irange.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace charge::common {
+
+// Same interface as WeightedGraph but the target and the weight of an edge are stored next to
+// each other (array of structs) instead of in two arrays. Relaxing an edge then touches one
+// record instead of two arrays. With Alignment = CACHE_LINE_SIZE every record of a fat weight
+// like a tradeoff function starts a cache line, so no record straddles two lines.
+template <typename WeightT, std::size_t Alignment = alignof(WeightT)>
+class PackedWeightedGraph {
+  public:
+    using node_id_t = AdjGraph::node_id_t;
+    using edge_id_t = AdjGraph::edge_id_t;
+    using weight_t = WeightT;
+    using edge_t = Edge<node_id_t, weight_t>;
+    using edge_range_t = AdjGraph::edge_range_t;
+    using node_range_t = AdjGraph::node_range_t;
+
+    struct alignas(std::max(Alignment, alignof(weight_t))) EdgeRecord {
+        node_id_t target;
+        weight_t weight;
+    };
+
+    PackedWeightedGraph() {}
+
+    explicit PackedWeightedGraph(const WeightedGraph<weight_t> &graph) {
+        first_edges.reserve(graph.num_nodes() + 1);
+        records.reserve(graph.num_edges());
+        for (const auto node : graph.nodes()) {
+            first_edges.push_back(records.size());
+            for (auto edge = graph.begin(node); edge < graph.end(node); ++edge) {
+                records.push_back(EdgeRecord{graph.target(edge), graph.weight(edge)});
+            }
+        }
+        first_edges.push_back(records.size());
+    }
+
+    template <typename EdgeT>
+    PackedWeightedGraph(std::size_t num_nodes_, const std::vector<EdgeT> &sorted_edges)
+        : PackedWeightedGraph(WeightedGraph<weight_t>(num_nodes_, sorted_edges)) {}
+
+    std::size_t num_nodes() const { return first_edges.size() - 1; }
+
+    std::size_t num_edges() const { return records.size(); }
+
+    node_range_t nodes() const { return irange<node_id_t>(0, num_nodes()); }
+
+    edge_range_t edges(node_id_t node) const { return irange<edge_id_t>(begin(node), end(node)); }
+
+    edge_id_t begin(node_id_t node) const { return first_edges[node]; }
+
+    edge_id_t end(node_id_t node) const { return first_edges[node + 1]; }
+
+    node_id_t target(edge_id_t edge) const { return records[edge].target; }
+
+    const weight_t &weight(edge_id_t edge) const { return records[edge].weight; }
+    weight_t &weight(edge_id_t edge) { return records[edge].weight; }
+
+    edge_id_t edge(node_id_t start_node, node_id_t target_node) const {
+        for (auto edge = begin(start_node); edge < end(start_node); ++edge) {
+            if (target(edge) == target_node)
+                return edge;
+        }
+
+        return INVALID_ID;
+    }
+
+    std::vector<edge_t> edges() const {
+        std::vector<edge_t> edges;
+        edges.reserve(num_edges());
+
+        for (node_id_t node = 0; node < num_nodes(); ++node) {
+            for (auto edge = begin(node); edge < end(node); ++edge) {
+                edges.emplace_back(node, target(edge), weight(edge));
+            }
+        }
+
+        return edges;
+    }
+
+  private:
+    std::vector<edge_id_t> first_edges;
+    std::vector<EdgeRecord, AlignedAllocator<EdgeRecord, alignof(EdgeRecord)>> records;
+};
+} // namespace charge::common
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef CHARGE_COMMON_PARALLEL_DIJKSTRA_HPP
+#define CHARGE_COMMON_PARALLEL_DIJKSTRA_HPP
+
+#include "common/constants.hpp"
+#include "common/dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/worker_pool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace charge::common {
+
+// Tentative costs of one search direction that are read by the other direction.
+// Only the owning direction writes and clears them.
+template <typename GraphT> class SharedCostVector {
+  public:
+    using node_id_t = typename GraphT::node_id_t;
+    using weight_t = typename GraphT::weight_t;
+
+    SharedCostVector(const std::size_t num_nodes) : costs(num_nodes) {
+        for (auto &cost : costs)
+            cost.store(INF_WEIGHT, std::memory_order_relaxed);
+    }
+
+    // Copies only the size, the costs are always cleared between queries
+    SharedCostVector(const SharedCostVector &other) : SharedCostVector(other.costs.size()) {}
+    SharedCostVector &operator=(const SharedCostVector &) = delete;
+
+    weight_t load(const node_id_t node) const { return costs[node].load(); }
+
+    void store(const node_id_t node, const weight_t cost) {
+        if (costs[node].load(std::memory_order_relaxed) == INF_WEIGHT)
+            touched.push_back(node);
+        costs[node].store(cost);
+    }
+
+    void clear() {
+        for (const auto node : touched)
+            costs[node].store(INF_WEIGHT, std::memory_order_relaxed);
+        touched.clear();
+    }
+
+  private:
+    std::vector<std::atomic<weight_t>> costs;
+    std::vector<node_id_t> touched;
+};
+
+// State that is shared between the forward and the reverse thread.
+// The reverse thread is started once and reused by every query.
+template <typename GraphT> struct ParallelDijkstraState {
+    using weight_t = typename GraphT::weight_t;
+
+    ParallelDijkstraState(const std::size_t num_nodes)
+        : forward_costs(num_nodes), reverse_costs(num_nodes), workers(2) {}
+
+    ParallelDijkstraState(const ParallelDijkstraState &other)
+        : forward_costs(other.forward_costs), reverse_costs(other.reverse_costs), workers(2) {}
+    ParallelDijkstraState &operator=(const ParallelDijkstraState &) = delete;
+
+    SharedCostVector<GraphT> forward_costs;
+    SharedCostVector<GraphT> reverse_costs;
+    // upper 32 bit are the cost, lower 32 bit the middle node
+    std::atomic<std::uint64_t> best;
+    // smallest key in the queue of each direction, INF_WEIGHT once a queue ran empty
+    std::atomic<weight_t> forward_min_key;
+    std::atomic<weight_t> reverse_min_key;
+    WorkerPool workers;
+};
+
+namespace detail {
+inline std::uint64_t pack_best(const std::int32_t cost, const std::uint32_t middle) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cost)) << 32) | middle;
+}
+
+inline std::int32_t unpack_best_cost(const std::uint64_t best) {
+    return static_cast<std::int32_t>(best >> 32);
+}
+
+inline std::uint32_t unpack_best_middle(const std::uint64_t best) {
+    return static_cast<std::uint32_t>(best);
+}
+
+inline void update_best(std::atomic<std::uint64_t> &best, const std::int32_t cost,
+                        const std::uint32_t middle) {
+    const auto packed = pack_best(cost, middle);
+    auto current = best.load();
+    while (packed < current && !best.compare_exchange_weak(current, packed)) {
+    }
+}
+
+// One direction of parallel_dijkstra. Paths are checked when a node is relaxed, which
+// together with sequentially consistent loads and stores of the shared costs guarantees
+// that every node labeled by both directions is seen by at least one of them.
+template <typename GraphT, typename QueueT>
+void parallel_dijkstra_direction(const GraphT &graph, QueueT &queue, CostVector<GraphT> &costs,
+                                 ParentVector<GraphT> &parents,
+                                 SharedCostVector<GraphT> &shared_costs,
+                                 const SharedCostVector<GraphT> &other_costs,
+                                 std::atomic<typename GraphT::weight_t> &min_key,
+                                 const std::atomic<typename GraphT::weight_t> &other_min_key,
+                                 std::atomic<std::uint64_t> &best) {
+    while (!queue.empty()) {
+        // same criterion as terminate_sum_min on the published keys of the other direction,
+        // stale keys are smaller and only delay the termination
+        const auto other_key = other_min_key.load();
+        if (other_key == INF_WEIGHT ||
+            queue.peek().key + other_key >= unpack_best_cost(best.load()))
+            break;
+
+        auto top = queue.pop();
+        for (auto edge = graph.begin(top.id); edge < graph.end(top.id); ++edge) {
+            Statistics::get().count(StatisticsEvent::DIJKSTRA_RELAX);
+            auto target = graph.target(edge);
+            auto tentative_cost = top.key + graph.weight(edge);
+
+            if (tentative_cost < costs.peek(target)) {
+                if (queue.contains_id(target)) {
+                    queue.decrease_key(IDKeyPair{target, tentative_cost});
+                } else {
+                    queue.push(IDKeyPair{target, tentative_cost});
+                }
+
+                costs[target] = tentative_cost;
+                parents[target] = top.id;
+                shared_costs.store(target, tentative_cost);
+
+                const auto other_cost = other_costs.load(target);
+                if (other_cost != INF_WEIGHT)
+                    update_best(best, tentative_cost + other_cost, target);
+            }
+        }
+
+        // only publish the new key after all paths found by this step are in best
+        min_key.store(queue.empty() ? INF_WEIGHT : queue.peek().key);
+    }
+    // an exhausted direction knows the final cost, the other one can stop as well
+    if (queue.empty())
+        min_key.store(INF_WEIGHT);
+}
+} // namespace detail
+
+// Bidirectional Dijkstra that runs the reverse search on a second thread.
+// Both directions exchange their tentative costs and smallest queue keys through the
+// shared state and stop with the terminate_sum_min criterion.
+// Requires non-negative weights. Returns the cost and sets middle like dijkstra(...).
+template <typename GraphT, typename QueueT>
+auto parallel_dijkstra(typename GraphT::node_id_t start, typename GraphT::node_id_t target,
+                       const GraphT &forward_graph, const GraphT &reverse_graph,
+                       QueueT &forward_queue, QueueT &reverse_queue,
+                       CostVector<GraphT> &forward_costs, CostVector<GraphT> &reverse_costs,
+                       ParentVector<GraphT> &forward_parents,
+                       ParentVector<GraphT> &reverse_parents, typename GraphT::node_id_t &middle,
+                       ParallelDijkstraState<GraphT> &state) {
+    forward_costs.clear();
+    reverse_costs.clear();
+    forward_parents.clear();
+    reverse_parents.clear();
+    forward_queue.clear();
+    reverse_queue.clear();
+    state.forward_costs.clear();
+    state.reverse_costs.clear();
+
+    forward_queue.push(IDKeyPair{start, 0});
+    reverse_queue.push(IDKeyPair{target, 0});
+    forward_costs[start] = 0;
+    reverse_costs[target] = 0;
+    state.forward_costs.store(start, 0);
+    state.reverse_costs.store(target, 0);
+    state.forward_min_key.store(0);
+    state.reverse_min_key.store(0);
+    state.best.store(start == target ? detail::pack_best(0, start)
+                                     : detail::pack_best(INF_WEIGHT, INVALID_ID));
+
+    // thread 0 is the calling thread
+    state.workers.run([&](const std::size_t thread_index) {
+        if (thread_index == 0) {
+            detail::parallel_dijkstra_direction(forward_graph, forward_queue, forward_costs,
+                                                forward_parents, state.forward_costs,
+                                                state.reverse_costs, state.forward_min_key,
+                                                state.reverse_min_key, state.best);
+        } else {
+            detail::parallel_dijkstra_direction(reverse_graph, reverse_queue, reverse_costs,
+                                                reverse_parents, state.reverse_costs,
+                                                state.forward_costs, state.reverse_min_key,
+                                                state.forward_min_key, state.best);
+        }
+    });
+
+    const auto best = state.best.load();
+    const auto best_cost = detail::unpack_best_cost(best);
+    middle = best_cost == INF_WEIGHT ? INVALID_ID : detail::unpack_best_middle(best);
+    return best_cost;
+}
+} // namespace charge::common
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef CHARGE_COMMON_PARALLEL_MC_DIJKSTRA_HPP
+#define CHARGE_COMMON_PARALLEL_MC_DIJKSTRA_HPP
+
+#include "common/deadline.hpp"
+#include "common/irange.hpp"
+#include "common/lower_envelop.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/node_label_container.hpp"
+#include "common/worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace charge::common {
+
+// Parallel multi-criteria search with a Pareto queue (in the spirit of Sanders and Mandow).
+// Every round takes the labels of the queue that are not dominated by any other label in the
+// queue, judged by key and second criterion. These labels can not be dominated by labels that
+// are found later, so they are settled all at once and relaxed in parallel.
+//
+// Settling and the queue are sequential (thread 0), only the relaxation runs in parallel. All
+// labels of a node are relaxed by the same thread and the settled labels are not modified while
+// the threads relax, so the dominance checks against them need no locking. The threads are
+// started once and reused by every search.
+//
+// That a settled label is never dominated by a later one only holds if the second criterion
+// does not decrease along a path. Recuperation and charging break this: a label that is found
+// later can dominate a label that is already settled. Such a label stays settled and is relaxed
+// anyway, the dominance checks still compare against all settled labels of the node and the
+// target labels are filtered with lower_envelop, so the results are the same, the search only
+// does some unnecessary work.
+//
+// Can be passed instead of a queue to mc_dijkstra(start, target, graph, queue, labels, ...).
+template <typename PolicyT> class ParetoQueueSearch {
+  public:
+    using label_t = typename PolicyT::label_t;
+    using node_id_t = typename PolicyT::node_id_t;
+
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 1024;
+
+    ParetoQueueSearch(
+        const std::size_t num_nodes,
+        const std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency()),
+        const std::size_t batch_size = DEFAULT_BATCH_SIZE)
+        : num_threads(std::max<std::size_t>(1, num_threads)),
+          batch_size(std::max<std::size_t>(1, batch_size)), heap(num_nodes),
+          thread_data(this->num_threads), workers(this->num_threads), barrier(this->num_threads),
+          done(false) {}
+
+    // Copies only the configuration, the search state is always empty between searches
+    ParetoQueueSearch(const ParetoQueueSearch &other)
+        : ParetoQueueSearch(0, other.num_threads, other.batch_size) {}
+    ParetoQueueSearch &operator=(const ParetoQueueSearch &) = delete;
+
+    std::size_t threads() const { return num_threads; }
+
+    template <typename NodePotentialsT, typename GraphT>
+    void run(const node_id_t start, const node_id_t target, const GraphT &graph,
+             NodeLabels<PolicyT> &labels, const NodePotentialsT &potentials,
+             const PolicyT &policy) {
+        heap.clear();
+        labels.clear();
+        done = false;
+
+        heap.push(start, {0, typename PolicyT::cost_t{}, INVALID_ID, INVALID_ID});
+
+        const auto work = [&](const std::size_t thread_index) {
+            auto &local = thread_data[thread_index];
+            const auto insert = [&](const node_id_t node, label_t label) {
+                Statistics::get().count(StatisticsEvent::LABEL_PUSH);
+                if (!labels.dominated(node, label.cost, policy)) {
+                    local.candidates.push_back({node, std::move(label)});
+                }
+            };
+
+            while (true) {
+                if (thread_index == 0)
+                    next_round(target, labels, potentials, policy);
+                barrier.wait();
+
+                if (done)
+                    break;
+
+                for (auto group = next_group.fetch_add(1, std::memory_order_relaxed);
+                     group + 1 < group_begins.size();
+                     group = next_group.fetch_add(1, std::memory_order_relaxed)) {
+                    for (const auto index :
+                         irange<std::size_t>(group_begins[group], group_begins[group + 1])) {
+                        const auto[node, entry_id] = batch[index];
+                        detail::mc_relax_label(node, labels[node][entry_id], entry_id, labels,
+                                               potentials, graph, target, policy, insert);
+                    }
+                }
+                barrier.wait();
+            }
+        };
+
+        workers.run(work);
+
+        for (auto &local : thread_data)
+            local.candidates.clear();
+    }
+
+  private:
+    using entry_t = typename LabelHeap<label_t>::Entry;
+
+    // The settled lists can still grow during a round, so a label is only referenced by index
+    struct SettledLabel {
+        node_id_t node;
+        std::size_t entry_id;
+    };
+
+    struct ThreadData {
+        std::vector<entry_t> candidates;
+    };
+
+    // Only called by thread 0 while the other threads wait
+    template <typename NodePotentialsT>
+    void next_round(const node_id_t target, NodeLabels<PolicyT> &labels,
+                    const NodePotentialsT &potentials, const PolicyT &policy) {
+        for (auto &local : thread_data) {
+            for (auto &candidate : local.candidates)
+                heap.push(candidate.node, std::move(candidate.label));
+            local.candidates.clear();
+        }
+
+        batch.clear();
+        group_begins.clear();
+        next_group.store(0, std::memory_order_relaxed);
+
+        while (batch.empty()) {
+            if (heap.empty() || PolicyT::terminate(heap, labels, target) ||
+                Deadline::get().expired()) {
+                done = true;
+                return;
+            }
+            settle_pareto_minimal(labels, potentials, policy);
+        }
+
+        // all labels of a node go to the same thread
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const auto &lhs, const auto &rhs) { return lhs.node < rhs.node; });
+        for (const auto index : irange<std::size_t>(0, batch.size())) {
+            if (index == 0 || batch[index].node != batch[index - 1].node)
+                group_begins.push_back(index);
+        }
+        group_begins.push_back(batch.size());
+    }
+
+    // The heap pops in lexicographic order, so a label is not dominated by any label in the queue
+    // if its second criterion is smaller than that of all labels popped before it. Labels found
+    // later may still dominate it if the second criterion can decrease, see above.
+    template <typename NodePotentialsT>
+    void settle_pareto_minimal(NodeLabels<PolicyT> &labels, const NodePotentialsT &potentials,
+                               const PolicyT &policy) {
+        using second_t = std::tuple_element_t<1, typename PolicyT::cost_t>;
+        auto min_second = std::numeric_limits<second_t>::max();
+
+        deferred.clear();
+        while (!heap.empty() && batch.size() < batch_size &&
+               deferred.size() < MAX_DEFERRED_FACTOR * batch_size) {
+            auto entry = heap.pop();
+            const auto second = std::get<1>(entry.label.cost);
+            if (second >= min_second) {
+                deferred.push_back(std::move(entry));
+                continue;
+            }
+            min_second = second;
+
+            // lazy deletion of labels that got dominated after they were pushed
+            if (std::get<0>(labels.clip_dominated(entry.node, entry.label, policy, potentials))) {
+                continue;
+            }
+
+            const auto entry_id = std::get<1>(labels.settle(entry.node, std::move(entry.label)));
+            batch.push_back(SettledLabel{entry.node, entry_id});
+        }
+
+        for (auto &entry : deferred)
+            heap.push(entry.node, std::move(entry.label));
+    }
+
+    // Bounds how many dominated labels are popped and pushed again per round
+    static constexpr std::size_t MAX_DEFERRED_FACTOR = 8;
+
+    const std::size_t num_threads;
+    const std::size_t batch_size;
+    LabelHeap<label_t> heap;
+    std::vector<ThreadData> thread_data;
+    std::vector<entry_t> deferred;
+    std::vector<SettledLabel> batch;
+    std::vector<std::size_t> group_begins;
+    std::atomic<std::size_t> next_group;
+    WorkerPool workers;
+    detail::Barrier barrier;
+    bool done;
+};
+
+// Overload that makes ParetoQueueSearch a drop-in replacement for the queue of mc_dijkstra
+template <typename PolicyT, typename NodePotentialsT, typename GraphT>
+auto mc_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
+                 const GraphT &graph, ParetoQueueSearch<PolicyT> &search,
+                 NodeLabels<PolicyT> &labels, const NodePotentialsT &potentials,
+                 const PolicyT &policy) {
+    search.run(start, target, graph, labels, potentials, policy);
+
+    const auto &target_labels = labels[target];
+    auto solutions = lower_envelop(
+        std::vector<typename PolicyT::label_t>(target_labels.begin(), target_labels.end()));
+    return solutions;
+}
+
+template <typename PolicyT, typename GraphT>
+auto mc_dijkstra(const typename PolicyT::node_id_t start, const typename PolicyT::node_id_t target,
+                 const GraphT &graph, ParetoQueueSearch<PolicyT> &search,
+                 NodeLabels<PolicyT> &labels, const PolicyT &policy) {
+    return mc_dijkstra(start, target, graph, search, labels,
+                       ZeroNodePotentials<typename PolicyT::graph_t>{}, policy);
+}
+} // namespace charge::common
+
+#endif
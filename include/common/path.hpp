@@ -2,8 +2,15 @@
 #define CHARGE_COMMON_PATH_HPP
 
 #include "dijkstra.hpp"
+#include "dijkstra_private.hpp"
 #include "mc_dijkstra.hpp"
+#include "sink_iter.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <tuple>
 #include <vector>
 
@@ -26,7 +33,7 @@ void backtrack_path(const LabelEntryT from, const NodeLabelsT &labels, OutIter i
     auto current = from;
     while (current.parent != INVALID_ID) {
         *iter++ = current.parent;
-        current = labels[current.parent][current.parent_entry];
+        current = labels.label(current.parent, current.parent_entry);
     }
 }
 
@@ -37,10 +44,56 @@ void backtrack_path_with_labels(const LabelEntryT from, const NodeLabelsT &label
     while (current.parent != INVALID_ID) {
         *path_iter++ = current.parent;
         *label_iter++ = current;
-        current = labels[current.parent][current.parent_entry];
+        current = labels.label(current.parent, current.parent_entry);
     }
 }
+// Recomputes the delta of a label that does not store it by linking the cost of its parent
+// label again. If the hop yields multiple solutions (e.g. charging) we pick the one whose cost
+// matches the label at its minimum.
+template <typename LabelEntryT, typename GraphT, typename PolicyT>
+auto relink_delta(const typename LabelEntryT::node_id_t node, const LabelEntryT &label,
+                  const LabelEntryT &parent_label, const GraphT &graph, const PolicyT &policy) {
+    using delta_t = typename LabelEntryT::delta_t;
+
+    const auto x = label.cost.min_x();
+    delta_t best_delta;
+    auto best_error = std::numeric_limits<double>::infinity();
+    const auto consider = [&](auto &&solution) {
+        auto & [ delta, cost ] = solution;
+        if (cost.functions.empty())
+            return;
+        const auto error = std::abs(cost(std::clamp(x, cost.min_x(), cost.max_x())) - label.cost(x));
+        if (error < best_error) {
+            best_error = error;
+            best_delta = std::move(delta);
+        }
+    };
+
+    if (label.parent == node) {
+        // clang-format off
+        if constexpr(has_node_weights<PolicyT>::value) {
+            const auto consider_shifted = [&](auto &&solution) {
+                std::get<0>(solution).shift(policy.node_weight_penalty);
+                std::get<1>(solution).shift(policy.node_weight_penalty);
+                consider(solution);
+            };
+            policy.link_node(parent_label.cost, node, make_sink_iter(std::ref(consider_shifted)));
+        }
+        // clang-format on
+    } else {
+        for (auto edge = graph.begin(label.parent); edge < graph.end(label.parent); ++edge) {
+            if (graph.target(edge) == node) {
+                auto solution = policy.link(parent_label.cost, graph.weight(edge));
+                consider(solution);
+            }
+        }
+    }
+    assert(best_error < std::numeric_limits<double>::infinity());
+
+    best_delta.limit_from_x(label.cost.min_x(), label.cost.max_x());
+    return best_delta;
 }
+} // namespace detail
 
 template <typename GraphT>
 auto get_path(const typename GraphT::node_id_t start, const typename GraphT::node_id_t middle,
@@ -91,7 +144,7 @@ auto get_path_with_labels(const typename LabelEntryT::node_id_t start,
     std::reverse(path.begin(), path.end());
 
     assert(labels[start].size() == 1);
-    path_labels.push_back(labels[start].front());
+    path_labels.push_back(labels.label(start, 0));
     std::reverse(path_labels.begin(), path_labels.end());
 
     assert(path.front() == start);
@@ -101,6 +154,25 @@ auto get_path_with_labels(const typename LabelEntryT::node_id_t start,
     return std::make_tuple(std::move(path), std::move(path_labels));
 }
 
+// For labels that do not store their delta (LabelEntryWithParentOnly), recomputes the delta of
+// every label on the path. deltas[i] maps the time at path_labels[i] to the time at its parent,
+// the entry of the start label is empty. GraphT and PolicyT need to be the ones of the search.
+template <typename LabelEntryT, typename NodeLabelsT, typename GraphT, typename PolicyT>
+auto get_path_with_deltas(const typename LabelEntryT::node_id_t start,
+                          const typename LabelEntryT::node_id_t target,
+                          const LabelEntryT target_label, const NodeLabelsT &labels,
+                          const GraphT &graph, const PolicyT &policy) {
+    auto[path, path_labels] = get_path_with_labels(start, target, target_label, labels);
+
+    std::vector<typename LabelEntryT::delta_t> deltas(path_labels.size());
+    for (std::size_t index = 1; index < path_labels.size(); ++index) {
+        deltas[index] = detail::relink_delta(path[index], path_labels[index],
+                                             path_labels[index - 1], graph, policy);
+    }
+
+    return std::make_tuple(std::move(path), std::move(path_labels), std::move(deltas));
+}
+
 template <typename GraphT>
 auto get_path_with_labels(const typename GraphT::node_id_t start,
                           const typename GraphT::node_id_t middle,
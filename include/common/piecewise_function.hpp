@@ -6,8 +6,9 @@
 
 #include <algorithm>
 #include <cassert>
-#include <vector>
 #include <limits>
+#include <memory_resource>
+#include <vector>
 
 namespace charge::common {
 
@@ -34,10 +35,10 @@ struct PiecewieseFunction {
     }
 
     PiecewieseFunction() noexcept = default;
+    // Copies use the default resource, moves keep the memory of other
     PiecewieseFunction(const PiecewieseFunction &other) noexcept { functions = other.functions; };
-    PiecewieseFunction(PiecewieseFunction &&other) noexcept {
-        functions = std::move(other.functions);
-    };
+    PiecewieseFunction(PiecewieseFunction &&other) noexcept
+        : functions(std::move(other.functions)) {}
     PiecewieseFunction &operator=(const PiecewieseFunction &other) noexcept {
         functions = other.functions;
         return *this;
@@ -49,9 +50,13 @@ struct PiecewieseFunction {
 
     PiecewieseFunction(SubFunctionT sub) noexcept : functions({std::move(sub)}) {}
 
-    PiecewieseFunction(std::vector<SubFunctionT> functions_) noexcept
+    PiecewieseFunction(std::pmr::vector<SubFunctionT> functions_) noexcept
         : functions(std::move(functions_)) {}
 
+    // Empty function whose segments are allocated from resource, e.g. the arena of a search
+    explicit PiecewieseFunction(std::pmr::memory_resource *resource) noexcept
+        : functions(resource) {}
+
     const SubFunctionT &sub(const double x) const {
         assert(!functions.empty());
         assert(
@@ -72,7 +77,7 @@ struct PiecewieseFunction {
         // clang-format off
         if constexpr(common::is_monotone<FunctionT>::value && !std::is_same_v<Monoticity, not_monotone>) {
             using InverseFunctionT = decltype(std::declval<FunctionT>().inverse());
-            std::vector<LimitedFunction<InverseFunctionT, MinBoundT, MaxBoundT>> inverse_functions(functions.size());
+            std::pmr::vector<LimitedFunction<InverseFunctionT, MinBoundT, MaxBoundT>> inverse_functions(functions.size());
             std::transform(functions.begin(), functions.end(), inverse_functions.begin(),
                            [](const auto &function) { return function.inverse(); });
             if constexpr(std::is_same_v<Monoticity, monotone_decreasing>) {
@@ -90,7 +95,8 @@ struct PiecewieseFunction {
 
     template <typename OutFnT = FunctionT>
     PiecewieseFunction<OutFnT, MinBoundT, MaxBoundT, Monoticity> clip(const double min_x) const {
-        PiecewieseFunction<OutFnT, MinBoundT, MaxBoundT, Monoticity> clipped;
+        PiecewieseFunction<OutFnT, MinBoundT, MaxBoundT, Monoticity> clipped(
+            functions.get_allocator().resource());
 
         detail::clip(functions.begin(), functions.end(), min_x,
                      std::back_inserter(clipped.functions));
@@ -259,7 +265,7 @@ struct PiecewieseFunction {
         return functions == other.functions;
     }
 
-    std::vector<SubFunctionT> functions;
+    std::pmr::vector<SubFunctionT> functions;
 };
 
 template <typename FunctionT, typename MinBoundT, typename MaxBoundT>
@@ -0,0 +1,215 @@
+#ifndef CHARGE_COMMON_RADIX_ID_QUEUE_HPP
+#define CHARGE_COMMON_RADIX_ID_QUEUE_HPP
+
+#include "common/constants.hpp"
+#include "common/id_queue.hpp"
+#include "common/statistics.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace charge::common {
+
+//! A monotone radix heap with the same interface as MinIDQueue.
+//! The elements are IDs from 0 to id_count-1 sorted by non-negative integer keys.
+//!
+//! Keys are bucketed by the highest bit in which they differ from the key of the
+//! last removed minimum. This is only correct if the queue is used monotone:
+//! No key that is pushed (or decreased) can be smaller then the last peek'ed or pop'ed key.
+//! This holds for Dijkstra's algorithm on graphs with non-negative weights.
+class RadixMinIDQueue {
+  private:
+    // bucket 0 contains all keys equal to last_key, bucket i > 0 all keys
+    // where the highest bit that differs from last_key is bit i-1
+    static const constexpr unsigned num_buckets = 33;
+
+    using bucket_t = std::vector<IDKeyPair>;
+
+  public:
+    RadixMinIDQueue() : heap_size(0), last_key(0) {}
+
+    explicit RadixMinIDQueue(unsigned id_count)
+        : id_pos(id_count, INVALID_ID), id_bucket(id_count, 0), heap_size(0), last_key(0) {}
+
+    //! Returns whether the queue is empty. Equivalent to checking whether size() returns 0.
+    bool empty() const { return heap_size == 0; }
+
+    //! Returns the number of elements in the queue.
+    unsigned size() const { return heap_size; }
+
+    //! Returns the id_count value passed to the constructor.
+    unsigned id_count() const { return id_pos.size(); }
+
+    //! Checks whether an element is in the queue.
+    bool contains_id(unsigned id) const {
+        assert(id < id_count());
+        return id_pos[id] != INVALID_ID;
+    }
+
+    //! Removes all elements from the queue.
+    void clear() {
+        for (auto &bucket : buckets) {
+            for (const auto &element : bucket)
+                id_pos[element.id] = INVALID_ID;
+            bucket.clear();
+        }
+        heap_size = 0;
+        last_key = 0;
+    }
+
+    friend void swap(RadixMinIDQueue &l, RadixMinIDQueue &r) {
+        using std::swap;
+        swap(l.id_pos, r.id_pos);
+        swap(l.id_bucket, r.id_bucket);
+        swap(l.buckets, r.buckets);
+        swap(l.heap_size, r.heap_size);
+        swap(l.last_key, r.last_key);
+    }
+
+    //! Returns the current key of an element.
+    //! Undefined if the element is not part of the queue.
+    auto get_key(unsigned id) const {
+        assert(contains_id(id));
+        return buckets[id_bucket[id]][id_pos[id]].key;
+    }
+
+    //! Returns the smallest element key pair without removing it from the queue.
+    //! This will redistribute the smallest non-empty bucket if needed.
+    IDKeyPair peek() const {
+        assert(!empty());
+        refill();
+        return buckets[0].back();
+    }
+
+    //! Returns the smallest element key pair and removes it form the queue.
+    IDKeyPair pop() {
+        Statistics::get().count(StatisticsEvent::QUEUE_POP);
+        assert(!empty());
+        refill();
+
+        auto top = buckets[0].back();
+        buckets[0].pop_back();
+        id_pos[top.id] = INVALID_ID;
+        --heap_size;
+
+        return top;
+    }
+
+    //! Inserts a element key pair.
+    //! Undefined if the element is part of the queue or the key is smaller then the last
+    //! peek'ed or pop'ed key.
+    void push(IDKeyPair p) {
+        Statistics::get().count(StatisticsEvent::QUEUE_PUSH);
+        assert(p.id < id_count());
+        assert(!contains_id(p.id));
+        assert(p.key >= 0);
+        assert(static_cast<std::uint32_t>(p.key) >= last_key);
+
+        insert(p);
+        ++heap_size;
+    }
+
+    //! Updates the key of an element if the new key is smaller than the old key.
+    //! Does nothing if the new key is larger.
+    //! Undefined if the element is not part of the queue.
+    bool decrease_key(IDKeyPair p) {
+        Statistics::get().count(StatisticsEvent::QUEUE_DECREASE_KEY);
+        assert(contains_id(p.id));
+        assert(static_cast<std::uint32_t>(p.key) >= last_key);
+
+        if (get_key(p.id) > p.key) {
+            update_key(p);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    //! Updates the key of an element if the new key is larger than the old key.
+    //! Does nothing if the new key is smaller.
+    //! Undefined if the element is not part of the queue.
+    bool increase_key(IDKeyPair p) {
+        Statistics::get().count(StatisticsEvent::QUEUE_INCREASE_KEY);
+        assert(contains_id(p.id));
+
+        if (get_key(p.id) < p.key) {
+            update_key(p);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+  private:
+    unsigned bucket_index(std::uint32_t key) const {
+        const auto diff = key ^ last_key;
+        return diff == 0 ? 0 : 32 - __builtin_clz(diff);
+    }
+
+    void insert(IDKeyPair p) const {
+        const auto index = bucket_index(p.key);
+        id_bucket[p.id] = index;
+        id_pos[p.id] = buckets[index].size();
+        buckets[index].push_back(p);
+    }
+
+    void update_key(IDKeyPair p) {
+        const auto index = id_bucket[p.id];
+        const auto pos = id_pos[p.id];
+
+        if (bucket_index(p.key) == index) {
+            buckets[index][pos].key = p.key;
+            return;
+        }
+
+        auto &bucket = buckets[index];
+        bucket[pos] = bucket.back();
+        id_pos[bucket[pos].id] = pos;
+        bucket.pop_back();
+
+        insert(p);
+    }
+
+    // Makes sure the minimal element is in bucket 0, by advancing
+    // last_key to the smallest key and re-distributing its bucket.
+    void refill() const {
+        if (!buckets[0].empty())
+            return;
+
+        unsigned index = 1;
+        while (buckets[index].empty()) {
+            ++index;
+            assert(index < num_buckets);
+        }
+
+        auto &bucket = buckets[index];
+        std::uint32_t min_key = bucket.front().key;
+        for (const auto &element : bucket) {
+            min_key = std::min<std::uint32_t>(min_key, element.key);
+        }
+        last_key = min_key;
+
+        // all elements move to a strictly smaller bucket
+        bucket_t elements;
+        elements.swap(bucket);
+        for (const auto &element : elements) {
+            insert(element);
+        }
+        // keep the allocated memory around for the next round
+        elements.clear();
+        bucket.swap(elements);
+    }
+
+    // all members are mutable since peek() needs to be able to re-distribute buckets
+    mutable std::vector<unsigned> id_pos;
+    mutable std::vector<std::uint8_t> id_bucket;
+    mutable std::array<bucket_t, num_buckets> buckets;
+
+    unsigned heap_size;
+    mutable std::uint32_t last_key;
+};
+} // namespace charge::common
+
+#endif
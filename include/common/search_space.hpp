@@ -2,8 +2,8 @@
 #define CHARGE_COMMON_SEARCH_SPACE_HPP
 
 #include "common/coordinate.hpp"
-#include "common/irange.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace charge::common {
@@ -15,36 +15,38 @@ struct SearchSpaceNode {
     bool is_charging_station;
 };
 
-template <typename NodeLabelsT, typename ChargingFunctionContainerT>
-inline auto get_search_space(const NodeLabelsT &labels, const ChargingFunctionContainerT &chargers,
-                             const std::vector<Coordinate> &coordinates) {
-    auto num_nodes = labels.settled_labels.size();
+namespace detail {
+// Only visits the nodes the last search touched, sorted by id
+template <typename NodeLabelsT, typename IsChargerFn>
+inline auto get_search_space(const NodeLabelsT &labels, const std::vector<Coordinate> &coordinates,
+                             IsChargerFn is_charger) {
     std::vector<SearchSpaceNode> search_space;
 
-    for (const auto node : common::irange<std::size_t>(0, num_nodes)) {
+    for (const std::size_t node : labels.touched_nodes()) {
         if (!labels[node].empty()) {
             search_space.push_back(SearchSpaceNode{coordinates[node], node, labels[node].size(),
-                                                   chargers.weighted(node)});
+                                                   is_charger(node)});
         }
     }
 
+    std::sort(search_space.begin(), search_space.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.id < rhs.id; });
+
     return search_space;
 }
+} // namespace detail
+
+template <typename NodeLabelsT, typename ChargingFunctionContainerT>
+inline auto get_search_space(const NodeLabelsT &labels, const ChargingFunctionContainerT &chargers,
+                             const std::vector<Coordinate> &coordinates) {
+    return detail::get_search_space(labels, coordinates,
+                                    [&](const auto node) { return chargers.weighted(node); });
+}
 
 template <typename NodeLabelsT>
 inline auto get_search_space(const NodeLabelsT &labels,
                              const std::vector<Coordinate> &coordinates) {
-    auto num_nodes = labels.settled_labels.size();
-    std::vector<SearchSpaceNode> search_space;
-
-    for (const auto node : common::irange<std::size_t>(0, num_nodes)) {
-        if (!labels[node].empty()) {
-            search_space.push_back(
-                SearchSpaceNode{coordinates[node], node, labels[node].size(), false});
-        }
-    }
-
-    return search_space;
+    return detail::get_search_space(labels, coordinates, [](const auto) { return false; });
 }
 
 } // namespace charge::common
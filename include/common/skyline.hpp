@@ -0,0 +1,168 @@
+#ifndef CHARGE_COMMON_SKYLINE_HPP
+#define CHARGE_COMMON_SKYLINE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace charge::common {
+
+namespace detail {
+// Returns true if one of the first size entries is at most first_bound in the first and at most
+// second_bound in the second criterion. The entries need to be sorted by the first criterion.
+template <typename T1, typename T2>
+bool any_within_bounds(const T1 *firsts, const T2 *seconds, const std::size_t size,
+                       const T1 first_bound, const T2 second_bound) {
+    for (std::size_t index = 0; index < size && firsts[index] <= first_bound; ++index) {
+        if (seconds[index] <= second_bound)
+            return true;
+    }
+    return false;
+}
+
+#ifdef __AVX2__
+// Checks blocks of 8 entries with one compare per criterion, the rest uses the scalar version
+inline bool any_within_bounds(const std::int32_t *firsts, const std::int32_t *seconds,
+                              const std::size_t size, const std::int32_t first_bound,
+                              const std::int32_t second_bound) {
+    const auto first_bounds = _mm256_set1_epi32(first_bound);
+    const auto second_bounds = _mm256_set1_epi32(second_bound);
+
+    std::size_t index = 0;
+    for (; index + 8 <= size; index += 8) {
+        const auto first_block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(firsts + index));
+        const auto second_block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(seconds + index));
+        const auto first_above = _mm256_cmpgt_epi32(first_block, first_bounds);
+        const auto any_above =
+            _mm256_or_si256(first_above, _mm256_cmpgt_epi32(second_block, second_bounds));
+        // a lane that is above in neither criterion is within bounds
+        if (_mm256_movemask_ps(_mm256_castsi256_ps(any_above)) != 0xFF)
+            return true;
+        // sorted, all following entries are above as well
+        if (_mm256_movemask_ps(_mm256_castsi256_ps(first_above)) != 0)
+            return false;
+    }
+
+    return any_within_bounds<std::int32_t, std::int32_t>(
+        firsts + index, seconds + index, size - index, first_bound, second_bound);
+}
+#endif
+} // namespace detail
+
+// Read-only view of a Skyline
+template <typename CostT> class SkylineRange {
+  public:
+    using value_t = CostT;
+    using first_t = std::tuple_element_t<0, CostT>;
+    using second_t = std::tuple_element_t<1, CostT>;
+
+    // Up to this size the entries are scanned in blocks, above it we use a binary search
+    static constexpr std::size_t MAX_SCAN_SIZE = 64;
+
+    SkylineRange(const first_t *firsts, const second_t *seconds, const std::size_t size_)
+        : firsts(firsts), seconds(seconds), size_(size_) {}
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    value_t operator[](const std::size_t index) const {
+        return value_t{firsts[index], seconds[index]};
+    }
+
+    // Returns true if there is an entry that is at most first_bound in the first criterion and
+    // at most second_bound in the second criterion.
+    bool any_within(const first_t first_bound, const second_t second_bound) const {
+        if (size_ <= MAX_SCAN_SIZE) {
+            return detail::any_within_bounds(firsts, seconds, size_, first_bound, second_bound);
+        }
+
+        // the last entry that is not above in the first criterion is best in the second
+        const auto end = std::upper_bound(firsts, firsts + size_, first_bound);
+        return end != firsts && seconds[end - firsts - 1] <= second_bound;
+    }
+
+  private:
+    const first_t *firsts;
+    const second_t *seconds;
+    std::size_t size_;
+};
+
+// Pareto set of two criteria: sorted by the first criterion ascending, which makes the second
+// criterion strictly descending. Among all entries that are not worse in the first criterion
+// than some cost the last one is best in the second criterion, so a dominance check only needs
+// the prefix up to the first criterion of the cost.
+//
+// Both criteria are stored in their own array, so checking a cost against a block of entries is
+// one SIMD compare per criterion (AVX2, with a scalar fallback).
+template <typename CostT> class Skyline {
+  public:
+    using value_t = CostT;
+    using first_t = std::tuple_element_t<0, CostT>;
+    using second_t = std::tuple_element_t<1, CostT>;
+
+    explicit Skyline(std::pmr::memory_resource *resource) : firsts(resource), seconds(resource) {}
+
+    Skyline(const Skyline &other, std::pmr::memory_resource *resource)
+        : firsts(other.firsts, resource), seconds(other.seconds, resource) {}
+
+    std::size_t size() const { return firsts.size(); }
+    bool empty() const { return firsts.empty(); }
+    value_t operator[](const std::size_t index) const {
+        return value_t{firsts[index], seconds[index]};
+    }
+
+    SkylineRange<CostT> range() const {
+        return SkylineRange<CostT>(firsts.data(), seconds.data(), size());
+    }
+
+    // Inserts the cost and removes all entries it dominates.
+    // Returns false if the cost is dominated by an entry.
+    bool insert(const value_t &cost) {
+        const auto[first, second] = cost;
+
+        const std::size_t upper =
+            std::upper_bound(firsts.begin(), firsts.end(), first) - firsts.begin();
+        if (upper > 0 && seconds[upper - 1] <= second)
+            return false;
+
+        // all dominated entries directly follow the new one
+        const std::size_t begin =
+            std::lower_bound(firsts.begin(), firsts.begin() + upper, first) - firsts.begin();
+        auto end = begin;
+        while (end < size() && seconds[end] >= second)
+            ++end;
+
+        if (begin == end) {
+            firsts.insert(firsts.begin() + begin, first);
+            seconds.insert(seconds.begin() + begin, second);
+        } else {
+            firsts.erase(firsts.begin() + begin + 1, firsts.begin() + end);
+            seconds.erase(seconds.begin() + begin + 1, seconds.begin() + end);
+            firsts[begin] = first;
+            seconds[begin] = second;
+        }
+        return true;
+    }
+
+  private:
+    std::pmr::vector<first_t> firsts;
+    std::pmr::vector<second_t> seconds;
+};
+
+template <typename T, typename = int> struct has_sorted_skyline : std::false_type {};
+
+template <typename T>
+struct has_sorted_skyline<T, decltype((void)T::sorted_skyline, 0)>
+    : std::integral_constant<bool, T::sorted_skyline> {};
+} // namespace charge::common
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef CHARGE_COMMON_SOA_ID_QUEUE_HPP
+#define CHARGE_COMMON_SOA_ID_QUEUE_HPP
+
+#include "common/aligned_allocator.hpp"
+#include "common/constants.hpp"
+#include "common/id_queue.hpp"
+#include "common/statistics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace charge::common {
+
+namespace detail {
+// Position of the first minimum of the Arity keys starting at block
+template <unsigned Arity> inline unsigned min_key_index(const std::int32_t *block) {
+    unsigned min_index = 0;
+    for (unsigned index = 1; index < Arity; ++index) {
+        if (block[index] < block[min_index])
+            min_index = index;
+    }
+    return min_index;
+}
+
+#ifdef __SSE4_1__
+template <> inline unsigned min_key_index<4>(const std::int32_t *block) {
+    const auto keys = _mm_load_si128(reinterpret_cast<const __m128i *>(block));
+    auto min = _mm_min_epi32(keys, _mm_shuffle_epi32(keys, _MM_SHUFFLE(2, 3, 0, 1)));
+    min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+    const auto mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, min)));
+    return __builtin_ctz(mask);
+}
+#endif
+
+#ifdef __AVX2__
+template <> inline unsigned min_key_index<8>(const std::int32_t *block) {
+    const auto keys = _mm256_load_si256(reinterpret_cast<const __m256i *>(block));
+    auto min = _mm256_min_epi32(keys, _mm256_shuffle_epi32(keys, _MM_SHUFFLE(2, 3, 0, 1)));
+    min = _mm256_min_epi32(min, _mm256_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+    min = _mm256_min_epi32(min, _mm256_permute2x128_si256(min, min, 1));
+    const auto mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(keys, min)));
+    return __builtin_ctz(mask);
+}
+#endif
+} // namespace detail
+
+//! Addressable d-ary heap with the same interface as MinIDQueue.
+//!
+//! Keys and ids are kept in separate arrays (structure of arrays). The keys are shifted by
+//! Arity - 1 slots so all children of a node form one aligned block that lies in a single
+//! cache line. Unused slots hold the largest key, this way the minimum child is always taken
+//! over the full block, which is a single SIMD min for Arity 4 (SSE4.1) and Arity 8 (AVX2).
+//! Sifting down prefetches the grandchildren before the children are compared.
+template <unsigned Arity = 8> class SoAMinIDQueue {
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8 || Arity == 16,
+                  "A block of children has to fit into one cache line");
+
+    using key_t = std::int32_t;
+    static constexpr key_t EMPTY_KEY = std::numeric_limits<key_t>::max();
+    static constexpr unsigned KEYS_PER_LINE = CACHE_LINE_SIZE / sizeof(key_t);
+
+  public:
+    static constexpr unsigned tree_arity = Arity;
+
+    SoAMinIDQueue() : heap_size(0) {}
+
+    explicit SoAMinIDQueue(unsigned id_count)
+        : id_pos(id_count, INVALID_ID), ids(id_count),
+          keys(((id_count + 2 * Arity) / Arity) * Arity, EMPTY_KEY), heap_size(0) {}
+
+    //! Returns whether the queue is empty. Equivalent to checking whether size() returns 0.
+    bool empty() const { return heap_size == 0; }
+
+    //! Returns the number of elements in the queue.
+    unsigned size() const { return heap_size; }
+
+    //! Returns the id_count value passed to the constructor.
+    unsigned id_count() const { return id_pos.size(); }
+
+    //! Checks whether an element is in the queue.
+    bool contains_id(unsigned id) const {
+        assert(id < id_count());
+        return id_pos[id] != INVALID_ID;
+    }
+
+    //! Removes all elements from the queue.
+    void clear() {
+        for (unsigned pos = 0; pos < heap_size; ++pos) {
+            id_pos[ids[pos]] = INVALID_ID;
+            key(pos) = EMPTY_KEY;
+        }
+        heap_size = 0;
+    }
+
+    friend void swap(SoAMinIDQueue &l, SoAMinIDQueue &r) {
+        using std::swap;
+        swap(l.id_pos, r.id_pos);
+        swap(l.ids, r.ids);
+        swap(l.keys, r.keys);
+        swap(l.heap_size, r.heap_size);
+    }
+
+    //! Returns the current key of an element.
+    //! Undefined if the element is not part of the queue.
+    auto get_key(unsigned id) const {
+        assert(id < id_count());
+        assert(id_pos[id] != INVALID_ID);
+        return key(id_pos[id]);
+    }
+
+    //! Returns the smallest element key pair without removing it from the queue.
+    IDKeyPair peek() const {
+        assert(!empty());
+        return IDKeyPair{ids[0], key(0)};
+    }
+
+    //! Returns the smallest element key pair and removes it form the queue.
+    IDKeyPair pop() {
+        Statistics::get().count(StatisticsEvent::QUEUE_POP);
+        assert(!empty());
+        const IDKeyPair top{ids[0], key(0)};
+        id_pos[top.id] = INVALID_ID;
+
+        --heap_size;
+        const IDKeyPair last{ids[heap_size], key(heap_size)};
+        key(heap_size) = EMPTY_KEY;
+        if (heap_size > 0)
+            move_down_in_tree(0, last);
+
+        return top;
+    }
+
+    //! Inserts a element key pair.
+    //! Undefined if the element is part of the queue.
+    void push(IDKeyPair p) {
+        Statistics::get().count(StatisticsEvent::QUEUE_PUSH);
+        assert(p.id < id_count());
+        assert(!contains_id(p.id));
+        assert(p.key < EMPTY_KEY);
+
+        move_up_in_tree(heap_size++, p);
+    }
+
+    //! Updates the key of an element if the new key is smaller than the old key.
+    //! Does nothing if the new key is larger.
+    //! Undefined if the element is not part of the queue.
+    bool decrease_key(IDKeyPair p) {
+        Statistics::get().count(StatisticsEvent::QUEUE_DECREASE_KEY);
+        assert(p.id < id_count());
+        assert(contains_id(p.id));
+
+        const unsigned pos = id_pos[p.id];
+        if (key(pos) > p.key) {
+            move_up_in_tree(pos, p);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    //! Updates the key of an element if the new key is larger than the old key.
+    //! Does nothing if the new key is smaller.
+    //! Undefined if the element is not part of the queue.
+    bool increase_key(IDKeyPair p) {
+        Statistics::get().count(StatisticsEvent::QUEUE_INCREASE_KEY);
+        assert(p.id < id_count());
+        assert(contains_id(p.id));
+        assert(p.key < EMPTY_KEY);
+
+        const unsigned pos = id_pos[p.id];
+        if (key(pos) < p.key) {
+            move_down_in_tree(pos, p);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+  private:
+    key_t key(const unsigned pos) const { return keys[pos + Arity - 1]; }
+    key_t &key(const unsigned pos) { return keys[pos + Arity - 1]; }
+
+    void place(const unsigned pos, const IDKeyPair p) {
+        key(pos) = p.key;
+        ids[pos] = p.id;
+        id_pos[p.id] = pos;
+    }
+
+    // Moves the hole at pos up until p fits
+    void move_up_in_tree(unsigned pos, const IDKeyPair p) {
+        while (pos != 0) {
+            const unsigned parent = (pos - 1) / Arity;
+            if (key(parent) <= p.key)
+                break;
+            place(pos, IDKeyPair{ids[parent], key(parent)});
+            pos = parent;
+        }
+        place(pos, p);
+    }
+
+    // Moves the hole at pos down until p fits
+    void move_down_in_tree(unsigned pos, const IDKeyPair p) {
+        for (;;) {
+            const unsigned first_child = Arity * pos + 1;
+            if (first_child >= heap_size)
+                break; // no children
+
+            // the children of all children are one contiguous range of keys
+            const std::size_t first_grandchild = Arity * (first_child + 1) + Arity - 1;
+            for (std::size_t offset = first_grandchild & ~std::size_t(KEYS_PER_LINE - 1);
+                 offset < std::min(first_grandchild + Arity * Arity, keys.size());
+                 offset += KEYS_PER_LINE) {
+                __builtin_prefetch(keys.data() + offset);
+            }
+
+            const unsigned smallest_child =
+                first_child + detail::min_key_index<Arity>(&key(first_child));
+            // an empty slot is never smaller than p
+            if (smallest_child >= heap_size || key(smallest_child) >= p.key)
+                break; // no child is smaller
+
+            place(pos, IDKeyPair{ids[smallest_child], key(smallest_child)});
+            pos = smallest_child;
+        }
+        place(pos, p);
+    }
+
+    std::vector<unsigned> id_pos;
+    std::vector<std::uint32_t> ids;
+    std::vector<key_t, AlignedAllocator<key_t>> keys;
+
+    unsigned heap_size;
+};
+
+} // namespace charge::common
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef CHARGE_COMMON_TURN_GRAPH_VIEW_HPP
+#define CHARGE_COMMON_TURN_GRAPH_VIEW_HPP
+
+#include "common/constants.hpp"
+#include "common/graph_transform.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace charge::common {
+
+// Id of a turn from_edge -> to_edge of a TurnGraphView. A turn can have several weights
+// (samples), so every turn is iterated num_samples times.
+// Incrementing skips the turns that toTurnGraph would not have created.
+template <typename GraphT, std::uint32_t NumSamples> struct TurnID {
+    const GraphT *graph;
+    std::uint32_t from_edge;
+    std::uint32_t to_edge;
+    std::uint32_t end_edge;
+    // target of the forbidden u-turn at a node of degree 2, INVALID_ID otherwise
+    std::uint32_t skipped_target;
+    std::uint32_t sample;
+
+    TurnID &operator++() {
+        if (++sample == NumSamples) {
+            sample = 0;
+            ++to_edge;
+            skip();
+        }
+        return *this;
+    }
+
+    void skip() {
+        while (to_edge < end_edge && graph->target(to_edge) == skipped_target)
+            ++to_edge;
+    }
+
+    bool operator<(const TurnID &other) const {
+        return to_edge < other.to_edge || (to_edge == other.to_edge && sample < other.sample);
+    }
+};
+
+// Edge-based view of a graph that is equivalent to toTurnGraph(graph, turn_cost) without
+// materializing it: Every edge of the graph is a node of the view and the turn costs are
+// evaluated lazily when an edge of the view is relaxed.
+// Only needs the start node and the undirected degree of every edge/node.
+//
+// TurnCostT needs to provide weight_t, num_samples and
+// weight_t operator()(graph, degree, from, via, to, sample).
+template <typename GraphT, typename TurnCostT> class TurnGraphView {
+  public:
+    using node_id_t = typename GraphT::edge_id_t;
+    using edge_id_t = TurnID<GraphT, TurnCostT::num_samples>;
+    using weight_t = typename TurnCostT::weight_t;
+
+    TurnGraphView(const GraphT &graph, TurnCostT turn_cost)
+        : graph(graph), turn_cost(std::move(turn_cost)), degree(computeDegree(graph)),
+          edge_to_start_node(edgeToStartNode(graph)) {}
+
+    std::size_t num_nodes() const { return graph.num_edges(); }
+
+    edge_id_t begin(const node_id_t from_edge) const {
+        const auto via = graph.target(from_edge);
+        const auto from = edge_to_start_node[from_edge];
+        const auto skipped_target = degree[via] == 2 ? from : INVALID_ID;
+        edge_id_t id{&graph, from_edge, static_cast<std::uint32_t>(graph.begin(via)),
+                     static_cast<std::uint32_t>(graph.end(via)), skipped_target, 0};
+        id.skip();
+        return id;
+    }
+
+    edge_id_t end(const node_id_t from_edge) const {
+        const auto via = graph.target(from_edge);
+        const auto end_edge = static_cast<std::uint32_t>(graph.end(via));
+        return edge_id_t{&graph, from_edge, end_edge, end_edge, INVALID_ID, 0};
+    }
+
+    node_id_t target(const edge_id_t &id) const { return id.to_edge; }
+
+    weight_t weight(const edge_id_t &id) const {
+        const auto from = edge_to_start_node[id.from_edge];
+        const auto via = graph.target(id.from_edge);
+        const auto to = graph.target(id.to_edge);
+        return turn_cost(graph, degree[via], from, via, to, id.sample);
+    }
+
+    // Node of the original graph that an edge of the view starts at
+    auto start_node(const node_id_t edge) const { return edge_to_start_node[edge]; }
+
+  private:
+    const GraphT &graph;
+    TurnCostT turn_cost;
+    std::vector<std::size_t> degree;
+    std::vector<typename GraphT::edge_id_t> edge_to_start_node;
+};
+} // namespace charge::common
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef CHARGE_COMMON_WORKER_POOL_HPP
+#define CHARGE_COMMON_WORKER_POOL_HPP
+
+#include "common/irange.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace charge::common {
+
+namespace detail {
+class Barrier {
+  public:
+    explicit Barrier(const std::size_t num_threads)
+        : num_threads(num_threads), num_waiting(0), generation(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        const auto current_generation = generation;
+        if (++num_waiting == num_threads) {
+            num_waiting = 0;
+            ++generation;
+            lock.unlock();
+            condition.notify_all();
+        } else {
+            condition.wait(lock, [&] { return generation != current_generation; });
+        }
+    }
+
+  private:
+    const std::size_t num_threads;
+    std::size_t num_waiting;
+    std::size_t generation;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+} // namespace detail
+
+// Threads that are started once and then run one job after another, so parallel searches
+// don't pay for starting threads on every query. The calling thread takes part in every job
+// as thread 0, a pool of size one starts no threads at all.
+class WorkerPool {
+  public:
+    explicit WorkerPool(const std::size_t num_threads) : num_running(0), generation(0) {
+        for (auto thread_index : irange<std::size_t>(1, std::max<std::size_t>(1, num_threads)))
+            threads.emplace_back([this, thread_index] { work(thread_index); });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            ++generation;
+        }
+        start_condition.notify_all();
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    std::size_t size() const { return threads.size() + 1; }
+
+    // Calls job(thread_index) on every thread and returns once all calls returned.
+    // Only one job runs at a time, calls from different threads are not supported.
+    void run(const std::function<void(std::size_t)> &job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current_job = &job;
+            num_running = threads.size();
+            ++generation;
+        }
+        start_condition.notify_all();
+
+        job(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done_condition.wait(lock, [&] { return num_running == 0; });
+        current_job = nullptr;
+    }
+
+  private:
+    void work(const std::size_t thread_index) {
+        std::uint64_t seen_generation = 0;
+        while (true) {
+            const std::function<void(std::size_t)> *job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_condition.wait(lock, [&] { return generation != seen_generation; });
+                seen_generation = generation;
+                if (stopping)
+                    return;
+                job = current_job;
+            }
+
+            (*job)(thread_index);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --num_running;
+            }
+            done_condition.notify_one();
+        }
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable start_condition;
+    std::condition_variable done_condition;
+    const std::function<void(std::size_t)> *current_job = nullptr;
+    std::size_t num_running;
+    std::uint64_t generation;
+    bool stopping = false;
+};
+} // namespace charge::common
+
+#endif
@@ -1,14 +1,18 @@
 #ifndef CHARGE_EV_DIJKSTRA_HPP
 #define CHARGE_EV_DIJKSTRA_HPP
 
+#include "common/alt_dijkstra.hpp"
 #include "common/dijkstra.hpp"
+#include "common/landmarks.hpp"
+#include "common/parallel_dijkstra.hpp"
 
 #include "ev/graph.hpp"
 
 namespace charge::ev {
 
 // Single-Criteria with Dijkstra
-template <typename GraphT> struct DijkstraContext {
+// QueueT can be common::RadixMinIDQueue since all weights are non-negative
+template <typename GraphT, typename QueueT = common::MinIDQueue> struct DijkstraContext {
     DijkstraContext(const TradeoffGraph &tradeoff_graph, const GraphT &graph)
         : tradeoff_graph(tradeoff_graph), graph(graph), queue(graph.num_nodes()),
           costs(graph.num_nodes(), common::INF_WEIGHT),
@@ -27,13 +31,88 @@ template <typename GraphT> struct DijkstraContext {
 
     const TradeoffGraph &tradeoff_graph;
     const GraphT &graph;
-    common::MinIDQueue queue;
+    QueueT queue;
     common::CostVector<GraphT> costs;
     common::ParentVector<GraphT> parents;
 };
 
+// Single-Criteria with bidirectional ALT
+template <typename GraphT, typename QueueT = common::MinIDQueue> struct ALTDijkstraContext {
+    ALTDijkstraContext(const TradeoffGraph &tradeoff_graph, const GraphT &graph,
+                       const GraphT &reverse_graph, const common::Landmarks<GraphT> &landmarks)
+        : tradeoff_graph(tradeoff_graph), graph(graph), reverse_graph(reverse_graph),
+          potentials(landmarks), forward_queue(graph.num_nodes()),
+          reverse_queue(graph.num_nodes()), forward_costs(graph.num_nodes(), common::INF_WEIGHT),
+          reverse_costs(graph.num_nodes(), common::INF_WEIGHT),
+          forward_parents(graph.num_nodes(), common::INVALID_ID),
+          reverse_parents(graph.num_nodes(), common::INVALID_ID), middle(common::INVALID_ID) {}
+
+    // Make copyable and movable
+    ALTDijkstraContext(ALTDijkstraContext &&) = default;
+    ALTDijkstraContext(const ALTDijkstraContext &) = default;
+    ALTDijkstraContext &operator=(ALTDijkstraContext &&) = default;
+    ALTDijkstraContext &operator=(const ALTDijkstraContext &) = default;
+
+    auto operator()(const typename GraphT::node_id_t start,
+                    const typename GraphT::node_id_t target) {
+        return common::alt_dijkstra(start, target, graph, reverse_graph, potentials,
+                                    forward_queue, reverse_queue, forward_costs, reverse_costs,
+                                    forward_parents, reverse_parents, middle);
+    }
+
+    const TradeoffGraph &tradeoff_graph;
+    const GraphT &graph;
+    const GraphT &reverse_graph;
+    common::AverageLandmarkPotentials<GraphT> potentials;
+    QueueT forward_queue;
+    QueueT reverse_queue;
+    common::CostVector<GraphT> forward_costs;
+    common::CostVector<GraphT> reverse_costs;
+    common::ParentVector<GraphT> forward_parents;
+    common::ParentVector<GraphT> reverse_parents;
+    typename GraphT::node_id_t middle;
+};
+
+// Single-Criteria with bidirectional Dijkstra, the reverse search runs on a second thread
+template <typename GraphT, typename QueueT = common::MinIDQueue>
+struct ParallelDijkstraContext {
+    ParallelDijkstraContext(const TradeoffGraph &tradeoff_graph, const GraphT &graph,
+                            const GraphT &reverse_graph)
+        : tradeoff_graph(tradeoff_graph), graph(graph), reverse_graph(reverse_graph),
+          forward_queue(graph.num_nodes()), reverse_queue(graph.num_nodes()),
+          forward_costs(graph.num_nodes(), common::INF_WEIGHT),
+          reverse_costs(graph.num_nodes(), common::INF_WEIGHT),
+          forward_parents(graph.num_nodes(), common::INVALID_ID),
+          reverse_parents(graph.num_nodes(), common::INVALID_ID), middle(common::INVALID_ID),
+          state(graph.num_nodes()) {}
+
+    // Make copyable, the shared state is never copied
+    ParallelDijkstraContext(const ParallelDijkstraContext &) = default;
+
+    auto operator()(const typename GraphT::node_id_t start,
+                    const typename GraphT::node_id_t target) {
+        return common::parallel_dijkstra(start, target, graph, reverse_graph, forward_queue,
+                                         reverse_queue, forward_costs, reverse_costs,
+                                         forward_parents, reverse_parents, middle, state);
+    }
+
+    const TradeoffGraph &tradeoff_graph;
+    const GraphT &graph;
+    const GraphT &reverse_graph;
+    QueueT forward_queue;
+    QueueT reverse_queue;
+    common::CostVector<GraphT> forward_costs;
+    common::CostVector<GraphT> reverse_costs;
+    common::ParentVector<GraphT> forward_parents;
+    common::ParentVector<GraphT> reverse_parents;
+    typename GraphT::node_id_t middle;
+    common::ParallelDijkstraState<GraphT> state;
+};
+
 using MinDurationDijkstraContetx = DijkstraContext<DurationGraph>;
 using MinConsumptionDijkstraContetx = DijkstraContext<ConsumptionGraph>;
+using MinDurationALTDijkstraContext = ALTDijkstraContext<DurationGraph>;
+using MinDurationParallelDijkstraContext = ParallelDijkstraContext<DurationGraph>;
 }
 
 #endif
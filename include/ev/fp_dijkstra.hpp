@@ -7,6 +7,7 @@
 #include "ev/charging_function_container.hpp"
 #include "ev/graph.hpp"
 #include "ev/node_potentials.hpp"
+#include "ev/turn_graph_view.hpp"
 
 namespace charge::ev {
 
@@ -67,6 +68,8 @@ class TradeoffDijkstraPolicy
 using TradeoffLabelEntryWithParent =
     common::LabelEntryWithParent<TradeoffGraph::weight_t, TradeoffGraph::node_id_t>;
 using TradeoffDijkstraPolicyWithParents = TradeoffDijkstraPolicy<TradeoffLabelEntryWithParent>;
+using TradeoffLabelEntryWithParentOnly =
+    common::LabelEntryWithParentOnly<TradeoffGraph::weight_t, TradeoffGraph::node_id_t>;
 
 template <typename LabelEntryT>
 auto fp_dijkstra(const ev::TradeoffGraph::node_id_t start,
@@ -83,6 +86,20 @@ auto fp_dijkstra(const ev::TradeoffGraph::node_id_t start,
                                NodePotentials{}, Policy{x_eps, y_eps, capacity});
 }
 
+// Edge-based search with turn costs, start and target are edges of the tradeoff graph
+template <typename LabelEntryT>
+auto fp_dijkstra(const TradeoffTurnGraph::node_id_t start_edge,
+                 const TradeoffTurnGraph::node_id_t target_edge, const TradeoffTurnGraph &graph,
+                 common::MinIDQueue &queue,
+                 common::NodeLabels<TradeoffDijkstraPolicy<LabelEntryT>> &labels,
+                 const double capacity = std::numeric_limits<double>::infinity(),
+                 const double x_eps = 0.1, const double y_eps = 1.0) {
+    using Policy = TradeoffDijkstraPolicy<LabelEntryT>;
+    using NodePotentials = common::ZeroNodePotentials<TradeoffTurnGraph>;
+    return common::fp_dijkstra(start_edge, target_edge, ev::make_constant(0, 0), graph, queue,
+                               labels, NodePotentials{}, Policy{x_eps, y_eps, capacity});
+}
+
 template <typename LabelEntryT, typename NodePotentialsT>
 auto fp_astar(const ev::TradeoffGraph::node_id_t start, const ev::TradeoffGraph::node_id_t target,
               const ev::TradeoffGraph &graph, common::MinIDQueue &queue,
@@ -150,13 +167,15 @@ struct FPAStarContext {
 };
 
 // Function propagation using chargers with A*
-struct FPAStarOmegaContext {
+// The potentials are recomputed with PotentialQueueT, e.g. common::DeltaStepping.
+template <typename PotentialQueueT = common::MinIDQueue> struct FPAStarOmegaContext {
     FPAStarOmegaContext(const double x_eps, const double y_eps, const double capacity,
                         const double min_tradeoff_rate, const TradeoffGraph &graph,
                         const DurationGraph &reverse_min_duration_graph,
                         const ConsumptionGraph &reverse_consumption_graph,
                         const OmegaGraph &reverse_omega_graph)
         : x_eps(x_eps), y_eps(y_eps), capacity(capacity), graph(graph), queue(graph.num_nodes()),
+          potential_queue(graph.num_nodes()),
           potentials(capacity, min_tradeoff_rate, reverse_min_duration_graph,
                      reverse_consumption_graph, reverse_omega_graph),
           labels(graph.num_nodes()) {}
@@ -168,7 +187,7 @@ struct FPAStarOmegaContext {
     FPAStarOmegaContext &operator=(const FPAStarOmegaContext &) = default;
 
     auto operator()(const TradeoffGraph::node_id_t start, const TradeoffGraph::node_id_t target) {
-        potentials.recompute(queue, target);
+        potentials.recompute(potential_queue, target);
         return fp_astar(start, target, graph, queue, labels, potentials, capacity, x_eps, y_eps);
     }
 
@@ -177,6 +196,7 @@ struct FPAStarOmegaContext {
     const double capacity;
     const TradeoffGraph &graph;
     common::MinIDQueue queue;
+    PotentialQueueT potential_queue;
     ev::OmegaNodePotentials potentials;
     common::NodeLabels<TradeoffDijkstraPolicyWithParents> labels;
 };
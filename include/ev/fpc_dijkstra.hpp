@@ -67,6 +67,10 @@ using TradeoffChargingDijkstraPolicyWithParents = TradeoffChargingDijkstraPolicy
 using TradeoffChargingProfileDijkstraPolicyWithParents = TradeoffChargingProfileDijkstraPolicy<
     common::LabelEntryWithParent<TradeoffGraph::weight_t, TradeoffGraph::node_id_t>>;
 
+// Keeps only the parent pointers on every label, see common::get_path_with_deltas
+using TradeoffChargingDijkstraPolicyWithParentsOnly =
+    TradeoffChargingDijkstraPolicy<TradeoffLabelEntryWithParentOnly>;
+
 template <typename LabelEntryT>
 auto fpc_dijkstra(const ev::TradeoffGraph::node_id_t start,
                   const ev::TradeoffGraph::node_id_t target, const ev::TradeoffGraph &graph,
@@ -146,7 +150,8 @@ struct FPCDijkstraContext {
 };
 
 // Function propagation using chargers with A*
-struct FPCAStarOmegaContext {
+// The potentials are recomputed with PotentialQueueT, e.g. common::DeltaStepping.
+template <typename PotentialQueueT = common::MinIDQueue> struct FPCAStarOmegaContext {
     FPCAStarOmegaContext(const double x_eps, const double y_eps, const double capacity,
                          const double charging_penalty, const double min_charging_rate,
                          const TradeoffGraph &graph, const ChargingFunctionContainer &chargers,
@@ -155,6 +160,7 @@ struct FPCAStarOmegaContext {
                          const OmegaGraph &reverse_omega_graph)
         : x_eps(x_eps), y_eps(y_eps), capacity(capacity), charging_penalty(charging_penalty),
           graph(graph), chargers(chargers), queue(graph.num_nodes()),
+          potential_queue(graph.num_nodes()),
           potentials(capacity, min_charging_rate, reverse_min_duration_graph,
                      reverse_consumption_graph, reverse_omega_graph),
           labels(graph.num_nodes()) {}
@@ -166,7 +172,7 @@ struct FPCAStarOmegaContext {
     FPCAStarOmegaContext &operator=(const FPCAStarOmegaContext &) = default;
 
     auto operator()(const TradeoffGraph::node_id_t start, const TradeoffGraph::node_id_t target) {
-        potentials.recompute(queue, target);
+        potentials.recompute(potential_queue, target);
         return fpc_astar(start, target, graph, chargers, potentials, queue, labels, capacity, x_eps,
                          y_eps, charging_penalty);
     }
@@ -178,12 +184,13 @@ struct FPCAStarOmegaContext {
     const TradeoffGraph &graph;
     const ChargingFunctionContainer &chargers;
     common::MinIDQueue queue;
+    PotentialQueueT potential_queue;
     ev::OmegaNodePotentials potentials;
     common::NodeLabels<TradeoffChargingDijkstraPolicyWithParents> labels;
 };
 
 // Function propagation using chargers with A*
-struct FPCAStarLazyOmegaContext {
+template <typename PotentialQueueT = common::MinIDQueue> struct FPCAStarLazyOmegaContext {
     FPCAStarLazyOmegaContext(const double x_eps, const double y_eps, const double capacity,
                     const double charging_penalty, const double min_charging_rate,
                     const TradeoffGraph &graph, const ChargingFunctionContainer &chargers,
@@ -213,19 +220,20 @@ struct FPCAStarLazyOmegaContext {
                          y_eps, charging_penalty);
     }
 
-    const double x_eps;
-    const double y_eps;
+    // can be changed between queries, e.g. to refine an answer with smaller epsilons
+    double x_eps;
+    double y_eps;
     const double capacity;
     const double charging_penalty;
     const TradeoffGraph &graph;
     const ChargingFunctionContainer &chargers;
     common::MinIDQueue queue;
-    ev::LazyOmegaNodePotentials potentials;
+    ev::LazyOmegaNodePotentials<PotentialQueueT> potentials;
     common::NodeLabels<TradeoffChargingDijkstraPolicyWithParents> labels;
 };
 
 // Function propagation using chargers with A*
-struct FPCProfileAStarLazyOmegaContext {
+template <typename PotentialQueueT = common::MinIDQueue> struct FPCProfileAStarLazyOmegaContext {
     FPCProfileAStarLazyOmegaContext(const double x_eps, const double y_eps, const double capacity,
                     const double charging_penalty, const double min_charging_rate,
                     const TradeoffGraph &graph, const ChargingFunctionContainer &chargers,
@@ -255,14 +263,15 @@ struct FPCProfileAStarLazyOmegaContext {
                                  capacity, x_eps, y_eps, charging_penalty);
     }
 
-    const double x_eps;
-    const double y_eps;
+    // can be changed between queries, e.g. to refine an answer with smaller epsilons
+    double x_eps;
+    double y_eps;
     const double capacity;
     const double charging_penalty;
     const TradeoffGraph &graph;
     const ChargingFunctionContainer &chargers;
     common::MinIDQueue queue;
-    ev::LazyOmegaNodePotentials potentials;
+    ev::LazyOmegaNodePotentials<PotentialQueueT> potentials;
     common::NodeLabels<TradeoffChargingProfileDijkstraPolicyWithParents> labels;
 };
 
@@ -300,7 +309,7 @@ struct FPCAStarFastestContext {
 };
 
 // Function propagation with A*
-struct FPCAStarLazyFastestContext {
+template <typename PotentialQueueT = common::MinIDQueue> struct FPCAStarLazyFastestContext {
     FPCAStarLazyFastestContext(const double x_eps, const double y_eps, const double capacity,
                                const double charging_penalty, const TradeoffGraph &graph,
                                const ChargingFunctionContainer &chargers,
@@ -328,7 +337,7 @@ struct FPCAStarLazyFastestContext {
     const TradeoffGraph &graph;
     const ChargingFunctionContainer &chargers;
     common::MinIDQueue queue;
-    common::LazyLandmarkNodePotentials<DurationGraph> potentials;
+    common::LazyLandmarkNodePotentials<DurationGraph, PotentialQueueT> potentials;
     common::NodeLabels<TradeoffChargingDijkstraPolicyWithParents> labels;
 };
 } // namespace charge::ev
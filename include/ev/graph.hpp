@@ -1,6 +1,7 @@
 #ifndef CHARGE_EV_GRAPH_HPP
 #define CHARGE_EV_GRAPH_HPP
 
+#include "common/packed_graph.hpp"
 #include "common/weighted_graph.hpp"
 
 #include "ev/limited_tradeoff_function.hpp"
@@ -27,6 +28,11 @@ class TradeoffGraph : public common::WeightedGraph<ev::LimitedTradeoffFunction>
     }
 };
 
+// Tradeoff edges packed into one cache line each, can be used in place of a TradeoffGraph
+// in the searches that are templated on the graph
+using PackedTradeoffGraph =
+    common::PackedWeightedGraph<ev::LimitedTradeoffFunction, common::CACHE_LINE_SIZE>;
+
 class DurationConsumptionGraph
     : public common::WeightedGraph<std::tuple<std::int32_t, std::int32_t>> {
   public:
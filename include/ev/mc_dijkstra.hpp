@@ -2,11 +2,16 @@
 #define CHARGE_EV_MC_DIJKSTRA_HPP
 
 #include "ev/graph.hpp"
+#include "ev/turn_graph_view.hpp"
 
+#include "common/bidirectional_mc_dijkstra.hpp"
 #include "common/domination.hpp"
 #include "common/mc_dijkstra.hpp"
 #include "common/statistics.hpp"
 
+#include <algorithm>
+#include <tuple>
+
 namespace charge::ev {
 
 // Tuned to work well with a metric consitsing of deci-seconds and deci-mWh
@@ -27,9 +32,8 @@ class DurationConsumptionDijkstraPolicy
                                       const std::int32_t capacity)
         : x_epsilon(x_epsilon), y_epsilon(y_epsilon), capacity(capacity) {}
 
-    template <typename NodeLabelsT>
-    static bool terminate(const common::MinIDQueue &queue, const NodeLabelsT &labels,
-                          const node_id_t target) {
+    template <typename QueueT, typename NodeLabelsT>
+    static bool terminate(const QueueT &queue, const NodeLabelsT &labels, const node_id_t target) {
         return common::bi_criterial_traits::min_key_terminate(queue, labels, target);
     }
 
@@ -61,6 +65,13 @@ class DurationConsumptionDijkstraPolicy
         return std::make_tuple(false, false);
     }
 
+    auto clip_dominated(const common::SkylineRange<cost_t> &skyline, const cost_t &rhs) const {
+        common::Statistics::get().count(common::StatisticsEvent::DOMINATION);
+        const auto is_dominated =
+            skyline.any_within(std::get<0>(rhs) + x_epsilon, std::get<1>(rhs) + y_epsilon);
+        return std::make_tuple(is_dominated, is_dominated);
+    }
+
     const std::int32_t x_epsilon;
     const std::int32_t y_epsilon;
     const std::int32_t capacity;
@@ -71,6 +82,122 @@ using DurationConsumptionLabelEntryWithParent =
                                  DurationConsumptionGraph::node_id_t>;
 using DurationConsumptionDijkstraPolicyWithParents =
     DurationConsumptionDijkstraPolicy<DurationConsumptionLabelEntryWithParent>;
+using DurationConsumptionMeetingLabel =
+    common::MeetingLabel<DurationConsumptionGraph::weight_t, DurationConsumptionGraph::node_id_t>;
+
+// Cost of the rest of a path to the target: the duration, the energy that is needed at its start,
+// the net consumption (negative if it recuperates) and the consumption of the whole path if the
+// battery is full at the start of the rest.
+using DurationConsumptionRestCost =
+    std::tuple<std::int32_t, std::int32_t, std::int32_t, std::int32_t>;
+using DurationConsumptionRestLabelEntryWithParent =
+    common::LabelEntryWithParent<DurationConsumptionRestCost, DurationConsumptionGraph::node_id_t>;
+
+// Backward search of a bidirectional search on the reverse graph, every relaxed edge is put in
+// front of the rest of the path. The consumption of a path is clamped at zero after every edge,
+// so the energy that is left after the forward half decides how much of the rest can be
+// recuperated. A forward label with consumption c can be followed by the rest if c plus the needed
+// energy fits into the capacity, the consumption of the path is then the larger one of c plus the
+// net consumption and the consumption from a full battery.
+template <typename LabelEntryT> class DurationConsumptionBackwardDijkstraPolicy {
+  public:
+    using graph_t = DurationConsumptionGraph;
+    using queue_t = common::MinIDQueue;
+    using key_t = std::int32_t;
+    using weight_t = DurationConsumptionGraph::weight_t;
+    using cost_t = typename LabelEntryT::cost_t;
+    using node_id_t = DurationConsumptionGraph::node_id_t;
+    using label_t = LabelEntryT;
+    using forward_cost_t = weight_t;
+
+    static constexpr bool enable_stalling = true;
+
+    DurationConsumptionBackwardDijkstraPolicy(const std::int32_t x_epsilon,
+                                              const std::int32_t y_epsilon,
+                                              const std::int32_t capacity)
+        : x_epsilon(x_epsilon), y_epsilon(y_epsilon), capacity(capacity) {}
+
+    static auto key(const cost_t &cost) { return std::get<0>(cost); }
+
+    static cost_t link(const cost_t &rest, const weight_t &edge) {
+        const auto[duration, needed, net, from_full] = rest;
+        const auto[edge_duration, edge_consumption] = edge;
+        return cost_t{duration + edge_duration, std::max(0, edge_consumption + needed),
+                      edge_consumption + net,
+                      std::max(std::max(0, edge_consumption) + net, from_full)};
+    }
+
+    bool constrain(cost_t &cost) const {
+        assert(std::get<0>(cost) >= 0);
+        if (std::get<1>(cost) > capacity) {
+            cost = cost_t{common::INF_WEIGHT, common::INF_WEIGHT, common::INF_WEIGHT,
+                          common::INF_WEIGHT};
+            return true;
+        }
+        return false;
+    }
+
+    // Cost of the forward path followed by the rest, returns true if the battery does not suffice
+    bool meet(const forward_cost_t &forward, const cost_t &rest, forward_cost_t &cost) const {
+        const auto[duration, consumption] = forward;
+        const auto[rest_duration, needed, net, from_full] = rest;
+        if (consumption + needed > capacity)
+            return true;
+        cost = forward_cost_t{duration + rest_duration, std::max(consumption + net, from_full)};
+        return false;
+    }
+
+    // Lower bound on the cost of any path that ends with the rest
+    static forward_cost_t rest_bound(const cost_t &rest) {
+        return forward_cost_t{std::get<0>(rest), std::get<3>(rest)};
+    }
+
+    // Lower bound on the cost of any path that starts with the forward path, the rest can
+    // recuperate down to an empty battery
+    static forward_cost_t forward_bound(const forward_cost_t &forward) {
+        return forward_cost_t{std::get<0>(forward), 0};
+    }
+
+    // Cost at the next node of the rest if the path has the forward cost at the first node
+    static forward_cost_t advance(const forward_cost_t &forward, const cost_t &rest,
+                                  const cost_t &next_rest) {
+        return forward_cost_t{
+            std::get<0>(forward) + std::get<0>(rest) - std::get<0>(next_rest),
+            std::max(0, std::get<1>(forward) + std::get<2>(rest) - std::get<2>(next_rest))};
+    }
+
+    bool dominates(const cost_t &lhs, const cost_t &rhs) const {
+        common::Statistics::get().count(common::StatisticsEvent::DOMINATION);
+        return std::get<0>(lhs) <= std::get<0>(rhs) + x_epsilon &&
+               std::get<1>(lhs) <= std::get<1>(rhs) + y_epsilon &&
+               std::get<2>(lhs) <= std::get<2>(rhs) + y_epsilon &&
+               std::get<3>(lhs) <= std::get<3>(rhs) + y_epsilon;
+    }
+
+    template <typename Range> bool dominates(const Range &lhs_range, const cost_t &rhs) const {
+        return std::get<0>(clip_dominated(lhs_range, rhs));
+    }
+
+    // Clipping does nothing for points
+    auto clip_dominated(const cost_t &lhs, const cost_t &rhs) const {
+        return std::make_tuple(dominates(lhs, rhs), false);
+    }
+
+    template <typename Range> auto clip_dominated(const Range &lhs_range, const cost_t &rhs) const {
+        for (const auto &lhs : lhs_range) {
+            if (dominates(lhs, rhs))
+                return std::make_tuple(true, true);
+        }
+        return std::make_tuple(false, false);
+    }
+
+    const std::int32_t x_epsilon;
+    const std::int32_t y_epsilon;
+    const std::int32_t capacity;
+};
+
+using DurationConsumptionBackwardDijkstraPolicyWithParents =
+    DurationConsumptionBackwardDijkstraPolicy<DurationConsumptionRestLabelEntryWithParent>;
 
 // Runs a Multi-Criteria dijkstra with Pareto-Dominanz on a bi-criterial graph
 template <typename LabelEntryT>
@@ -87,6 +214,21 @@ auto mc_dijkstra(const DurationConsumptionGraph::node_id_t start,
                                Policy{x_eps, y_eps, capacity});
 }
 
+// Edge-based search with turn costs, start and target are edges of the tradeoff graph
+template <typename LabelEntryT, std::uint32_t NumSamples>
+auto mc_dijkstra(const typename SampledTurnGraph<NumSamples>::node_id_t start_edge,
+                 const typename SampledTurnGraph<NumSamples>::node_id_t target_edge,
+                 const SampledTurnGraph<NumSamples> &graph, common::MinIDQueue &queue,
+                 common::NodeLabels<DurationConsumptionDijkstraPolicy<LabelEntryT>> &labels,
+                 const std::int32_t capacity = common::INF_WEIGHT,
+                 const std::int32_t x_eps = common::to_fixed(0.1),
+                 const std::int32_t y_eps = common::to_fixed(1.0)) {
+    using Policy = DurationConsumptionDijkstraPolicy<LabelEntryT>;
+    return common::mc_dijkstra(start_edge, target_edge, graph, queue, labels,
+                               common::ZeroNodePotentials<SampledTurnGraph<NumSamples>>{},
+                               Policy{x_eps, y_eps, capacity});
+}
+
 template <typename LabelEntryT, typename NodePotentialT>
 auto mc_astar(const DurationConsumptionGraph::node_id_t start,
               const DurationConsumptionGraph::node_id_t target,
@@ -4,6 +4,10 @@
 #include "ev/charging_function_container.hpp"
 #include "ev/mc_dijkstra.hpp"
 
+#include "common/parallel_mc_dijkstra.hpp"
+
+#include <thread>
+
 namespace charge::ev {
 
 template <typename LabelEntryT>
@@ -45,6 +49,7 @@ class DurationConsumptionChargingDijkstraPolicy
     using DurationConsumptionBase::enable_stalling;
     using DurationConsumptionBase::key;
     using DurationConsumptionBase::link;
+    using DurationConsumptionBase::sorted_skyline;
     using DurationConsumptionBase::terminate;
 
     using WeightedNodeBase::WeightedNodeBase;
@@ -54,6 +59,10 @@ class DurationConsumptionChargingDijkstraPolicy
 
 using DurationConsumptionChargingDijkstraPolicyWithParents =
     DurationConsumptionChargingDijkstraPolicy<DurationConsumptionLabelEntryWithParent>;
+// Both bases declare sorted_skyline, without the using declaration above it is ambiguous and
+// NodeLabels silently falls back to scanning the settled labels
+static_assert(
+    common::NodeLabels<DurationConsumptionChargingDijkstraPolicyWithParents>::has_skyline);
 
 // Runs a Multi-Criteria dijkstra with Pareto-Dominanz on a bi-criterial graph
 template <typename LabelEntryT>
@@ -88,6 +97,33 @@ auto mcc_astar(const DurationConsumptionGraph::node_id_t start,
                                Policy{x_eps, y_eps, capacity, charging_penalty, chargers, sample_resolution});
 }
 
+// Bidirectional Multi-Criteria dijkstra, reverse_graph is the inverted graph.
+// The backward search does not charge, its labels hold the rest of the path to the target (see
+// DurationConsumptionBackwardDijkstraPolicy): the needed energy decides if a forward label can
+// meet it and the net consumption and the consumption from a full battery give the consumption
+// of the whole path, so recuperation is exact. Charging stops are only found by the forward
+// search, a path is combined behind its last charging stop.
+template <typename LabelEntryT>
+auto bidirectional_mcc_dijkstra(
+    const DurationConsumptionGraph::node_id_t start,
+    const DurationConsumptionGraph::node_id_t target, const DurationConsumptionGraph &graph,
+    const DurationConsumptionGraph &reverse_graph, const ChargingFunctionContainer &chargers,
+    common::LabelHeap<LabelEntryT> &forward_heap,
+    common::LabelHeap<DurationConsumptionRestLabelEntryWithParent> &backward_heap,
+    common::BidirectionalNodeLabels<DurationConsumptionChargingDijkstraPolicy<LabelEntryT>,
+                                    DurationConsumptionBackwardDijkstraPolicyWithParents> &labels,
+    const std::int32_t capacity = common::INF_WEIGHT,
+    const std::int32_t x_eps = common::to_fixed(0.1),
+    const std::int32_t y_eps = common::to_fixed(1.0), const double sample_resolution = 10.0,
+    const std::int32_t charging_penalty = common::to_fixed(60)) {
+    using ForwardPolicy = DurationConsumptionChargingDijkstraPolicy<LabelEntryT>;
+    using BackwardPolicy = DurationConsumptionBackwardDijkstraPolicyWithParents;
+    return common::bidirectional_mc_dijkstra(
+        start, target, graph, reverse_graph, forward_heap, backward_heap, labels,
+        ForwardPolicy{x_eps, y_eps, capacity, charging_penalty, chargers, sample_resolution},
+        BackwardPolicy{x_eps, y_eps, capacity});
+}
+
 // Multi-Criteria with Dijkstra
 struct MCCDijkstraContext {
     MCCDijkstraContext(const double x_eps, const double y_eps, const double sample_resolution,
@@ -122,6 +158,84 @@ struct MCCDijkstraContext {
     common::NodeLabels<DurationConsumptionChargingDijkstraPolicyWithParents> labels;
 };
 
+// Multi-Criteria with Dijkstra, the labels of each Pareto queue round are relaxed in parallel
+struct ParallelMCCDijkstraContext {
+    using Policy = DurationConsumptionChargingDijkstraPolicyWithParents;
+
+    ParallelMCCDijkstraContext(
+        const double x_eps, const double y_eps, const double sample_resolution,
+        const double capacity, const double charging_penalty,
+        const DurationConsumptionGraph &graph, const ChargingFunctionContainer &chargers,
+        const std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency()))
+        : x_eps(x_eps), y_eps(y_eps), sample_resolution(sample_resolution), capacity(capacity),
+          charging_penalty(charging_penalty), graph(graph), chargers(chargers),
+          search(graph.num_nodes(), num_threads), labels(graph.num_nodes()) {}
+
+    // Make copyable, the search state is never copied
+    ParallelMCCDijkstraContext(const ParallelMCCDijkstraContext &) = default;
+
+    auto operator()(const DurationConsumptionGraph::node_id_t start,
+                    const DurationConsumptionGraph::node_id_t target) {
+        return common::mc_dijkstra(start, target, graph, search, labels,
+                                   Policy{common::to_fixed(x_eps), common::to_fixed(y_eps),
+                                          common::to_fixed(capacity),
+                                          common::to_fixed(charging_penalty), chargers,
+                                          sample_resolution});
+    }
+
+    const double x_eps;
+    const double y_eps;
+    const double sample_resolution;
+    const double capacity;
+    const double charging_penalty;
+    const DurationConsumptionGraph &graph;
+    const ChargingFunctionContainer &chargers;
+    common::ParetoQueueSearch<Policy> search;
+    common::NodeLabels<Policy> labels;
+};
+
+// Multi-Criteria with bidirectional Dijkstra
+struct BidirectionalMCCDijkstraContext {
+    using ForwardPolicy = DurationConsumptionChargingDijkstraPolicyWithParents;
+    using BackwardPolicy = DurationConsumptionBackwardDijkstraPolicyWithParents;
+
+    BidirectionalMCCDijkstraContext(const double x_eps, const double y_eps,
+                                    const double sample_resolution, const double capacity,
+                                    const double charging_penalty,
+                                    const DurationConsumptionGraph &graph,
+                                    const DurationConsumptionGraph &reverse_graph,
+                                    const ChargingFunctionContainer &chargers)
+        : x_eps(x_eps), y_eps(y_eps), sample_resolution(sample_resolution), capacity(capacity),
+          charging_penalty(charging_penalty), graph(graph), reverse_graph(reverse_graph),
+          chargers(chargers), forward_heap(graph.num_nodes()), backward_heap(graph.num_nodes()),
+          labels(graph.num_nodes()) {}
+
+    // Make copyable and movable
+    BidirectionalMCCDijkstraContext(BidirectionalMCCDijkstraContext &&) = default;
+    BidirectionalMCCDijkstraContext(const BidirectionalMCCDijkstraContext &) = default;
+
+    auto operator()(const DurationConsumptionGraph::node_id_t start,
+                    const DurationConsumptionGraph::node_id_t target) {
+        return bidirectional_mcc_dijkstra(start, target, graph, reverse_graph, chargers,
+                                          forward_heap, backward_heap, labels,
+                                          common::to_fixed(capacity), common::to_fixed(x_eps),
+                                          common::to_fixed(y_eps), sample_resolution,
+                                          common::to_fixed(charging_penalty));
+    }
+
+    const double x_eps;
+    const double y_eps;
+    const double sample_resolution;
+    const double capacity;
+    const double charging_penalty;
+    const DurationConsumptionGraph &graph;
+    const DurationConsumptionGraph &reverse_graph;
+    const ChargingFunctionContainer &chargers;
+    common::LabelHeap<DurationConsumptionLabelEntryWithParent> forward_heap;
+    common::LabelHeap<DurationConsumptionRestLabelEntryWithParent> backward_heap;
+    common::BidirectionalNodeLabels<ForwardPolicy, BackwardPolicy> labels;
+};
+
 // Multi-Criteria with A*
 struct MCCAStarFastestContext {
     MCCAStarFastestContext(const double x_eps, const double y_eps, const double sample_resolution,
@@ -161,7 +275,7 @@ struct MCCAStarFastestContext {
 };
 
 // Multi-Criteria with A*
-struct MCCAStarLazyFastestContext {
+template <typename PotentialQueueT = common::MinIDQueue> struct MCCAStarLazyFastestContext {
     MCCAStarLazyFastestContext(const double x_eps, const double y_eps, const double sample_resolution,
                     const double capacity, const double charging_penalty,
                     const DurationConsumptionGraph &graph,
@@ -194,7 +308,7 @@ struct MCCAStarLazyFastestContext {
     const DurationConsumptionGraph &graph;
     const ChargingFunctionContainer &chargers;
     common::MinIDQueue queue;
-    common::LazyLandmarkNodePotentials<DurationGraph> potentials;
+    common::LazyLandmarkNodePotentials<DurationGraph, PotentialQueueT> potentials;
     common::NodeLabels<DurationConsumptionChargingDijkstraPolicyWithParents> labels;
 };
 } // namespace charge::ev
@@ -97,7 +97,9 @@ class OmegaNodePotentials {
         return key;
     }
 
-    void recompute(common::MinIDQueue &queue, const node_id_t landmark) {
+    // A common::DeltaStepping can be passed as queue to run the three searches in parallel,
+    // see the PotentialQueueT of FPAStarOmegaContext and FPCAStarOmegaContext.
+    template <typename QueueT> void recompute(QueueT &queue, const node_id_t landmark) {
         dijkstra_to_all(landmark, reverse_duration_graph, queue, duration_to_landmark);
         dijkstra_to_all(landmark, reverse_consumption_graph, queue, consumption_to_landmark);
         dijkstra_to_all(landmark, reverse_omega_graph, queue, omega_to_landmark);
@@ -114,7 +116,7 @@ class OmegaNodePotentials {
     common::CostVector<OmegaGraph> omega_to_landmark;
 };
 
-class LazyOmegaNodePotentials {
+template <typename QueueT = common::MinIDQueue> class LazyOmegaNodePotentials {
   public:
     using node_id_t = ev::DurationGraph::node_id_t;
     using key_t = std::int32_t;
@@ -272,12 +274,12 @@ class LazyOmegaNodePotentials {
     mutable common::CostVector<DurationGraph> duration_to_landmark;
     mutable common::CostVector<ConsumptionGraph> consumption_to_landmark;
     mutable common::CostVector<OmegaGraph> omega_to_landmark;
-    mutable common::MinIDQueue duration_queue;
-    mutable common::MinIDQueue consumption_queue;
-    mutable common::MinIDQueue omega_queue;
-    mutable std::vector<bool> duration_settled;
-    mutable std::vector<bool> consumption_settled;
-    mutable std::vector<bool> omega_settled;
+    mutable QueueT duration_queue;
+    mutable QueueT consumption_queue;
+    mutable QueueT omega_queue;
+    mutable common::SettledVector duration_settled;
+    mutable common::SettledVector consumption_settled;
+    mutable common::SettledVector omega_settled;
 };
 } // namespace charge::ev
 
@@ -0,0 +1,74 @@
+#ifndef CHARGE_EV_TURN_GRAPH_VIEW_HPP
+#define CHARGE_EV_TURN_GRAPH_VIEW_HPP
+
+#include "common/constants.hpp"
+#include "common/turn_cost_model.hpp"
+#include "common/turn_graph_view.hpp"
+
+#include "ev/graph.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+
+namespace charge::ev {
+
+using TurnCostModel = common::TurnCostModel<TradeoffGraph::Base>;
+
+// Turn costs as tradeoff functions for fp_dijkstra, same weights as toTurnGraph
+struct TradeoffTurnCost {
+    using weight_t = TradeoffGraph::weight_t;
+    static constexpr std::uint32_t num_samples = 1;
+
+    weight_t operator()(const TradeoffGraph::Base &graph, const std::size_t degree,
+                        const TradeoffGraph::node_id_t from, const TradeoffGraph::node_id_t via,
+                        const TradeoffGraph::node_id_t to, const std::uint32_t) const {
+        return model(graph, degree, from, via, to);
+    }
+
+    const TurnCostModel &model;
+};
+
+// Minimal duration of a turn for dijkstra, same weights as tradeoff_to_min_duration
+struct MinDurationTurnCost {
+    using weight_t = DurationGraph::weight_t;
+    static constexpr std::uint32_t num_samples = 1;
+
+    weight_t operator()(const TradeoffGraph::Base &graph, const std::size_t degree,
+                        const TradeoffGraph::node_id_t from, const TradeoffGraph::node_id_t via,
+                        const TradeoffGraph::node_id_t to, const std::uint32_t) const {
+        return std::ceil(model(graph, degree, from, via, to).min_x *
+                         common::FIXED_POINT_RESOLUTION);
+    }
+
+    const TurnCostModel &model;
+};
+
+// Samples every turn at NumSamples equidistant durations for mc_dijkstra.
+// Unlike tradeoff_to_sampled_consumption the number of samples is fixed, so every sample
+// can be computed on its own while relaxing the turn.
+template <std::uint32_t NumSamples> struct SampledTurnCost {
+    static_assert(NumSamples > 0, "Every turn needs at least one sample");
+    using weight_t = DurationConsumptionGraph::weight_t;
+    static constexpr std::uint32_t num_samples = NumSamples;
+
+    weight_t operator()(const TradeoffGraph::Base &graph, const std::size_t degree,
+                        const TradeoffGraph::node_id_t from, const TradeoffGraph::node_id_t via,
+                        const TradeoffGraph::node_id_t to, const std::uint32_t sample) const {
+        const auto tradeoff = model(graph, degree, from, via, to);
+        const auto alpha = NumSamples > 1 ? sample / static_cast<double>(NumSamples - 1) : 0.0;
+        const auto duration = tradeoff.min_x + alpha * (tradeoff.max_x - tradeoff.min_x);
+        return weight_t{common::to_upper_fixed(duration),
+                        common::to_upper_fixed(tradeoff(duration, common::no_bounds_checks{}))};
+    }
+
+    const TurnCostModel &model;
+};
+
+using TradeoffTurnGraph = common::TurnGraphView<TradeoffGraph::Base, TradeoffTurnCost>;
+using MinDurationTurnGraph = common::TurnGraphView<TradeoffGraph::Base, MinDurationTurnCost>;
+template <std::uint32_t NumSamples>
+using SampledTurnGraph = common::TurnGraphView<TradeoffGraph::Base, SampledTurnCost<NumSamples>>;
+} // namespace charge::ev
+
+#endif
@@ -8,6 +8,7 @@
 #include "ev/graph.hpp"
 
 #include "common/dijkstra.hpp"
+#include "common/graph_transform.hpp"
 #include "common/parallel_for.hpp"
 #include "common/progress_bar.hpp"
 
@@ -18,6 +19,54 @@
 namespace charge::experiments {
 inline constexpr double MIN_SOC = 10; // 10 Wh minimum consumption at target
 
+namespace detail {
+// Checks for every candidate if the target is reachable from the start and vice versa.
+// Candidates are grouped by start, one forward and one backward search answer all of them.
+inline auto connected_both_ways(const ev::DurationGraph &graph,
+                                const ev::DurationGraph &reverse_graph,
+                                const std::vector<Query> &candidates,
+                                const std::size_t num_threads) {
+    std::vector<std::uint8_t> connected(candidates.size(), false);
+
+    common::MinIDQueue queue_example(graph.num_nodes());
+    common::CostVector<ev::DurationGraph> durations_example(graph.num_nodes(),
+                                                            common::INF_WEIGHT);
+
+    const auto groups = group_by_start(candidates);
+    auto range = common::irange<std::size_t>(0, groups.size());
+
+    common::parallel_for(
+        range,
+        [&](const auto &range) {
+            auto queue = queue_example;
+            auto durations = durations_example;
+            std::vector<ev::DurationGraph::node_id_t> targets;
+
+            for (auto group_index : range) {
+                const auto &group = groups[group_index];
+                const auto start = candidates[group.front()].start;
+
+                targets.clear();
+                for (auto index : group)
+                    targets.push_back(candidates[index].target);
+
+                const auto forward_durations =
+                    common::dijkstra_to_targets(start, targets, graph, queue, durations);
+                const auto reverse_durations =
+                    common::dijkstra_to_targets(start, targets, reverse_graph, queue, durations);
+
+                for (auto i : common::irange<std::size_t>(0, group.size())) {
+                    connected[group[i]] = forward_durations[i] != common::INF_WEIGHT &&
+                                          reverse_durations[i] != common::INF_WEIGHT;
+                }
+            }
+        },
+        num_threads);
+
+    return connected;
+}
+} // namespace detail
+
 inline auto make_random_in_range_queries(const std::size_t seed,
                                          const ev::DurationGraph &duration_graph,
                                          const ev::ConsumptionGraph &min_graph,
@@ -29,11 +78,10 @@ inline auto make_random_in_range_queries(const std::size_t seed,
     std::default_random_engine generator(seed);
     std::uniform_int_distribution<std::uint32_t> distribution(0, min_graph.num_nodes() - 1);
 
+    const auto reverse_duration_graph = common::invert(duration_graph);
     common::MinIDQueue queue_example(min_graph.num_nodes());
     common::CostVector<ev::ConsumptionGraph> costs_example(min_graph.num_nodes(),
                                                            common::INF_WEIGHT);
-    common::CostVector<ev::DurationGraph> durations_example(min_graph.num_nodes(),
-                                                            common::INF_WEIGHT);
 
     while (queries.size() < num_queries) {
         std::vector<Query> candidates(num_queries - queries.size());
@@ -44,6 +92,8 @@ inline auto make_random_in_range_queries(const std::size_t seed,
             q.max_consumption = std::numeric_limits<double>::infinity();
         }
 
+        const auto connected = detail::connected_both_ways(duration_graph, reverse_duration_graph,
+                                                           candidates, num_threads);
         auto range = common::irange<std::size_t>(0, candidates.size());
 
         common::parallel_for(
@@ -51,25 +101,11 @@ inline auto make_random_in_range_queries(const std::size_t seed,
             [&](const auto &range) {
                 auto queue = queue_example;
                 auto costs = costs_example;
-                auto durations = durations_example;
 
                 for (auto index : range) {
                     auto &q = candidates[index];
 
-                    auto forward_min_duration = common::constrained_dijkstra(
-                        q.start, q.target, duration_graph, queue, durations,
-                        [&](const auto &queue) {
-                            return queue.empty() || queue.peek().key > durations[q.target];
-                        },
-                        [](const auto cost) { return cost; });
-                    auto reverse_min_duration = common::constrained_dijkstra(
-                        q.target, q.start, duration_graph, queue, durations,
-                        [&](const auto &queue) {
-                            return queue.empty() || queue.peek().key > durations[q.start];
-                        },
-                        [](const auto cost) { return cost; });
-                    if (forward_min_duration == common::INF_WEIGHT ||
-                        reverse_min_duration == common::INF_WEIGHT)
+                    if (!connected[index])
                         continue;
 
                     auto min_consumption = common::constrained_dijkstra(
@@ -135,11 +171,10 @@ inline auto make_random_in_charger_range_queries(
         }
     }
 
+    const auto reverse_duration_graph = common::invert(duration_graph);
     common::MinIDQueue queue_example(min_graph.num_nodes());
     common::CostVector<ev::ConsumptionGraph> costs_example(min_graph.num_nodes(),
                                                            common::INF_WEIGHT);
-    common::CostVector<ev::DurationGraph> durations_example(min_graph.num_nodes(),
-                                                            common::INF_WEIGHT);
 
     while (queries.size() < num_queries) {
         std::vector<Query> candidates(num_queries - queries.size());
@@ -150,6 +185,8 @@ inline auto make_random_in_charger_range_queries(
             q.max_consumption = std::numeric_limits<double>::infinity();
         }
 
+        const auto connected = detail::connected_both_ways(duration_graph, reverse_duration_graph,
+                                                           candidates, num_threads);
         auto range = common::irange<std::size_t>(0, candidates.size());
 
         common::parallel_for(
@@ -157,25 +194,11 @@ inline auto make_random_in_charger_range_queries(
             [&](const auto &range) {
                 auto queue = queue_example;
                 auto costs = costs_example;
-                auto durations = durations_example;
 
                 for (auto index : range) {
                     auto &q = candidates[index];
 
-                    auto forward_min_duration = common::constrained_dijkstra(
-                        q.start, q.target, duration_graph, queue, durations,
-                        [&](const auto &queue) {
-                            return queue.empty() || queue.peek().key > durations[q.target];
-                        },
-                        [](const auto cost) { return cost; });
-                    auto reverse_min_duration = common::constrained_dijkstra(
-                        q.target, q.start, duration_graph, queue, durations,
-                        [&](const auto &queue) {
-                            return queue.empty() || queue.peek().key > durations[q.start];
-                        },
-                        [](const auto cost) { return cost; });
-                    if (forward_min_duration == common::INF_WEIGHT ||
-                        reverse_min_duration == common::INF_WEIGHT)
+                    if (!connected[index])
                         continue;
 
                     auto sources = charging_nodes;
@@ -252,6 +275,7 @@ inline auto make_rank_in_charger_range_queries(
         }
     }
 
+    const auto reverse_duration_graph = common::invert(duration_graph);
     common::MinIDQueue queue_example(min_graph.num_nodes());
     common::CostVector<ev::ConsumptionGraph> costs_example(min_graph.num_nodes(),
                                                            common::INF_WEIGHT);
@@ -264,6 +288,7 @@ inline auto make_rank_in_charger_range_queries(
     }
 
     std::vector<Query> candidates;
+    std::mutex candidates_mutex;
     auto sources_range = common::irange<std::size_t>(0, sources.size());
     common::parallel_for(
         sources_range,
@@ -281,6 +306,7 @@ inline auto make_rank_in_charger_range_queries(
                     return durations[lhs] < durations[rhs];
                 });
 
+                std::lock_guard<std::mutex> guard{candidates_mutex};
                 unsigned rank = 0;
                 while (1 << rank < targets.size()) {
                     candidates.push_back(
@@ -292,25 +318,20 @@ inline auto make_rank_in_charger_range_queries(
         },
         num_threads);
 
+    // Fix for s and t not being the same SCC
+    const auto connected = detail::connected_both_ways(duration_graph, reverse_duration_graph,
+                                                       candidates, num_threads);
     auto candidates_range = common::irange<std::size_t>(0, candidates.size());
     common::parallel_for(
         candidates_range,
         [&](const auto &range) {
             auto queue = queue_example;
             auto costs = costs_example;
-            auto durations = durations_example;
 
             for (auto index : range) {
                 auto &q = candidates[index];
 
-                auto reverse_min_duration = common::constrained_dijkstra(
-                    q.target, q.start, duration_graph, queue, durations,
-                    [&](const auto &queue) {
-                        return queue.empty() || queue.peek().key > durations[q.start];
-                    },
-                    [](const auto cost) { return cost; });
-                // Fix for s and t not being the same SCC
-                if (reverse_min_duration == common::INF_WEIGHT)
+                if (!connected[index])
                     continue;
 
                 auto sources = charging_nodes;
@@ -9,6 +9,7 @@
 #include "server/to_result.hpp"
 
 #include "common/csv.hpp"
+#include "common/deadline.hpp"
 #include "common/histrogram.hpp"
 #include "common/irange.hpp"
 #include "common/options.hpp"
@@ -99,7 +100,7 @@ template <typename ContextT> class ExperimentRunner {
                     progress.update();
 
                     if
-                        constexpr(has_labels<ContextT>::value) { context.labels.clear(); context.labels.shrink_to_fit(); }
+                        constexpr(has_labels<ContextT>::value) { context.labels.clear(); }
 
                     common::Statistics::get().reset();
                     if (common::Options::get().tail_experiment)
@@ -107,7 +108,10 @@ template <typename ContextT> class ExperimentRunner {
                                   << std::endl;
                     auto start = std::chrono::high_resolution_clock::now();
 
+                    // stops the running query as well, not only the following ones
+                    const common::ScopedDeadline deadline(max_time);
                     auto solutions = context(query.start, query.target);
+                    const auto timed_out = deadline.is_expired();
 
                     auto diff = std::chrono::high_resolution_clock::now() - start;
                     auto time_us =
@@ -131,7 +135,7 @@ template <typename ContextT> class ExperimentRunner {
                         timings[query.id] += time_us;
                     }
 
-                    if (time_us / 1000.0 / 1000.0 > max_time)
+                    if (timed_out || time_us / 1000.0 / 1000.0 > max_time)
                     {
                         std::cerr << "\nFirst query with " << (time_us / 1000.0 / 1000.0) << " > " << max_time << ". Stopping. " << std::endl;
                         break;
@@ -1,7 +1,10 @@
 #ifndef CHARGE_EXPERIMENTS_QUERY_HPP
 #define CHARGE_EXPERIMENTS_QUERY_HPP
 
+#include <algorithm>
 #include <cstdint>
+#include <numeric>
+#include <vector>
 
 namespace charge::experiments {
 
@@ -14,6 +17,25 @@ struct Query {
     std::uint32_t rank;
 };
 
+// Returns the indices of the queries grouped by start node, so that
+// one search from each start can answer all queries of that group.
+inline auto group_by_start(const std::vector<Query> &queries) {
+    std::vector<std::size_t> indices(queries.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(indices.begin(), indices.end(), [&](const auto lhs, const auto rhs) {
+        return queries[lhs].start < queries[rhs].start;
+    });
+
+    std::vector<std::vector<std::size_t>> groups;
+    for (auto index : indices) {
+        if (groups.empty() || queries[groups.back().front()].start != queries[index].start)
+            groups.emplace_back();
+        groups.back().push_back(index);
+    }
+
+    return groups;
+}
+
 }
 
 #endif
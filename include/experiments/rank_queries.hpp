@@ -5,44 +5,149 @@
 
 #include "ev/graph.hpp"
 
+#include "common/coordinate.hpp"
 #include "common/dijkstra.hpp"
+#include "common/graph_transform.hpp"
+#include "common/multi_source_dijkstra.hpp"
 #include "common/parallel_for.hpp"
 #include "common/progress_bar.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <mutex>
 #include <numeric>
 #include <random>
 
 namespace charge::experiments {
 
+// The rank of a query is log2 of the number of nodes settled before the target
+// in a Dijkstra search from the start. Queries are grouped by start and each search
+// stops as soon as all targets of the group are settled.
 inline auto make_rank(const ev::DurationGraph &graph, std::vector<Query> queries,
                       const std::size_t num_threads) {
 
     common::MinIDQueue queue_example(graph.num_nodes());
-    common::CostVector<ev::ConsumptionGraph> costs_example(graph.num_nodes(), common::INF_WEIGHT);
+    common::CostVector<ev::DurationGraph> costs_example(graph.num_nodes(), common::INF_WEIGHT);
 
-    auto range = common::irange<std::size_t>(0, queries.size());
+    const auto groups = group_by_start(queries);
+    auto range = common::irange<std::size_t>(0, groups.size());
 
     common::parallel_for(
         range,
         [&](const auto &range) {
             auto queue = queue_example;
             auto costs = costs_example;
-            std::vector<ev::DurationGraph::node_id_t> nodes(graph.num_nodes());
-            std::iota(nodes.begin(), nodes.end(), 0);
+            std::vector<ev::DurationGraph::node_id_t> targets;
+            // number of nodes settled before each target
+            std::vector<std::size_t> positions;
+
+            for (auto group_index : range) {
+                const auto &group = groups[group_index];
+                const auto start = queries[group.front()].start;
+
+                targets.clear();
+                for (auto index : group)
+                    targets.push_back(queries[index].target);
+                std::sort(targets.begin(), targets.end());
+                targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+                std::size_t num_settled = 0;
+                // unreachable targets are ordered after all reachable nodes
+                positions.assign(targets.size(), graph.num_nodes());
+                const auto count_settled = [&](const auto id) {
+                    auto iter = std::lower_bound(targets.begin(), targets.end(), id);
+                    if (iter != targets.end() && *iter == id)
+                        positions[std::distance(targets.begin(), iter)] = num_settled;
+                    ++num_settled;
+                };
+                common::dijkstra_to_targets(start, targets, graph, queue, costs, count_settled);
+
+                for (auto index : group) {
+                    auto &q = queries[index];
+                    auto iter = std::lower_bound(targets.begin(), targets.end(),
+                                                 static_cast<std::uint32_t>(q.target));
+                    auto position =
+                        std::min(positions[std::distance(targets.begin(), iter)], num_settled);
+                    q.rank = std::log2(position + 1);
+                }
+            }
 
-            for (auto index : range) {
-                auto &q = queries[index];
+        },
+        num_threads);
+
+    return queries;
+}
 
-                common::dijkstra_to_all(q.start, graph, queue, costs);
-                std::sort(nodes.begin(), nodes.end(),
-                          [&](const auto lhs, const auto rhs) { return costs[lhs] < costs[rhs]; });
-                auto iter = std::find(nodes.begin(), nodes.end(), q.target);
-                std::uint32_t rank = std::log2(std::distance(nodes.begin(), iter) + 1);
+// Same ranks as make_rank up to ties: Counts the nodes that are closer to the start than
+// the target. The searches of RANK_BATCH_SIZE starts run at once and share one traversal,
+// the starts are ordered along a Hilbert curve so that the starts of a batch are close.
+// This only pays off if there are many starts, for a few starts spread over a large graph
+// the wavefronts don't overlap and make_rank is faster.
+constexpr std::size_t RANK_BATCH_SIZE = 8;
+
+inline auto make_batched_rank(const ev::DurationGraph &graph,
+                              const std::vector<common::Coordinate> &coordinates,
+                              std::vector<Query> queries, const std::size_t num_threads) {
+    using SearchT = common::MultiSourceDijkstra<RANK_BATCH_SIZE, ev::DurationGraph>;
+    using node_id_t = ev::DurationGraph::node_id_t;
+
+    // consecutive groups along the Hilbert curve form a batch
+    auto groups = group_by_start(queries);
+    const auto hilbert_rank = common::hilbertOrder(coordinates);
+    std::sort(groups.begin(), groups.end(), [&](const auto &lhs, const auto &rhs) {
+        return hilbert_rank[queries[lhs.front()].start] < hilbert_rank[queries[rhs.front()].start];
+    });
+    const auto num_batches = (groups.size() + RANK_BATCH_SIZE - 1) / RANK_BATCH_SIZE;
+    auto range = common::irange<std::size_t>(0, num_batches);
 
-                q.rank = rank;
+    common::parallel_for(
+        range,
+        [&](const auto &range) {
+            SearchT search(graph);
+            std::vector<node_id_t> sources;
+            std::vector<std::vector<node_id_t>> targets;
+            std::vector<SearchT::lanes_t> thresholds;
+
+            for (auto batch : range) {
+                const auto first_group = batch * RANK_BATCH_SIZE;
+                const auto last_group = std::min(first_group + RANK_BATCH_SIZE, groups.size());
+
+                sources.clear();
+                targets.resize(last_group - first_group);
+                std::size_t max_group_size = 0;
+                for (auto group_index = first_group; group_index < last_group; ++group_index) {
+                    const auto &group = groups[group_index];
+                    auto &group_targets = targets[group_index - first_group];
+                    sources.push_back(queries[group.front()].start);
+                    group_targets.clear();
+                    for (auto index : group)
+                        group_targets.push_back(queries[index].target);
+                    max_group_size = std::max(max_group_size, group.size());
+                }
+
+                search.run(sources, targets);
+
+                // the i-th query of every group is counted in the i-th threshold,
+                // lanes without a query count nothing
+                thresholds.assign(max_group_size, SearchT::lanes_t::filled(0));
+                for (auto group_index = first_group; group_index < last_group; ++group_index) {
+                    const auto lane = group_index - first_group;
+                    const auto &group = groups[group_index];
+                    for (auto index = 0u; index < group.size(); ++index) {
+                        const auto target = queries[group[index]].target;
+                        thresholds[index].costs[lane] = search.cost(target, lane);
+                    }
+                }
+
+                const auto counts = common::count_smaller(search, thresholds);
+                for (auto group_index = first_group; group_index < last_group; ++group_index) {
+                    const auto lane = group_index - first_group;
+                    const auto &group = groups[group_index];
+                    for (auto index = 0u; index < group.size(); ++index) {
+                        queries[group[index]].rank = std::log2(counts[index].costs[lane] + 1);
+                    }
+                }
             }
-
         },
         num_threads);
 
@@ -43,9 +43,9 @@ class ResultLogger {
         out.flush();
     }
 
-    template <typename QueryT, typename GraphT>
+    template <typename QueryT, typename GraphT, typename QueueT>
     void log(const QueryT &query, const int solution,
-             const ev::DijkstraContext<GraphT> &context) const {
+             const ev::DijkstraContext<GraphT, QueueT> &context) const {
         std::lock_guard<std::mutex> guard{output_mutex};
 
         if (solution == common::INF_WEIGHT) {
@@ -4,6 +4,7 @@
 #include "server/handlers/algorithm_handler.hpp"
 #include "server/nearest_result.hpp"
 #include "server/route_result.hpp"
+#include "server/table_result.hpp"
 
 #include "common/coordinate.hpp"
 #include "common/nearest_neighbour.hpp"
@@ -11,14 +12,25 @@
 #include "ev/graph.hpp"
 #include "ev/charging_function_container.hpp"
 
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
 namespace charge {
 namespace server {
+namespace handlers {
+class Table;
+}
+
+// The query hit its deadline before any route was found
+class QueryTimeout : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
 
 // Thread safe wrapper
 class Charge {
@@ -30,16 +42,34 @@ class Charge {
         FP_DIJKSTRA,
         FPC_DIJKSTRA,
         FPC_PROFILE_DIJKSTRA,
+        // Runs the reverse search on a second thread per query
+        FASTEST_PARALLEL_BI_DIJKSTRA,
     };
 
+    // Single threaded algorithms only, the parallel ones need to be requested explicitly
+    inline static const std::set<Algorithm> ALL_ALGORITHMS{
+        FASTEST_BI_DIJKSTRA, MC_DIJKSTRA,  MCC_DIJKSTRA,
+        FP_DIJKSTRA,         FPC_DIJKSTRA, FPC_PROFILE_DIJKSTRA};
+
+    // Every algorithm answers up to num_contexts queries at the same time,
+    // each context needs its own search memory.
     Charge(const std::string &base_path, const double capacity);
     Charge(const std::string &base_path, const double capacity,
-           const std::set<Algorithm> &algorithms);
+           const std::set<Algorithm> &algorithms, const std::size_t num_contexts = 1);
 
-    std::vector<RouteResult> route(Algorithm algo, std::uint32_t start, std::uint32_t target, bool search_space = false) const;
+    // Searches stop after timeout_ms and return the routes found so far marked as partial.
+    // Throws QueryTimeout if no route was found until then.
+    std::vector<RouteResult>
+    route(Algorithm algo, std::uint32_t start, std::uint32_t target, bool search_space = false,
+          double timeout_ms = std::numeric_limits<double>::infinity()) const;
 
     NearestResult nearest(common::Coordinate coordinate) const;
 
+    // Minimal durations and consumptions between all sources and targets.
+    // The first call builds the table graphs, servers that never answer tables don't pay for them.
+    TableResult table(const std::vector<std::uint32_t> &sources,
+                      const std::vector<std::uint32_t> &targets) const;
+
   private:
     ev::TradeoffGraph graph;
     std::vector<common::Coordinate> coordinates;
@@ -48,6 +78,8 @@ class Charge {
     ev::ChargingFunctionContainer charging_functions;
 
     std::unordered_map<Algorithm, std::shared_ptr<handlers::AlgorithmHandler>> handlers;
+    mutable std::once_flag table_handler_built;
+    mutable std::shared_ptr<handlers::Table> table_handler;
 };
 }
 }
@@ -0,0 +1,55 @@
+#ifndef CHARGE_SERVER_HANDLERS_ANYTIME_HPP
+#define CHARGE_SERVER_HANDLERS_ANYTIME_HPP
+
+#include "server/route_result.hpp"
+
+#include "common/deadline.hpp"
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace charge::server::handlers {
+
+namespace detail {
+// Epsilons of the anytime mode from coarse to fine, the last ones are the default.
+// Coarse epsilons prune a lot more labels and give a feasible charging plan fast.
+inline const std::vector<std::tuple<double, double>> ANYTIME_EPSILONS{
+    {1.6, 16.0}, {0.4, 4.0}, {0.1, 1.0}};
+
+// Without a deadline this only runs with the finest epsilons. Otherwise the answer is refined
+// with smaller epsilons until the deadline expires, the finest complete answer is returned.
+template <typename ContextT, typename ToResultsFn>
+std::vector<RouteResult> anytime_route(ContextT &context, const std::uint32_t start,
+                                       const std::uint32_t target, ToResultsFn to_results) {
+    auto &deadline = common::Deadline::get();
+    const std::size_t first = deadline.is_set() ? 0 : ANYTIME_EPSILONS.size() - 1;
+
+    std::vector<RouteResult> results;
+    for (auto index = first; index < ANYTIME_EPSILONS.size(); ++index) {
+        std::tie(context.x_eps, context.y_eps) = ANYTIME_EPSILONS[index];
+        auto solutions = context(start, target);
+
+        if (deadline.is_expired() && !results.empty()) {
+            // the previous answer is complete for its epsilons and not partial
+            deadline.reset();
+            break;
+        }
+
+        results = to_results(solutions);
+        for (auto &result : results) {
+            result.x_epsilon = context.x_eps;
+            result.y_epsilon = context.y_eps;
+        }
+
+        // a coarse run can prune the only label that fits the battery, so even without a
+        // route the finer epsilons are tried as long as the deadline allows
+        if (deadline.is_expired())
+            break;
+    }
+    return results;
+}
+} // namespace detail
+} // namespace charge::server::handlers
+
+#endif
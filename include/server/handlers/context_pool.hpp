@@ -0,0 +1,100 @@
+#ifndef CHARGE_SERVER_HANDLERS_CONTEXT_POOL_HPP
+#define CHARGE_SERVER_HANDLERS_CONTEXT_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace charge::server::handlers {
+
+// Bounded pool of query contexts so a handler can answer queries on multiple threads.
+// The contexts only hold references to the graphs of the handler, every context adds its own
+// queues, labels and potentials. Contexts are created on first use, once max_size contexts are
+// checked out further queries wait until one is returned.
+template <typename ContextT> class ContextPool {
+  public:
+    using factory_t = std::function<std::unique_ptr<ContextT>()>;
+
+    // Returns the context to its pool on destruction
+    class Handle {
+      public:
+        Handle(ContextPool &pool, std::unique_ptr<ContextT> context)
+            : pool(&pool), context(std::move(context)) {}
+        Handle(Handle &&) = default;
+        Handle &operator=(Handle &&) = delete;
+        ~Handle() {
+            if (context)
+                pool->checkin(std::move(context));
+        }
+
+        ContextT &operator*() const { return *context; }
+        ContextT *operator->() const { return context.get(); }
+
+      private:
+        ContextPool *pool;
+        std::unique_ptr<ContextT> context;
+    };
+
+    ContextPool(const std::size_t max_size, factory_t make_context)
+        : max_size(std::max<std::size_t>(max_size, 1)), make_context(std::move(make_context)) {
+        // the first query should not pay for the allocation
+        idle.push_back(this->make_context());
+        num_created = 1;
+    }
+
+    Handle checkout() {
+        std::unique_lock<std::mutex> lock(mutex);
+        returned.wait(lock, [this] { return !idle.empty() || num_created < max_size; });
+
+        if (!idle.empty()) {
+            auto context = std::move(idle.back());
+            idle.pop_back();
+            return Handle{*this, std::move(context)};
+        }
+
+        ++num_created;
+        lock.unlock();
+        try {
+            return Handle{*this, make_context()};
+        } catch (...) {
+            lock.lock();
+            --num_created;
+            lock.unlock();
+            returned.notify_one();
+            throw;
+        }
+    }
+
+    // Number of contexts that were created so far
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return num_created;
+    }
+
+    std::size_t capacity() const { return max_size; }
+
+  private:
+    void checkin(std::unique_ptr<ContextT> context) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            idle.push_back(std::move(context));
+        }
+        returned.notify_one();
+    }
+
+    const std::size_t max_size;
+    const factory_t make_context;
+
+    // protected by this mutex
+    mutable std::mutex mutex;
+    std::condition_variable returned;
+    std::vector<std::unique_ptr<ContextT>> idle;
+    std::size_t num_created;
+};
+} // namespace charge::server::handlers
+
+#endif
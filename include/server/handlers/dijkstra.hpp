@@ -2,6 +2,7 @@
 #define CHARGE_SERVER_HANDLERS_DIJKSTRA_HPP
 
 #include "server/handlers/algorithm_handler.hpp"
+#include "server/handlers/context_pool.hpp"
 #include "server/to_result.hpp"
 
 #include "common/files.hpp"
@@ -11,35 +12,99 @@
 #include "ev/dijkstra.hpp"
 #include "ev/graph_transform.hpp"
 
-#include <mutex>
-
 namespace charge::server::handlers {
 
 class Dijkstra : public AlgorithmHandler {
   public:
-    Dijkstra(const ev::TradeoffGraph &tradeoff_graph)
+    Dijkstra(const ev::TradeoffGraph &tradeoff_graph, const std::size_t num_contexts = 1)
         : graph(ev::tradeoff_to_min_duration(tradeoff_graph)),
-          context(tradeoff_graph, graph) {}
+          contexts(num_contexts, [this, &tradeoff_graph] {
+              return std::make_unique<ev::MinDurationDijkstraContetx>(tradeoff_graph, graph);
+          }) {}
 
     std::vector<RouteResult> route(std::uint32_t start, std::uint32_t target, bool search_space) const override final;
 
     const ev::DurationGraph graph;
 
-    // protected by this mutex
-    mutable std::mutex query_mutex;
-    mutable ev::MinDurationDijkstraContetx context;
+    mutable ContextPool<ev::MinDurationDijkstraContetx> contexts;
 };
 
 std::vector<RouteResult> Dijkstra::route(std::uint32_t start, std::uint32_t target, bool) const {
-    std::lock_guard<std::mutex> lock(query_mutex);
+    auto context = contexts.checkout();
+
+    auto cost = (*context)(start, target);
+
+    if (cost == common::INF_WEIGHT) {
+        return {};
+    }
+
+    return {to_result(start, target, context->tradeoff_graph, context->costs, context->parents)};
+}
+
+// Bidirectional Dijkstra with one thread per direction to lower the latency of single queries
+class ParallelDijkstra : public AlgorithmHandler {
+  public:
+    ParallelDijkstra(const ev::TradeoffGraph &tradeoff_graph, const std::size_t num_contexts = 1)
+        : graph(ev::tradeoff_to_min_duration(tradeoff_graph)), reverse_graph(common::invert(graph)),
+          contexts(num_contexts, [this, &tradeoff_graph] {
+              return std::make_unique<ev::MinDurationParallelDijkstraContext>(
+                  tradeoff_graph, graph, reverse_graph);
+          }) {}
+
+    std::vector<RouteResult> route(std::uint32_t start, std::uint32_t target, bool search_space) const override final;
+
+    const ev::DurationGraph graph;
+    const ev::DurationGraph reverse_graph;
+
+    mutable ContextPool<ev::MinDurationParallelDijkstraContext> contexts;
+};
+
+std::vector<RouteResult> ParallelDijkstra::route(std::uint32_t start, std::uint32_t target, bool) const {
+    auto context = contexts.checkout();
+
+    auto cost = (*context)(start, target);
+
+    if (cost == common::INF_WEIGHT) {
+        return {};
+    }
+
+    return {to_result(start, context->middle, target, context->tradeoff_graph,
+                      context->forward_costs, context->reverse_costs, context->forward_parents,
+                      context->reverse_parents)};
+}
+
+// Bidirectional ALT, needs the landmarks created by graph2landmarks
+class ALTDijkstra : public AlgorithmHandler {
+  public:
+    ALTDijkstra(const ev::TradeoffGraph &tradeoff_graph,
+                common::Landmarks<ev::DurationGraph> landmarks_, const std::size_t num_contexts = 1)
+        : graph(ev::tradeoff_to_min_duration(tradeoff_graph)), reverse_graph(common::invert(graph)),
+          landmarks(std::move(landmarks_)), contexts(num_contexts, [this, &tradeoff_graph] {
+              return std::make_unique<ev::MinDurationALTDijkstraContext>(
+                  tradeoff_graph, graph, reverse_graph, landmarks);
+          }) {}
+
+    std::vector<RouteResult> route(std::uint32_t start, std::uint32_t target, bool search_space) const override final;
+
+    const ev::DurationGraph graph;
+    const ev::DurationGraph reverse_graph;
+    const common::Landmarks<ev::DurationGraph> landmarks;
+
+    mutable ContextPool<ev::MinDurationALTDijkstraContext> contexts;
+};
+
+std::vector<RouteResult> ALTDijkstra::route(std::uint32_t start, std::uint32_t target, bool) const {
+    auto context = contexts.checkout();
 
-    auto cost = context(start, target);
+    auto cost = (*context)(start, target);
 
     if (cost == common::INF_WEIGHT) {
         return {};
     }
 
-    return {to_result(start, target, context.tradeoff_graph, context.costs, context.parents)};
+    return {to_result(start, context->middle, target, context->tradeoff_graph,
+                      context->forward_costs, context->reverse_costs, context->forward_parents,
+                      context->reverse_parents)};
 }
 }
 
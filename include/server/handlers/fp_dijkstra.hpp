@@ -2,6 +2,7 @@
 #define CHARGE_SERVER_HANDLERS_FP_DIJKSTRA_HPP
 
 #include "server/handlers/algorithm_handler.hpp"
+#include "server/handlers/context_pool.hpp"
 #include "server/to_result.hpp"
 
 #include "common/graph_transform.hpp"
@@ -9,7 +10,6 @@
 #include "ev/fp_dijkstra.hpp"
 #include "ev/graph_transform.hpp"
 
-#include <mutex>
 #include <tuple>
 
 namespace charge::server::handlers {
@@ -17,10 +17,14 @@ namespace charge::server::handlers {
 class FPDijkstra : public AlgorithmHandler {
   public:
     FPDijkstra(const ev::TradeoffGraph &tradeoff_graph, const double capacity,
-               const std::vector<common::Coordinate> &coordinates)
+               const std::vector<common::Coordinate> &coordinates,
+               const std::size_t num_contexts = 1)
         : coordinates{coordinates},
           reverse_min_duration_graph(common::invert(ev::tradeoff_to_min_duration(tradeoff_graph))),
-          context(0.1, 1.0, capacity, tradeoff_graph, reverse_min_duration_graph) {}
+          contexts(num_contexts, [this, &tradeoff_graph, capacity] {
+              return std::make_unique<ev::FPAStarContext>(0.1, 1.0, capacity, tradeoff_graph,
+                                                          reverse_min_duration_graph);
+          }) {}
 
     std::vector<RouteResult> route(std::uint32_t start, std::uint32_t target,
                                    bool search_space) const override final;
@@ -28,22 +32,20 @@ class FPDijkstra : public AlgorithmHandler {
     const std::vector<common::Coordinate> &coordinates;
     ev::DurationGraph reverse_min_duration_graph;
 
-    // protected by this mutex
-    mutable std::mutex query_mutex;
-    mutable ev::FPAStarContext context;
+    mutable ContextPool<ev::FPAStarContext> contexts;
 };
 
 std::vector<RouteResult> FPDijkstra::route(std::uint32_t start, std::uint32_t target,
                                            bool search_space) const {
-    std::lock_guard<std::mutex> lock(query_mutex);
+    auto context = contexts.checkout();
 
-    auto solutions = context(start, target);
+    auto solutions = (*context)(start, target);
 
     std::vector<RouteResult> results;
     for (const auto &solution : solutions) {
-        results.push_back(to_result(start, target, solution, context.labels));
+        results.push_back(to_result(start, target, solution, context->labels));
         if (search_space) {
-            results.back().search_space = common::get_search_space(context.labels, coordinates);
+            results.back().search_space = common::get_search_space(context->labels, coordinates);
         }
     }
     return results;
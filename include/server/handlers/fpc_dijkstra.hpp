@@ -2,6 +2,8 @@
 #define CHARGE_SERVER_HANDLERS_FPC_DIJKSTRA_HPP
 
 #include "server/handlers/algorithm_handler.hpp"
+#include "server/handlers/anytime.hpp"
+#include "server/handlers/context_pool.hpp"
 #include "server/to_result.hpp"
 
 #include "common/graph_transform.hpp"
@@ -9,7 +11,6 @@
 #include "ev/fpc_dijkstra.hpp"
 #include "ev/graph_transform.hpp"
 
-#include <mutex>
 #include <tuple>
 
 namespace charge::server::handlers {
@@ -21,7 +22,8 @@ class FPCDijkstra : public AlgorithmHandler {
     FPCDijkstra(const ev::TradeoffGraph &tradeoff_graph, const double capacity,
                 const ev::ChargingFunctionContainer &charging_functions,
                 const std::vector<common::Coordinate> &coordinates,
-                const std::vector<std::int32_t> &heights)
+                const std::vector<std::int32_t> &heights,
+                const std::size_t num_contexts = 1)
         : coordinates{coordinates},
           reverse_min_duration_graph(common::invert(ev::tradeoff_to_min_duration(tradeoff_graph))),
           min_consumption_graph(ev::tradeoff_to_min_consumption(tradeoff_graph)),
@@ -30,13 +32,13 @@ class FPCDijkstra : public AlgorithmHandler {
           omega_graph(ev::tradeoff_to_omega_graph(tradeoff_graph, charging_functions.get_min_chargin_rate(CHARGING_PENALTY))),
           shifted_omega_potentials(ev::shift_negative_weights(omega_graph, heights)),
           reverse_omega_graph(common::invert(omega_graph)),
-          context(0.1, 1.0, capacity, CHARGING_PENALTY,
+          contexts(num_contexts, [this, &tradeoff_graph, capacity, &charging_functions] {
+              return std::make_unique<ev::FPCAStarLazyOmegaContext<>>(
+                  0.1, 1.0, capacity, CHARGING_PENALTY,
                   charging_functions.get_min_chargin_rate(CHARGING_PENALTY), tradeoff_graph,
                   charging_functions, reverse_min_duration_graph, reverse_min_consumption_graph,
-                  shifted_consumption_potentials,
-                  reverse_omega_graph, shifted_omega_potentials){}
-    // context(0.1, 1.0, capacity, tradeoff_graph, charging_functions, reverse_min_duration_graph)
-    // {}
+                  shifted_consumption_potentials, reverse_omega_graph, shifted_omega_potentials);
+          }) {}
 
     std::vector<RouteResult> route(std::uint32_t start, std::uint32_t target,
                                    bool search_space) const override final;
@@ -50,27 +52,24 @@ class FPCDijkstra : public AlgorithmHandler {
     std::vector<std::int32_t> shifted_omega_potentials;
     ev::OmegaGraph reverse_omega_graph;
 
-    // protected by this mutex
-    mutable std::mutex query_mutex;
-    mutable ev::FPCAStarLazyOmegaContext context;
-    // mutable ev::FPCAStarFastestContext context;
+    mutable ContextPool<ev::FPCAStarLazyOmegaContext<>> contexts;
 };
 
 std::vector<RouteResult> FPCDijkstra::route(std::uint32_t start, std::uint32_t target,
                                             bool search_space) const {
-    std::lock_guard<std::mutex> lock(query_mutex);
-
-    auto solutions = context(start, target);
-
-    std::vector<RouteResult> results;
-    for (const auto &solution : solutions) {
-        results.push_back(to_result(start, target, solution, context.labels));
-        if (search_space) {
-            results.back().search_space =
-                common::get_search_space(context.labels, context.chargers, coordinates);
+    auto context = contexts.checkout();
+
+    return detail::anytime_route(*context, start, target, [&](const auto &solutions) {
+        std::vector<RouteResult> results;
+        for (const auto &solution : solutions) {
+            results.push_back(to_result(start, target, solution, context->labels));
+            if (search_space) {
+                results.back().search_space =
+                    common::get_search_space(context->labels, context->chargers, coordinates);
+            }
         }
-    }
-    return results;
+        return results;
+    });
 }
 
 class FPCProfileDijkstra : public AlgorithmHandler {
@@ -80,7 +79,8 @@ class FPCProfileDijkstra : public AlgorithmHandler {
     FPCProfileDijkstra(const ev::TradeoffGraph &tradeoff_graph, const double capacity,
                        const ev::ChargingFunctionContainer &charging_functions,
                        const std::vector<common::Coordinate> &coordinates,
-                       const std::vector<std::int32_t> &heights)
+                       const std::vector<std::int32_t> &heights,
+                       const std::size_t num_contexts = 1)
         : coordinates{coordinates},
           reverse_min_duration_graph(common::invert(ev::tradeoff_to_min_duration(tradeoff_graph))),
           min_consumption_graph(ev::tradeoff_to_min_consumption(tradeoff_graph)),
@@ -89,10 +89,13 @@ class FPCProfileDijkstra : public AlgorithmHandler {
           omega_graph(ev::tradeoff_to_omega_graph(tradeoff_graph, charging_functions.get_min_chargin_rate(CHARGING_PENALTY))),
           shifted_omega_potentials(ev::shift_negative_weights(omega_graph, heights)),
           reverse_omega_graph(common::invert(omega_graph)),
-          context(0.1, 1.0, capacity, CHARGING_PENALTY,
+          contexts(num_contexts, [this, &tradeoff_graph, capacity, &charging_functions] {
+              return std::make_unique<ev::FPCProfileAStarLazyOmegaContext<>>(
+                  0.1, 1.0, capacity, CHARGING_PENALTY,
                   charging_functions.get_min_chargin_rate(CHARGING_PENALTY), tradeoff_graph,
                   charging_functions, reverse_min_duration_graph, reverse_min_consumption_graph,
-                  shifted_consumption_potentials, reverse_omega_graph, shifted_omega_potentials) {}
+                  shifted_consumption_potentials, reverse_omega_graph, shifted_omega_potentials);
+          }) {}
 
     std::vector<RouteResult> route(std::uint32_t start, std::uint32_t target,
                                    bool search_space) const override final;
@@ -106,26 +109,24 @@ class FPCProfileDijkstra : public AlgorithmHandler {
     std::vector<std::int32_t> shifted_omega_potentials;
     ev::OmegaGraph reverse_omega_graph;
 
-    // protected by this mutex
-    mutable std::mutex query_mutex;
-    mutable ev::FPCProfileAStarLazyOmegaContext context;
+    mutable ContextPool<ev::FPCProfileAStarLazyOmegaContext<>> contexts;
 };
 
 std::vector<RouteResult> FPCProfileDijkstra::route(std::uint32_t start, std::uint32_t target,
                                                    bool search_space) const {
-    std::lock_guard<std::mutex> lock(query_mutex);
-
-    auto solutions = context(start, target);
-
-    std::vector<RouteResult> results;
-    for (const auto &solution : solutions) {
-        results.push_back(to_result(start, target, solution, context.labels));
-        if (search_space) {
-            results.back().search_space =
-                common::get_search_space(context.labels, context.chargers, coordinates);
+    auto context = contexts.checkout();
+
+    return detail::anytime_route(*context, start, target, [&](const auto &solutions) {
+        std::vector<RouteResult> results;
+        for (const auto &solution : solutions) {
+            results.push_back(to_result(start, target, solution, context->labels));
+            if (search_space) {
+                results.back().search_space =
+                    common::get_search_space(context->labels, context->chargers, coordinates);
+            }
         }
-    }
-    return results;
+        return results;
+    });
 }
 } // namespace charge::server::handlers
 
@@ -2,6 +2,7 @@
 #define CHARGE_SERVER_HANDLERS_MC_DIJKSTRA_HPP
 
 #include "server/handlers/algorithm_handler.hpp"
+#include "server/handlers/context_pool.hpp"
 #include "server/to_result.hpp"
 
 #include "common/graph_transform.hpp"
@@ -10,7 +11,6 @@
 #include "ev/graph_transform.hpp"
 #include "ev/mc_dijkstra.hpp"
 
-#include <mutex>
 #include <tuple>
 
 namespace charge::server::handlers {
@@ -18,10 +18,14 @@ namespace charge::server::handlers {
 class MCDijkstra : public AlgorithmHandler {
   public:
     MCDijkstra(const ev::TradeoffGraph &tradeoff_graph, const double capacity,
-               const std::vector<common::Coordinate> &coordinates)
+               const std::vector<common::Coordinate> &coordinates,
+               const std::size_t num_contexts = 1)
         : coordinates{coordinates}, graph(ev::tradeoff_to_sampled_consumption(tradeoff_graph, 10)),
           reverse_min_duration_graph(common::invert(ev::tradeoff_to_min_duration(tradeoff_graph))),
-          context(0.1, 1.0, capacity, graph, reverse_min_duration_graph) {}
+          contexts(num_contexts, [this, capacity] {
+              return std::make_unique<ev::MCAStarContext>(0.1, 1.0, capacity, graph,
+                                                          reverse_min_duration_graph);
+          }) {}
 
     std::vector<RouteResult> route(std::uint32_t start, std::uint32_t target,
                                    bool search_space) const override final;
@@ -30,22 +34,20 @@ class MCDijkstra : public AlgorithmHandler {
     const ev::DurationConsumptionGraph graph;
     const ev::DurationGraph reverse_min_duration_graph;
 
-    // protected by this mutex
-    mutable std::mutex query_mutex;
-    mutable ev::MCAStarContext context;
+    mutable ContextPool<ev::MCAStarContext> contexts;
 };
 
 std::vector<RouteResult> MCDijkstra::route(std::uint32_t start, std::uint32_t target,
                                            bool search_space) const {
-    std::lock_guard<std::mutex> lock(query_mutex);
+    auto context = contexts.checkout();
 
-    auto solutions = context(start, target);
+    auto solutions = (*context)(start, target);
 
     std::vector<RouteResult> results;
     for (const auto &solution : solutions) {
-        results.push_back(to_result(start, target, solution, context.labels));
+        results.push_back(to_result(start, target, solution, context->labels));
         if (search_space) {
-            results.back().search_space = common::get_search_space(context.labels, coordinates);
+            results.back().search_space = common::get_search_space(context->labels, coordinates);
         }
     }
     return results;
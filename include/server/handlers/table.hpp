@@ -0,0 +1,63 @@
+#ifndef CHARGE_SERVER_HANDLERS_TABLE_HPP
+#define CHARGE_SERVER_HANDLERS_TABLE_HPP
+
+#include "server/table_result.hpp"
+
+#include "common/constants.hpp"
+#include "common/graph_transform.hpp"
+#include "common/many_to_many.hpp"
+
+#include "ev/graph.hpp"
+#include "ev/graph_transform.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace charge::server::handlers {
+
+// Minimal duration and minimal consumption tables between two sets of nodes.
+// The consumption ignores the battery constraints of the vehicle.
+class Table {
+  public:
+    Table(const ev::TradeoffGraph &tradeoff_graph, const std::vector<std::int32_t> &heights)
+        : duration_graph(ev::tradeoff_to_min_duration(tradeoff_graph)),
+          reverse_duration_graph(common::invert(duration_graph)),
+          consumption_graph(ev::tradeoff_to_min_consumption(tradeoff_graph)),
+          consumption_potential(ev::shift_negative_weights(consumption_graph, heights)),
+          reverse_consumption_graph(common::invert(consumption_graph)),
+          durations(duration_graph, reverse_duration_graph),
+          consumptions(consumption_graph, reverse_consumption_graph, consumption_potential) {}
+
+    // Safe to call from multiple threads, every call uses its own search data
+    TableResult table(const std::vector<std::uint32_t> &sources,
+                      const std::vector<std::uint32_t> &targets) const {
+        const auto to_floating = [](const auto cost) {
+            return cost == common::INF_WEIGHT ? std::numeric_limits<double>::infinity()
+                                              : common::from_fixed(cost);
+        };
+
+        TableResult result{sources, targets, {}, {}};
+        const auto duration_table = durations(sources, targets);
+        result.durations.resize(duration_table.size());
+        std::transform(duration_table.begin(), duration_table.end(), result.durations.begin(),
+                       to_floating);
+        const auto consumption_table = consumptions(sources, targets);
+        result.consumptions.resize(consumption_table.size());
+        std::transform(consumption_table.begin(), consumption_table.end(),
+                       result.consumptions.begin(), to_floating);
+
+        return result;
+    }
+
+  private:
+    const ev::DurationGraph duration_graph;
+    const ev::DurationGraph reverse_duration_graph;
+    ev::ConsumptionGraph consumption_graph;
+    const std::vector<std::int32_t> consumption_potential;
+    const ev::ConsumptionGraph reverse_consumption_graph;
+    const common::ManyToMany<ev::DurationGraph> durations;
+    const common::ManyToMany<ev::ConsumptionGraph> consumptions;
+};
+}
+
+#endif
@@ -6,18 +6,23 @@
 
 #include <httplib.hpp>
 
+#include <charconv>
+#include <limits>
 #include <optional>
 #include <sstream>
+#include <system_error>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace charge::server {
 namespace detail {
 
-inline void error(httplib::Response &res, const std::string &msg) {
+inline void error(httplib::Response &res, const std::string &msg, const int status = 400) {
     std::ostringstream ss;
     ss << "{\"error\":\"" << msg << "\"}";
     res.set_content(ss.str(), "application/json");
-    res.status = 400;
+    res.status = status;
 }
 
 template <typename T>
@@ -82,6 +87,8 @@ param<Charge::Algorithm>(const httplib::Request &req, httplib::Response &res, co
     auto value = req.get_param_value(name);
     if (value == "fastest_bi_dijkstra") {
         return Charge::Algorithm::FASTEST_BI_DIJKSTRA;
+    } else if (value == "fastest_parallel_bi_dijkstra") {
+        return Charge::Algorithm::FASTEST_PARALLEL_BI_DIJKSTRA;
     } else if (value == "mc_dijkstra") {
         return Charge::Algorithm::MC_DIJKSTRA;
     } else if (value == "mcc_dijkstra") {
@@ -110,6 +117,34 @@ inline std::optional<double> param<double>(const httplib::Request &req, httplib:
     return std::stof(req.get_param_value(name));
 }
 
+// Comma separated list of node ids, e.g. 1,42,7
+template <>
+inline std::optional<std::vector<std::uint32_t>>
+param<std::vector<std::uint32_t>>(const httplib::Request &req, httplib::Response &res,
+                                  const std::string &name, bool optional) {
+    if (!req.has_param(name)) {
+        if (!optional)
+            error(res, "Parameter not found: " + name);
+        return {};
+    }
+
+    auto value = req.get_param_value(name);
+    std::vector<std::uint32_t> ids;
+    std::istringstream ss(value);
+    std::string id;
+    while (std::getline(ss, id, ',')) {
+        // from_chars fails on values that don't fit into 32 bit instead of truncating them
+        std::uint32_t parsed;
+        const auto[end, status] = std::from_chars(id.data(), id.data() + id.size(), parsed);
+        if (id.empty() || status != std::errc() || end != id.data() + id.size()) {
+            error(res, "Parameter has invalid value: " + name + " = " + value);
+            return {};
+        }
+        ids.push_back(parsed);
+    }
+    return ids;
+}
+
 inline void handle_route(const Charge &charge, const httplib::Request &req, httplib::Response &res) {
     auto algorithm = param<Charge::Algorithm>(req, res, "algorithm");
     auto start = param<int>(req, res, "start");
@@ -121,13 +156,22 @@ inline void handle_route(const Charge &charge, const httplib::Request &req, http
     if (!search_space)
         search_space = false;
 
-    auto routes = charge.route(*algorithm, *start, *target, *search_space);
-    if (routes.empty()) {
-        error(res, "No route found.");
-    } else {
-        std::ostringstream ss;
-        ss << to_json(*start, *target, routes);
-        res.set_content(ss.str(), "application/json");
+    // searches that take longer return the routes found so far or fail with 503
+    auto timeout_ms = param<double>(req, res, "timeout_ms", true);
+    if (!timeout_ms)
+        timeout_ms = std::numeric_limits<double>::infinity();
+
+    try {
+        auto routes = charge.route(*algorithm, *start, *target, *search_space, *timeout_ms);
+        if (routes.empty()) {
+            error(res, "No route found.");
+        } else {
+            std::ostringstream ss;
+            ss << to_json(*start, *target, routes);
+            res.set_content(ss.str(), "application/json");
+        }
+    } catch (const QueryTimeout &e) {
+        error(res, e.what(), 503);
     }
 }
 
@@ -142,6 +186,21 @@ inline void handle_nearest(const Charge &charge, const httplib::Request &req, ht
     ss << to_json(nearest);
     res.set_content(ss.str(), "application/json");
 }
+inline void handle_table(const Charge &charge, const httplib::Request &req, httplib::Response &res) {
+    auto sources = param<std::vector<std::uint32_t>>(req, res, "sources");
+    auto targets = param<std::vector<std::uint32_t>>(req, res, "targets");
+    if (!sources || !targets)
+        return;
+
+    try {
+        auto table = charge.table(*sources, *targets);
+        std::ostringstream ss;
+        ss << to_json(table);
+        res.set_content(ss.str(), "application/json");
+    } catch (const std::runtime_error &e) {
+        error(res, e.what());
+    }
+}
 } // namespace detail
 
 class HTTPServer {
@@ -153,6 +212,9 @@ class HTTPServer {
         server.Get("/nearest", [&](const httplib::Request &req, httplib::Response &res) {
             detail::handle_nearest(charge, req, res);
         });
+        server.Get("/table", [&](const httplib::Request &req, httplib::Response &res) {
+            detail::handle_table(charge, req, res);
+        });
 
         worker_thread = std::thread([this, port]() {
             server.listen("0.0.0.0", port);
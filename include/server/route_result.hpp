@@ -21,6 +21,9 @@ struct RouteResult {
     std::vector<common::Coordinate> geometry;  // lon,lat coordinates
     std::vector<std::int32_t> heights;         // height in meters
     std::vector<common::SearchSpaceNode> search_space; // nodes in the search space
+    bool partial = false; // search hit its deadline, other tradeoffs might be missing
+    double x_epsilon = 0; // duration epsilon in s of the domination, 0 for exact searches
+    double y_epsilon = 0; // consumption epsilon of the domination
 };
 }
 
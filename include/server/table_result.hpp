@@ -0,0 +1,16 @@
+#ifndef CHARGE_SERVER_TABLE_RESULT_HPP
+#define CHARGE_SERVER_TABLE_RESULT_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace charge::server {
+struct TableResult {
+    std::vector<std::uint32_t> sources;  // node ids of the rows
+    std::vector<std::uint32_t> targets;  // node ids of the columns
+    std::vector<double> durations;       // minimal durations in s, row-major, inf if unreachable
+    std::vector<double> consumptions;    // minimal consumptions in Wh, row-major, inf if unreachable
+};
+}
+
+#endif
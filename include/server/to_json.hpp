@@ -7,8 +7,13 @@
 
 #include "server/nearest_result.hpp"
 #include "server/route_result.hpp"
+#include "server/table_result.hpp"
 
 #include <json.hpp>
+
+#include <algorithm>
+#include <cmath>
+
 using json = nlohmann::json;
 
 namespace charge::server {
@@ -55,6 +60,8 @@ auto to_json(const std::int32_t start, const std::int32_t target, const std::vec
         }
         j["geometry"] = geometry;
         j["search_space"] = common::search_space_to_geojson(route.search_space);
+        if (route.x_epsilon > 0 || route.y_epsilon > 0)
+            j["epsilon"] = {{"duration", route.x_epsilon}, {"consumption", route.y_epsilon}};
         results.push_back(j);
     }
 
@@ -62,9 +69,37 @@ auto to_json(const std::int32_t start, const std::int32_t target, const std::vec
     response["routes"] = results;
     response["start"] = start;
     response["target"] = target;
+    if (std::any_of(routes.begin(), routes.end(), [](const auto &route) { return route.partial; }))
+        response["partial"] = true;
     return response;
 }
 
+// Unreachable entries are null
+auto to_json(const TableResult &table) {
+    const auto to_matrix = [&table](const std::vector<double> &values) {
+        auto matrix = json::array();
+        for (auto row = 0u; row < table.sources.size(); ++row) {
+            auto entries = json::array();
+            for (auto column = 0u; column < table.targets.size(); ++column) {
+                const auto value = values[row * table.targets.size() + column];
+                if (std::isinf(value))
+                    entries.push_back(nullptr);
+                else
+                    entries.push_back(value);
+            }
+            matrix.push_back(entries);
+        }
+        return matrix;
+    };
+
+    json j;
+    j["sources"] = table.sources;
+    j["targets"] = table.targets;
+    j["durations"] = to_matrix(table.durations);
+    j["consumptions"] = to_matrix(table.consumptions);
+    return j;
+}
+
 auto to_json(NearestResult nearest) {
     json j;
     j["id"] = nearest.id;
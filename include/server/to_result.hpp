@@ -53,29 +53,64 @@ inline void annotate_max_speeds(RouteResult &route, const ev::TradeoffGraph& gra
     }
 }
 
-template <typename NodeLabelsT>
-RouteResult to_result(ev::TradeoffGraph::node_id_t start, ev::TradeoffGraph::node_id_t target,
-                      const ev::TradeoffLabelEntryWithParent &last_label, const NodeLabelsT &labels) {
-    RouteResult route;
-    route.tradeoff = last_label.cost;
-    auto[path, path_labels] = common::get_path_with_labels(start, target, last_label, labels);
-    route.path = std::move(path);
+namespace detail {
+// Fills in durations and consumptions by walking the path back from the minimal total duration,
+// delta_of(index) maps the duration at path_labels[index] to the duration at its parent
+template <typename PathLabelsT, typename DeltaFn>
+void set_tradeoff_durations(RouteResult &route, const double min_duration,
+                            const PathLabelsT &path_labels, DeltaFn delta_of) {
     route.durations.reserve(route.path.size());
     route.consumptions.reserve(route.path.size());
 
-    // minimal total time
-    auto current_duration = last_label.cost.min_x();
+    auto current_duration = min_duration;
     for (int index = path_labels.size() - 1; index >= 0; index--) {
         const auto &label = path_labels[index];
+        const auto &delta = delta_of(index);
         route.durations.push_back(current_duration);
         route.consumptions.push_back(label.cost(std::max(label.cost.min_x(), current_duration)));
         // we need to take the maximum in case we run into numeric issues
         // around the minumum
-        current_duration = label.delta(std::max(label.delta.min_x(), current_duration));
+        current_duration = delta(std::max(delta.min_x(), current_duration));
         assert(std::isfinite(current_duration));
     }
     std::reverse(route.consumptions.begin(), route.consumptions.end());
     std::reverse(route.durations.begin(), route.durations.end());
+}
+} // namespace detail
+
+template <typename NodeLabelsT>
+RouteResult to_result(ev::TradeoffGraph::node_id_t start, ev::TradeoffGraph::node_id_t target,
+                      const ev::TradeoffLabelEntryWithParent &last_label, const NodeLabelsT &labels) {
+    RouteResult route;
+    route.tradeoff = last_label.cost;
+    auto[path, path_labels] = common::get_path_with_labels(start, target, last_label, labels);
+    route.path = std::move(path);
+
+    // minimal total time
+    detail::set_tradeoff_durations(route, last_label.cost.min_x(), path_labels,
+                                   [&](const auto index) -> const auto & {
+                                       return path_labels[index].delta;
+                                   });
+
+    return route;
+}
+
+// The labels do not store their deltas, they are recomputed with the graph and policy of the search
+template <typename NodeLabelsT, typename GraphT, typename PolicyT>
+RouteResult to_result(ev::TradeoffGraph::node_id_t start, ev::TradeoffGraph::node_id_t target,
+                      const ev::TradeoffLabelEntryWithParentOnly &last_label,
+                      const NodeLabelsT &labels, const GraphT &graph, const PolicyT &policy) {
+    RouteResult route;
+    route.tradeoff = last_label.cost;
+    auto[path, path_labels, deltas] =
+        common::get_path_with_deltas(start, target, last_label, labels, graph, policy);
+    route.path = std::move(path);
+
+    // minimal total time
+    detail::set_tradeoff_durations(route, last_label.cost.min_x(), path_labels,
+                                   [&](const auto index) -> const auto & {
+                                       return deltas[index];
+                                   });
 
     return route;
 }
@@ -100,20 +135,30 @@ RouteResult to_result(ev::DurationConsumptionGraph::node_id_t start,
     return route;
 }
 
-inline RouteResult to_result(ev::DurationGraph::node_id_t start,
-                             ev::DurationGraph::node_id_t target,
-                             const ev::TradeoffGraph &tradeoff_graph,
-                             const common::CostVector<ev::DurationGraph> &costs,
-                             const common::ParentVector<ev::DurationGraph> &parents) {
-
+template <typename NodeLabelsT>
+RouteResult to_result(ev::DurationConsumptionGraph::node_id_t start,
+                      ev::DurationConsumptionGraph::node_id_t target,
+                      const ev::DurationConsumptionMeetingLabel &solution,
+                      const NodeLabelsT &labels) {
     RouteResult route;
-    std::vector<ev::DurationGraph::weight_t> path_costs;
-    std::tie(route.path, path_costs) = common::get_path_with_labels<ev::DurationGraph>(
-        start, target, parents, costs);
-    route.durations.resize(path_costs.size());
-    std::transform(path_costs.begin(), path_costs.end(), route.durations.begin(),
-                   [](const auto cost) { return common::from_fixed(cost); });
+    auto duration = common::from_fixed(std::get<0>(solution.cost));
+    auto consumption = common::from_fixed(std::get<1>(solution.cost));
+    route.tradeoff = ev::make_constant(duration, consumption);
+    auto[path, path_costs] = common::get_path_with_costs(start, target, solution, labels);
+    route.path = std::move(path);
+    route.durations.reserve(route.path.size());
+    route.consumptions.reserve(route.path.size());
+    for (const auto &cost : path_costs) {
+        route.durations.push_back(common::from_fixed(std::get<0>(cost)));
+        route.consumptions.push_back(common::from_fixed(std::get<1>(cost)));
+    }
+    return route;
+}
 
+namespace detail {
+// Fills in the consumptions of a fastest path, the durations need to be set
+inline void add_min_duration_consumptions(RouteResult &route,
+                                          const ev::TradeoffGraph &tradeoff_graph) {
     auto total_consumption = 0;
     route.consumptions.push_back(total_consumption);
     for (auto index : common::irange<std::size_t>(0, route.path.size() - 1)) {
@@ -132,6 +177,48 @@ inline RouteResult to_result(ev::DurationGraph::node_id_t start,
     }
 
     route.tradeoff = ev::make_constant(route.durations.back(), route.consumptions.back());
+}
+
+inline void set_durations(RouteResult &route,
+                          const std::vector<ev::DurationGraph::weight_t> &path_costs) {
+    route.durations.resize(path_costs.size());
+    std::transform(path_costs.begin(), path_costs.end(), route.durations.begin(),
+                   [](const auto cost) { return common::from_fixed(cost); });
+}
+} // namespace detail
+
+inline RouteResult to_result(ev::DurationGraph::node_id_t start,
+                             ev::DurationGraph::node_id_t target,
+                             const ev::TradeoffGraph &tradeoff_graph,
+                             const common::CostVector<ev::DurationGraph> &costs,
+                             const common::ParentVector<ev::DurationGraph> &parents) {
+
+    RouteResult route;
+    std::vector<ev::DurationGraph::weight_t> path_costs;
+    std::tie(route.path, path_costs) = common::get_path_with_labels<ev::DurationGraph>(
+        start, target, parents, costs);
+    detail::set_durations(route, path_costs);
+    detail::add_min_duration_consumptions(route, tradeoff_graph);
+
+    return route;
+}
+
+inline RouteResult to_result(ev::DurationGraph::node_id_t start,
+                             ev::DurationGraph::node_id_t middle,
+                             ev::DurationGraph::node_id_t target,
+                             const ev::TradeoffGraph &tradeoff_graph,
+                             const common::CostVector<ev::DurationGraph> &forward_costs,
+                             const common::CostVector<ev::DurationGraph> &reverse_costs,
+                             const common::ParentVector<ev::DurationGraph> &forward_parents,
+                             const common::ParentVector<ev::DurationGraph> &reverse_parents) {
+
+    RouteResult route;
+    std::vector<ev::DurationGraph::weight_t> path_costs;
+    std::tie(route.path, path_costs) = common::get_path_with_labels<ev::DurationGraph>(
+        start, middle, target, forward_parents, reverse_parents, forward_costs, reverse_costs);
+    detail::set_durations(route, path_costs);
+    detail::add_min_duration_consumptions(route, tradeoff_graph);
+
     return route;
 }
 }
@@ -0,0 +1,134 @@
+#include "common/dijkstra.hpp"
+#include "common/dont_optimize_away.hpp"
+#include "common/files.hpp"
+#include "common/fp_dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/packed_graph.hpp"
+#include "common/timed_logger.hpp"
+
+#include "ev/fp_dijkstra.hpp"
+#include "ev/graph.hpp"
+#include "ev/graph_transform.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace charge;
+
+namespace {
+template <typename FnT> double time_ms(FnT fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    auto diff = std::chrono::high_resolution_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(diff).count() / 1000.;
+}
+
+// One-to-all searches on the scalar duration weights
+template <typename GraphT>
+double run_dijkstra(const GraphT &graph, const std::vector<typename GraphT::node_id_t> &sources,
+                    common::CostVector<GraphT> &costs) {
+    common::MinIDQueue queue(graph.num_nodes());
+    return time_ms([&] {
+        for (const auto source : sources) {
+            common::dijkstra_to_all(source, graph, queue, costs);
+            common::dont_optimize_away(costs[source]);
+        }
+    });
+}
+
+// Point-to-point function propagation on the tradeoff weights, returns the time and the number
+// of tradeoff functions at the targets to cross check both layouts
+template <typename GraphT>
+std::tuple<double, std::size_t>
+run_fp(const GraphT &graph, const double capacity,
+       const std::vector<std::tuple<ev::TradeoffGraph::node_id_t, ev::TradeoffGraph::node_id_t>>
+           &queries) {
+    using LabelEntryT =
+        common::LabelEntry<ev::TradeoffGraph::weight_t, ev::TradeoffGraph::node_id_t>;
+    using PolicyT = ev::TradeoffDijkstraPolicy<LabelEntryT>;
+    using NodePotentialsT = common::ZeroNodePotentials<ev::TradeoffGraph>;
+
+    common::MinIDQueue queue(graph.num_nodes());
+    common::NodeLabels<PolicyT> labels(graph.num_nodes());
+    const PolicyT policy{0.1, 1.0, capacity};
+
+    std::size_t num_results = 0;
+    const auto time = time_ms([&] {
+        for (const auto &[start, target] : queries) {
+            const auto results =
+                common::fp_dijkstra(start, target, ev::make_constant(0, 0), graph, queue, labels,
+                                    NodePotentialsT{}, policy);
+            num_results += results.size();
+        }
+    });
+    return std::make_tuple(time, num_results);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << argv[0] << " GRAPH_BASE_PATH CAPACITY NUM_QUERIES [SEED]" << std::endl;
+        std::cerr << "Example:" << argv[0] << " data/luxev 16000 100 1337" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string graph_base = argv[1];
+    const double capacity = std::stof(argv[2]);
+    const std::size_t num_queries = std::stoi(argv[3]);
+    std::size_t seed = 1337;
+    if (argc > 4)
+        seed = std::stoi(argv[4]);
+
+    common::TimedLogger load_timer("Loading graph");
+    const auto graph = ev::TradeoffGraph{
+        common::files::read_weighted_graph<ev::TradeoffGraph::weight_t>(graph_base)};
+    load_timer.finished();
+
+    common::TimedLogger setup_timer("Packing graphs");
+    const auto duration_graph = ev::tradeoff_to_min_duration(graph);
+    const common::PackedWeightedGraph<ev::DurationGraph::weight_t> packed_duration_graph{
+        duration_graph};
+    const ev::PackedTradeoffGraph packed_graph{graph};
+    setup_timer.finished();
+
+    std::default_random_engine generator(seed);
+    std::uniform_int_distribution<ev::TradeoffGraph::node_id_t> distribution(
+        0, graph.num_nodes() - 1);
+    std::vector<ev::TradeoffGraph::node_id_t> sources(num_queries);
+    std::vector<std::tuple<ev::TradeoffGraph::node_id_t, ev::TradeoffGraph::node_id_t>> queries(
+        num_queries);
+    for (auto index : common::irange<std::size_t>(0, num_queries)) {
+        sources[index] = distribution(generator);
+        queries[index] = std::make_tuple(sources[index], distribution(generator));
+    }
+
+    common::CostVector<ev::DurationGraph> costs(graph.num_nodes(), common::INF_WEIGHT);
+    common::CostVector<decltype(packed_duration_graph)> packed_costs(graph.num_nodes(),
+                                                                     common::INF_WEIGHT);
+    const auto dijkstra_time = run_dijkstra(duration_graph, sources, costs);
+    const auto packed_dijkstra_time = run_dijkstra(packed_duration_graph, sources, packed_costs);
+    // only check the last search, we don't want to keep all results around
+    for (const auto node : duration_graph.nodes()) {
+        if (costs[node] != packed_costs[node]) {
+            throw std::runtime_error("Layouts disagree on the duration graph at node " +
+                                     std::to_string(node));
+        }
+    }
+
+    const auto[fp_time, fp_results] = run_fp(graph, capacity, queries);
+    const auto[packed_fp_time, packed_fp_results] = run_fp(packed_graph, capacity, queries);
+    if (fp_results != packed_fp_results) {
+        throw std::runtime_error("Layouts disagree on the tradeoff graph");
+    }
+
+    std::cout << "duration: WeightedGraph " << dijkstra_time / num_queries << " ms/query, "
+              << "PackedWeightedGraph " << packed_dijkstra_time / num_queries << " ms/query ("
+              << dijkstra_time / packed_dijkstra_time << "x)" << std::endl;
+    std::cout << "tradeoff: TradeoffGraph " << fp_time / num_queries << " ms/query, "
+              << "PackedTradeoffGraph " << packed_fp_time / num_queries << " ms/query ("
+              << fp_time / packed_fp_time << "x)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+#include "common/files.hpp"
+#include "common/id_queue.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/timed_logger.hpp"
+
+#include "ev/charging_function_container.hpp"
+#include "ev/files.hpp"
+#include "ev/graph.hpp"
+#include "ev/graph_transform.hpp"
+#include "ev/mc_dijkstra.hpp"
+#include "ev/mcc_dijkstra.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace charge;
+
+namespace {
+using queries_t = std::vector<
+    std::tuple<ev::DurationConsumptionGraph::node_id_t, ev::DurationConsumptionGraph::node_id_t>>;
+
+// Runs all queries with the given queue (MinIDQueue or LabelHeap), returns the total time in ms
+// and the Pareto sets of all queries
+template <typename QueueT, typename PolicyT>
+auto run_queries(const ev::DurationConsumptionGraph &graph, const queries_t &queries,
+                 const PolicyT &policy) {
+    QueueT queue(graph.num_nodes());
+    common::NodeLabels<PolicyT> labels(graph.num_nodes());
+    std::vector<std::vector<typename PolicyT::label_t>> results;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto &[source, target] : queries) {
+        results.push_back(common::mc_dijkstra(source, target, graph, queue, labels, policy));
+    }
+    auto diff = std::chrono::high_resolution_clock::now() - start;
+
+    const auto time = std::chrono::duration_cast<std::chrono::microseconds>(diff).count() / 1000.;
+    return std::make_tuple(time, std::move(results));
+}
+
+template <typename PolicyT>
+void compare_engines(const std::string &name, const ev::DurationConsumptionGraph &graph,
+                     const queries_t &queries, const PolicyT &policy) {
+    using LabelHeapT = common::LabelHeap<typename PolicyT::label_t>;
+    const auto[queue_time, queue_results] =
+        run_queries<common::MinIDQueue>(graph, queries, policy);
+    const auto[heap_time, heap_results] = run_queries<LabelHeapT>(graph, queries, policy);
+
+    // with epsilon dominance the settle order decides which labels represent a tradeoff, so
+    // only the sizes of the Pareto sets are reported and not compared
+    std::size_t num_queue_solutions = 0;
+    std::size_t num_heap_solutions = 0;
+    for (const auto index : common::irange<std::size_t>(0, queries.size())) {
+        num_queue_solutions += queue_results[index].size();
+        num_heap_solutions += heap_results[index].size();
+    }
+
+    std::cout << name << ": node queue " << queue_time / queries.size() << " ms/query ("
+              << num_queue_solutions / (double)queries.size() << " solutions/query), "
+              << "label heap " << heap_time / queries.size() << " ms/query ("
+              << queue_time / heap_time << "x, " << num_heap_solutions / (double)queries.size()
+              << " solutions/query)" << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << argv[0]
+                  << " GRAPH_BASE_PATH CAPACITY NUM_QUERIES [SEED] [SAMPLE_RESOLUTION] "
+                     "[CHARGING_PENALTY]"
+                  << std::endl;
+        std::cerr << "Example:" << argv[0] << " data/luxev 16000 100 1337 10 60" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string graph_base = argv[1];
+    const double capacity = std::stof(argv[2]);
+    const std::size_t num_queries = std::stoi(argv[3]);
+    std::size_t seed = 1337;
+    if (argc > 4)
+        seed = std::stoi(argv[4]);
+    double sample_resolution = 10.;
+    if (argc > 5)
+        sample_resolution = std::stof(argv[5]);
+    double charging_penalty = 60.;
+    if (argc > 6)
+        charging_penalty = std::stof(argv[6]);
+
+    common::TimedLogger load_timer("Loading graph");
+    const auto tradeoff_graph = ev::TradeoffGraph{
+        common::files::read_weighted_graph<ev::TradeoffGraph::weight_t>(graph_base)};
+    const auto graph = ev::tradeoff_to_sampled_consumption(tradeoff_graph, sample_resolution);
+    ev::ChargingFunctionContainer charging_functions{ev::files::read_charger(graph_base),
+                                                     ev::ChargingModel{capacity}};
+    load_timer.finished();
+
+    std::default_random_engine generator(seed);
+    std::uniform_int_distribution<ev::DurationConsumptionGraph::node_id_t> distribution(
+        0, graph.num_nodes() - 1);
+    queries_t queries(num_queries);
+    for (auto &[source, target] : queries) {
+        source = distribution(generator);
+        target = distribution(generator);
+    }
+
+    const auto x_eps = common::to_fixed(0.1);
+    const auto y_eps = common::to_fixed(1.0);
+    compare_engines("MC", graph, queries,
+                    ev::DurationConsumptionDijkstraPolicyWithParents{
+                        x_eps, y_eps, common::to_fixed(capacity)});
+    compare_engines("MCC", graph, queries,
+                    ev::DurationConsumptionChargingDijkstraPolicyWithParents{
+                        x_eps, y_eps, common::to_fixed(capacity),
+                        common::to_fixed(charging_penalty), charging_functions,
+                        sample_resolution});
+
+    return EXIT_SUCCESS;
+}
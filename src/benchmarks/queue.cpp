@@ -0,0 +1,130 @@
+#include "common/delta_stepping.hpp"
+#include "common/dijkstra.hpp"
+#include "common/dont_optimize_away.hpp"
+#include "common/files.hpp"
+#include "common/graph_transform.hpp"
+#include "common/id_queue.hpp"
+#include "common/radix_id_queue.hpp"
+#include "common/soa_id_queue.hpp"
+#include "common/timed_logger.hpp"
+
+#include "ev/charging_function_container.hpp"
+#include "ev/files.hpp"
+#include "ev/graph.hpp"
+#include "ev/graph_transform.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace charge;
+
+namespace {
+// Runs one-to-all searches from all sources and returns the total time in ms
+template <typename QueueT, typename GraphT>
+double run_searches(const GraphT &graph, const std::vector<typename GraphT::node_id_t> &sources,
+                    common::CostVector<GraphT> &costs) {
+    QueueT queue(graph.num_nodes());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto source : sources) {
+        common::dijkstra_to_all(source, graph, queue, costs);
+        common::dont_optimize_away(costs[source]);
+    }
+    auto diff = std::chrono::high_resolution_clock::now() - start;
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(diff).count() / 1000.;
+}
+
+template <typename GraphT>
+void compare_queues(const std::string &name, const GraphT &graph,
+                    const std::vector<typename GraphT::node_id_t> &sources) {
+    common::CostVector<GraphT> heap_costs(graph.num_nodes(), common::INF_WEIGHT);
+    common::CostVector<GraphT> radix_costs(graph.num_nodes(), common::INF_WEIGHT);
+    common::CostVector<GraphT> delta_costs(graph.num_nodes(), common::INF_WEIGHT);
+    common::CostVector<GraphT> soa4_costs(graph.num_nodes(), common::INF_WEIGHT);
+    common::CostVector<GraphT> soa8_costs(graph.num_nodes(), common::INF_WEIGHT);
+
+    const auto heap_time = run_searches<common::MinIDQueue>(graph, sources, heap_costs);
+    const auto radix_time = run_searches<common::RadixMinIDQueue>(graph, sources, radix_costs);
+    const auto delta_time = run_searches<common::DeltaStepping>(graph, sources, delta_costs);
+    const auto soa4_time = run_searches<common::SoAMinIDQueue<4>>(graph, sources, soa4_costs);
+    const auto soa8_time = run_searches<common::SoAMinIDQueue<8>>(graph, sources, soa8_costs);
+
+    // only check the last search, we don't want to keep all results around
+    for (const auto node : graph.nodes()) {
+        if (heap_costs[node] != radix_costs[node] || heap_costs[node] != delta_costs[node] ||
+            heap_costs[node] != soa4_costs[node] || heap_costs[node] != soa8_costs[node]) {
+            throw std::runtime_error("Queues disagree on " + name + " graph at node " +
+                                     std::to_string(node));
+        }
+    }
+
+    std::cout << name << ": MinIDQueue " << heap_time / sources.size() << " ms/query, "
+              << "RadixMinIDQueue " << radix_time / sources.size() << " ms/query ("
+              << heap_time / radix_time << "x), "
+              << "SoAMinIDQueue<4> " << soa4_time / sources.size() << " ms/query ("
+              << heap_time / soa4_time << "x), "
+              << "SoAMinIDQueue<8> " << soa8_time / sources.size() << " ms/query ("
+              << heap_time / soa8_time << "x), "
+              << "DeltaStepping " << delta_time / sources.size() << " ms/query ("
+              << heap_time / delta_time << "x, " << std::thread::hardware_concurrency()
+              << " threads)" << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << argv[0] << " GRAPH_BASE_PATH CAPACITY NUM_QUERIES [SEED] [CHARGING_PENALTY]"
+                  << std::endl;
+        std::cerr << "Example:" << argv[0] << " data/luxev 16000 1000 1337 60" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string graph_base = argv[1];
+    const double capacity = std::stof(argv[2]);
+    const std::size_t num_queries = std::stoi(argv[3]);
+    std::size_t seed = 1337;
+    if (argc > 4)
+        seed = std::stoi(argv[4]);
+    double charging_penalty = 60.;
+    if (argc > 5)
+        charging_penalty = std::stof(argv[5]);
+
+    common::TimedLogger load_timer("Loading graph");
+    const auto graph = ev::TradeoffGraph{
+        common::files::read_weighted_graph<ev::TradeoffGraph::weight_t>(graph_base)};
+    const auto heights = common::files::read_heights(graph_base);
+    ev::ChargingFunctionContainer charging_functions{ev::files::read_charger(graph_base),
+                                                     ev::ChargingModel{capacity}};
+    load_timer.finished();
+
+    // Same setup as the lazy omega potentials: consumption and omega weights are shifted
+    // to be non-negative, which is a requirement for the radix queue.
+    common::TimedLogger setup_timer("Preparing graphs");
+    const auto min_charging_rate = charging_functions.get_min_chargin_rate(charging_penalty);
+    const auto reverse_duration_graph = common::invert(ev::tradeoff_to_min_duration(graph));
+    auto consumption_graph = ev::tradeoff_to_min_consumption(graph);
+    ev::shift_negative_weights(consumption_graph, heights);
+    const auto reverse_consumption_graph = common::invert(consumption_graph);
+    auto omega_graph = ev::tradeoff_to_omega_graph(graph, min_charging_rate);
+    ev::shift_negative_weights(omega_graph, heights);
+    const auto reverse_omega_graph = common::invert(omega_graph);
+    setup_timer.finished();
+
+    std::default_random_engine generator(seed);
+    std::uniform_int_distribution<ev::DurationGraph::node_id_t> distribution(
+        0, graph.num_nodes() - 1);
+    std::vector<ev::DurationGraph::node_id_t> sources(num_queries);
+    for (auto &s : sources) {
+        s = distribution(generator);
+    }
+
+    compare_queues("duration", reverse_duration_graph, sources);
+    compare_queues("consumption", reverse_consumption_graph, sources);
+    compare_queues("omega", reverse_omega_graph, sources);
+
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #include "experiments/experiment_runner.hpp"
 #include "experiments/files.hpp"
 
+#include "common/delta_stepping.hpp"
 #include "common/files.hpp"
 #include "common/graph_statistics.hpp"
 #include "common/graph_transform.hpp"
@@ -71,6 +72,18 @@ int main(int argc, char **argv) {
             std::move(queries), experiment_log, result_logger, num_runs);
         setup_timer.finished();
 
+        runner.run(threads);
+        runner.summary();
+    } else if (potential == "omega_delta") {
+        // recomputes the potentials with parallel delta-stepping
+        common::TimedLogger setup_timer("Setting up experiment");
+        auto runner = experiments::make_experiment_runner(
+            ev::FPAStarOmegaContext<common::DeltaStepping>{
+                x_eps, y_eps, capacity, min_tradeoff_rate, graph, reverse_min_duration_graph,
+                reverse_consumption_graph, reverse_omega_graph},
+            std::move(queries), experiment_log, result_logger, num_runs);
+        setup_timer.finished();
+
         runner.run(threads);
         runner.summary();
     } else if (potential == "none") {
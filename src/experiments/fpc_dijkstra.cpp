@@ -1,6 +1,7 @@
 #include "experiments/experiment_runner.hpp"
 #include "experiments/files.hpp"
 
+#include "common/delta_stepping.hpp"
 #include "common/files.hpp"
 #include "common/graph_statistics.hpp"
 #include "common/graph_transform.hpp"
@@ -121,6 +122,18 @@ int main(int argc, char **argv) {
         setup_timer.finished();
         runner.run(threads, max_time);
         runner.summary();
+    } else if (potential == "omega_delta") {
+        // recomputes the potentials with parallel delta-stepping
+        common::TimedLogger setup_timer("Setting up experiment");
+        auto runner = experiments::make_experiment_runner(
+            ev::FPCAStarOmegaContext<common::DeltaStepping>{
+                x_eps, y_eps, capacity, charging_penalty, min_charging_rate, graph,
+                charging_functions, reverse_min_duration_graph, reverse_consumption_graph,
+                reverse_omega_graph},
+            std::move(queries), experiment_log, result_logger, num_runs);
+        setup_timer.finished();
+        runner.run(threads, max_time);
+        runner.summary();
     } else if (potential == "fastest") {
         common::TimedLogger setup_timer("Setting up experiment");
         auto runner = experiments::make_experiment_runner(
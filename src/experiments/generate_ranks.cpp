@@ -14,7 +14,7 @@
 int main(int argc, char **argv) {
     if (argc < 5) {
         std::cerr << argv[0]
-                  << " THREADS GRAPH_BASE_PATH QUERIES_PATH RANK_OUT_PATH"
+                  << " THREADS GRAPH_BASE_PATH QUERIES_PATH RANK_OUT_PATH [single|batched]"
                   << std::endl;
         std::cerr << "Example:" << argv[0]
                   << " 2 data/luxev cache/luxev/random_10000_16kw.csv data/luxev/rank_random_10000_16kw.csv"
@@ -26,12 +26,21 @@ int main(int argc, char **argv) {
     const std::string graph_base = argv[2];
     const std::string queries_in_path = argv[3];
     const std::string ranks_out_path = argv[4];
+    // batched only pays off if there are many different starts
+    std::string method = "single";
+    if (argc > 5)
+        method = argv[5];
+    if (method != "single" && method != "batched") {
+        std::cerr << "Unknown rank method " << method << std::endl;
+        return EXIT_FAILURE;
+    }
 
     using namespace charge;
     common::TimedLogger load_timer("Loading graph");
     const auto graph = ev::TradeoffGraph{
         common::files::read_weighted_graph<ev::TradeoffGraph::weight_t>(graph_base)};
     const auto min_duration_graph = ev::tradeoff_to_min_duration(graph);
+    const auto coordinates = common::files::read_coordinates(graph_base);
     load_timer.finished();
 
     std::cerr << common::get_statistics(graph) << std::endl;
@@ -39,7 +48,10 @@ int main(int argc, char **argv) {
     common::TimedLogger setup_timer("Generating queries");
 
     auto queries = experiments::files::read_queries(queries_in_path);
-    auto ranks = experiments::make_rank(min_duration_graph, queries, threads);
+    auto ranks = method == "batched"
+                     ? experiments::make_batched_rank(min_duration_graph, coordinates, queries,
+                                                     threads)
+                     : experiments::make_rank(min_duration_graph, queries, threads);
     experiments::files::write_queries(ranks_out_path, ranks);
 
     setup_timer.finished();
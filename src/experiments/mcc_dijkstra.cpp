@@ -89,6 +89,29 @@ int main(int argc, char **argv) {
             std::move(queries), experiment_log, result_logger, num_runs);
         setup_timer.finished();
 
+        runner.run(threads, max_time);
+        runner.summary();
+    } else if (potential == "none_parallel") {
+        // every query uses all cores, so the queries themselves run one after the other
+        common::TimedLogger setup_timer("Setting up experiment");
+        auto runner = experiments::make_experiment_runner(
+            ev::ParallelMCCDijkstraContext{x_eps, y_eps, sample_resolution, capacity,
+                                           charging_penalty, graph, charging_functions, threads},
+            std::move(queries), experiment_log, result_logger, num_runs);
+        setup_timer.finished();
+
+        runner.run(1, max_time);
+        runner.summary();
+    } else if (potential == "none_bidirectional") {
+        common::TimedLogger setup_timer("Setting up experiment");
+        const auto reverse_graph = common::invert(graph);
+        auto runner = experiments::make_experiment_runner(
+            ev::BidirectionalMCCDijkstraContext{x_eps, y_eps, sample_resolution, capacity,
+                                                charging_penalty, graph, reverse_graph,
+                                                charging_functions},
+            std::move(queries), experiment_log, result_logger, num_runs);
+        setup_timer.finished();
+
         runner.run(threads, max_time);
         runner.summary();
     } else {
@@ -0,0 +1,48 @@
+#include "common/files.hpp"
+#include "common/graph_transform.hpp"
+#include "common/landmarks.hpp"
+#include "common/timed_logger.hpp"
+
+#include "ev/graph.hpp"
+#include "ev/graph_transform.hpp"
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << argv[0] << " GRAPH_BASE_PATH NUM_LANDMARKS [avoid|farthest] [SEED]"
+                  << std::endl;
+        std::cerr << "Example:" << argv[0] << " data/luxev 16 avoid 1337" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string graph_base = argv[1];
+    const std::size_t num_landmarks = std::stoi(argv[2]);
+    std::string method = "avoid";
+    if (argc > 3)
+        method = argv[3];
+    std::size_t seed = 1337;
+    if (argc > 4)
+        seed = std::stoi(argv[4]);
+    using namespace charge;
+
+    common::TimedLogger load_timer("Loading graph");
+    const auto graph = ev::TradeoffGraph{
+        common::files::read_weighted_graph<ev::TradeoffGraph::weight_t>(graph_base)};
+    const auto forward_graph = ev::tradeoff_to_min_duration(graph);
+    const auto reverse_graph = common::invert(forward_graph);
+    load_timer.finished();
+
+    common::TimedLogger select_timer("Selecting " + std::to_string(num_landmarks) + " landmarks (" +
+                                     method + ")");
+    const auto landmarks =
+        common::select_landmarks(method, forward_graph, reverse_graph, num_landmarks, seed);
+    select_timer.finished();
+
+    common::TimedLogger write_timer("Writing landmarks");
+    common::files::write_landmarks(graph_base, landmarks);
+    write_timer.finished();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+#include "common/files.hpp"
+#include "common/graph_transform.hpp"
+#include "common/landmarks.hpp"
+#include "common/timed_logger.hpp"
+
+#include "ev/files.hpp"
+#include "ev/graph.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace charge;
+
+namespace {
+std::vector<std::uint32_t> compute_order(const std::string &method, const ev::TradeoffGraph &graph,
+                                         const std::vector<common::Coordinate> &coordinates) {
+    if (method == "bfs")
+        return common::bfsOrder(graph);
+    else if (method == "dfs")
+        return common::dfsOrder(graph);
+    else if (method == "hilbert")
+        return common::hilbertOrder(coordinates);
+
+    throw std::runtime_error("Unknown order " + method);
+}
+
+// Landmarks store their distances per node, move them along with the nodes
+common::Landmarks<ev::DurationGraph>
+permute_landmarks(common::Landmarks<ev::DurationGraph> landmarks,
+                  const std::vector<std::uint32_t> &old_to_new) {
+    auto[ids, forward_distances, backward_distances] =
+        common::Landmarks<ev::DurationGraph>::unwrap(std::move(landmarks));
+    const auto num_landmarks = ids.size();
+
+    for (auto &id : ids) {
+        id = old_to_new[id];
+    }
+    auto permuted_forward = forward_distances;
+    auto permuted_backward = backward_distances;
+    for (std::size_t node = 0; node < old_to_new.size(); ++node) {
+        for (std::size_t index = 0; index < num_landmarks; ++index) {
+            const auto from = node * num_landmarks + index;
+            const auto to = old_to_new[node] * num_landmarks + index;
+            permuted_forward[to] = forward_distances[from];
+            permuted_backward[to] = backward_distances[from];
+        }
+    }
+
+    return common::Landmarks<ev::DurationGraph>{std::move(ids), std::move(permuted_forward),
+                                                std::move(permuted_backward)};
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << argv[0] << " bfs|dfs|hilbert IN_GRAPH_BASE_PATH OUT_GRAPH_BASE_PATH"
+                  << std::endl;
+        std::cerr << "Example:" << argv[0] << " hilbert data/luxev data/luxev_hilbert" << std::endl;
+        std::cerr << "The turn graph has to be recomputed from the output with graph2turngraph."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string method = argv[1];
+    const std::string in_graph_base = argv[2];
+    const std::string out_graph_base = argv[3];
+
+    common::TimedLogger load_timer("Loading graph");
+    const auto in_graph = ev::TradeoffGraph{
+        common::files::read_weighted_graph<ev::TradeoffGraph::weight_t>(in_graph_base)};
+    const auto in_heights = common::files::read_heights(in_graph_base);
+    const auto in_coordinates = common::files::read_coordinates(in_graph_base);
+    const bool has_charger = std::ifstream(in_graph_base + "/charger").good();
+    const auto in_charger =
+        has_charger ? ev::files::read_charger(in_graph_base) : std::vector<double>{};
+    load_timer.finished();
+
+    common::TimedLogger order_timer("Computing " + method + " order");
+    const auto old_to_new = compute_order(method, in_graph, in_coordinates);
+    order_timer.finished();
+
+    common::TimedLogger permute_timer("Permuting graph");
+    const auto out_graph = common::permuteGraph(in_graph, old_to_new);
+    const auto out_heights = common::permuteNodes(in_heights, old_to_new);
+    const auto out_coordinates = common::permuteNodes(in_coordinates, old_to_new);
+    const auto out_charger =
+        has_charger ? common::permuteNodes(in_charger, old_to_new) : std::vector<double>{};
+    permute_timer.finished();
+
+    common::TimedLogger write_timer("Writing graph");
+    common::files::write_weighted_graph(out_graph_base, out_graph);
+    common::files::write_heights(out_graph_base, out_heights);
+    common::files::write_coordinates(out_graph_base, out_coordinates);
+    if (has_charger)
+        ev::files::write_charger(out_graph_base, out_charger);
+    if (common::files::has_landmarks(in_graph_base)) {
+        common::files::write_landmarks(
+            out_graph_base,
+            permute_landmarks(common::files::read_landmarks<ev::DurationGraph>(
+                                  in_graph_base, in_graph.num_nodes()),
+                              old_to_new));
+    }
+    write_timer.finished();
+
+    return EXIT_SUCCESS;
+}
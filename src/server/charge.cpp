@@ -5,54 +5,75 @@
 #include "server/handlers/mcc_dijkstra.hpp"
 #include "server/handlers/fp_dijkstra.hpp"
 #include "server/handlers/fpc_dijkstra.hpp"
+#include "server/handlers/table.hpp"
 
 #include "ev/files.hpp"
 
+#include "common/deadline.hpp"
 #include "common/files.hpp"
 #include "common/nearest_neighbour.hpp"
 
 #include <cmath>
+#include <mutex>
 #include <numeric>
 
 namespace charge::server {
 
 Charge::Charge(const std::string &base_path, const double capacity)
-    : Charge(base_path, capacity,
-             {Algorithm::FASTEST_BI_DIJKSTRA, Algorithm::MC_DIJKSTRA, Algorithm::MCC_DIJKSTRA, Algorithm::FP_DIJKSTRA, Algorithm::FPC_DIJKSTRA, Algorithm::FPC_PROFILE_DIJKSTRA}) {}
+    : Charge(base_path, capacity, ALL_ALGORITHMS) {}
 
 Charge::Charge(const std::string &base_path, const double capacity,
-               const std::set<Algorithm> &algorithms)
+               const std::set<Algorithm> &algorithms, const std::size_t num_contexts)
     : graph(common::files::read_weighted_graph<ev::TradeoffGraph::weight_t>(base_path)),
       coordinates(common::files::read_coordinates(base_path)), nn(coordinates),
       heights(common::files::read_heights(base_path)),
        charging_functions{ev::files::read_charger(base_path), ev::ChargingModel{capacity}} {
 
     if (algorithms.count(Algorithm::FASTEST_BI_DIJKSTRA) > 0) {
-        handlers[Algorithm::FASTEST_BI_DIJKSTRA] = std::make_shared<handlers::Dijkstra>(graph);
+        if (common::files::has_landmarks(base_path)) {
+            auto landmarks =
+                common::files::read_landmarks<ev::DurationGraph>(base_path, graph.num_nodes());
+            handlers[Algorithm::FASTEST_BI_DIJKSTRA] = std::make_shared<handlers::ALTDijkstra>(
+                graph, std::move(landmarks), num_contexts);
+        } else {
+            handlers[Algorithm::FASTEST_BI_DIJKSTRA] = std::make_shared<handlers::Dijkstra>(graph, num_contexts);
+        }
+    }
+    if (algorithms.count(Algorithm::FASTEST_PARALLEL_BI_DIJKSTRA) > 0) {
+        handlers[Algorithm::FASTEST_PARALLEL_BI_DIJKSTRA] =
+            std::make_shared<handlers::ParallelDijkstra>(graph, num_contexts);
     }
     if (algorithms.count(Algorithm::MC_DIJKSTRA) > 0) {
-        handlers[Algorithm::MC_DIJKSTRA] = std::make_shared<handlers::MCDijkstra>(graph, capacity, coordinates);
+        handlers[Algorithm::MC_DIJKSTRA] = std::make_shared<handlers::MCDijkstra>(graph, capacity, coordinates, num_contexts);
     }
     if (algorithms.count(Algorithm::MCC_DIJKSTRA) > 0) {
-        handlers[Algorithm::MCC_DIJKSTRA] = std::make_shared<handlers::MCCDijkstra>(graph, capacity, charging_functions, coordinates);
+        handlers[Algorithm::MCC_DIJKSTRA] = std::make_shared<handlers::MCCDijkstra>(graph, capacity, charging_functions, coordinates, num_contexts);
     }
     if (algorithms.count(Algorithm::FP_DIJKSTRA) > 0) {
-        handlers[Algorithm::FP_DIJKSTRA] = std::make_shared<handlers::FPDijkstra>(graph, capacity, coordinates);
+        handlers[Algorithm::FP_DIJKSTRA] = std::make_shared<handlers::FPDijkstra>(graph, capacity, coordinates, num_contexts);
     }
     if (algorithms.count(Algorithm::FPC_DIJKSTRA) > 0) {
-        handlers[Algorithm::FPC_DIJKSTRA] = std::make_shared<handlers::FPCDijkstra>(graph, capacity, charging_functions, coordinates, heights);
+        handlers[Algorithm::FPC_DIJKSTRA] = std::make_shared<handlers::FPCDijkstra>(graph, capacity, charging_functions, coordinates, heights, num_contexts);
     }
     if (algorithms.count(Algorithm::FPC_PROFILE_DIJKSTRA) > 0) {
-        handlers[Algorithm::FPC_PROFILE_DIJKSTRA] = std::make_shared<handlers::FPCProfileDijkstra>(graph, capacity, charging_functions, coordinates, heights);
+        handlers[Algorithm::FPC_PROFILE_DIJKSTRA] = std::make_shared<handlers::FPCProfileDijkstra>(graph, capacity, charging_functions, coordinates, heights, num_contexts);
     }
 }
 
 std::vector<RouteResult> Charge::route(Algorithm algo, std::uint32_t start,
-                                       std::uint32_t target, bool search_space) const {
+                                       std::uint32_t target, bool search_space,
+                                       double timeout_ms) const {
     if (auto algo_iter = handlers.find(algo); algo_iter != handlers.end()) {
+        // also counts the time spent waiting for other queries of this algorithm
+        const common::ScopedDeadline deadline(timeout_ms / 1000.0);
         auto routes = algo_iter->second->route(start, target, search_space);
+        const auto timed_out = deadline.is_expired();
+
+        if (timed_out && routes.empty())
+            throw QueryTimeout("Query timed out.");
 
         for (auto &route : routes) {
+            route.partial = timed_out;
             annotate_heights(route, heights);
             annotate_coordinates(route, coordinates);
             annotate_lengths(route);
@@ -67,6 +88,21 @@ std::vector<RouteResult> Charge::route(Algorithm algo, std::uint32_t start,
     return {};
 }
 
+TableResult Charge::table(const std::vector<std::uint32_t> &sources,
+                          const std::vector<std::uint32_t> &targets) const {
+    for (const auto id : sources)
+        if (id >= graph.num_nodes())
+            throw std::runtime_error("Invalid source id: " + std::to_string(id));
+    for (const auto id : targets)
+        if (id >= graph.num_nodes())
+            throw std::runtime_error("Invalid target id: " + std::to_string(id));
+
+    std::call_once(table_handler_built, [this] {
+        table_handler = std::make_shared<handlers::Table>(graph, heights);
+    });
+    return table_handler->table(sources, targets);
+}
+
 NearestResult Charge::nearest(common::Coordinate coordinate) const {
     auto id = static_cast<std::uint32_t>(nn.nearest(coordinate));
     return NearestResult{id, coordinates[id]};
@@ -1,20 +1,31 @@
+#include <algorithm>
 #include <iostream>
 
 #include "server/http.hpp"
 
 int main(int argc, const char *argv[]) {
     if (argc < 3) {
-        std::cout << argv[0] << " base_path capacity" << std::endl;
+        std::cout << argv[0] << " base_path capacity [num_contexts] [parallel_fastest]"
+                  << std::endl;
         return EXIT_FAILURE;
     }
 
     const std::string base_path = argv[1];
     const double capacity = std::stof(argv[2]);
+    // Number of parallel queries per algorithm. Every context holds per-node search state
+    // for its algorithm, so the memory grows with the pool size under load.
+    const std::size_t num_contexts = argc > 3 ? std::max(1ul, std::stoul(argv[3])) : 2;
 
-    const charge::server::Charge charge(base_path, capacity);
+    // 1 also serves fastest_parallel_bi_dijkstra, which uses two threads per query
+    auto algorithms = charge::server::Charge::ALL_ALGORITHMS;
+    if (argc > 4 && std::stoi(argv[4]) != 0)
+        algorithms.insert(charge::server::Charge::FASTEST_PARALLEL_BI_DIJKSTRA);
+
+    const charge::server::Charge charge(base_path, capacity, algorithms, num_contexts);
     charge::server::HTTPServer server(charge, 5000);
 
-    std::cerr << "Listening on port 5000..." << std::endl;
+    std::cerr << "Listening on port 5000 with " << num_contexts << " contexts per algorithm..."
+              << std::endl;
     server.wait();
 
     return EXIT_SUCCESS;
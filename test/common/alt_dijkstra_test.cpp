@@ -0,0 +1,130 @@
+#include "common/alt_dijkstra.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/graph_transform.hpp"
+#include "common/id_queue.hpp"
+#include "common/landmarks.hpp"
+#include "common/path.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::int32_t>;
+using TestCostVector = CostVector<TestGraph>;
+using TestParentVector = ParentVector<TestGraph>;
+
+// Grid with random weights and some one-way streets
+TestGraph make_grid(const unsigned width, const unsigned height, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(1, 100);
+    std::uniform_int_distribution<unsigned> oneway_distribution(0, 9);
+
+    std::vector<TestGraph::edge_t> edges;
+    const auto id = [width](unsigned x, unsigned y) { return y * width + x; };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            if (x + 1 < width) {
+                edges.push_back({id(x, y), id(x + 1, y), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x + 1, y), id(x, y), weight_distribution(generator)});
+            }
+            if (y + 1 < height) {
+                edges.push_back({id(x, y), id(x, y + 1), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x, y + 1), id(x, y), weight_distribution(generator)});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return TestGraph{width * height, edges};
+}
+
+void check_alt(const TestGraph &forward_graph, const TestGraph &reverse_graph,
+               const Landmarks<TestGraph> &landmarks) {
+    MinIDQueue forward_queue(forward_graph.num_nodes());
+    MinIDQueue reverse_queue(forward_graph.num_nodes());
+    TestCostVector forward_costs(forward_graph.num_nodes(), INF_WEIGHT);
+    TestCostVector reverse_costs(forward_graph.num_nodes(), INF_WEIGHT);
+    TestParentVector forward_parents(forward_graph.num_nodes(), INVALID_ID);
+    TestParentVector reverse_parents(forward_graph.num_nodes(), INVALID_ID);
+    TestCostVector costs(forward_graph.num_nodes(), INF_WEIGHT);
+    AverageLandmarkPotentials<TestGraph> potentials(landmarks);
+
+    for (const auto start : forward_graph.nodes()) {
+        dijkstra_to_all(start, forward_graph, forward_queue, costs);
+        for (const auto target : forward_graph.nodes()) {
+            REQUIRE(landmarks.lower_bound(start, target) <= costs[target]);
+        }
+
+        for (auto target = 0u; target < forward_graph.num_nodes(); target += 7) {
+            const auto expected = costs[target];
+            TestGraph::node_id_t middle;
+            const auto cost = alt_dijkstra(start, target, forward_graph, reverse_graph,
+                                           potentials, forward_queue, reverse_queue,
+                                           forward_costs, reverse_costs, forward_parents,
+                                           reverse_parents, middle);
+            REQUIRE(cost == expected);
+
+            if (cost != INF_WEIGHT) {
+                const auto path = get_path<TestGraph>(start, middle, target, forward_parents,
+                                                      reverse_parents);
+                REQUIRE(path.front() == start);
+                REQUIRE(path.back() == target);
+                TestGraph::weight_t path_cost = 0;
+                for (auto index = 0u; index + 1 < path.size(); ++index) {
+                    auto edge = forward_graph.edge(path[index], path[index + 1]);
+                    REQUIRE(edge != INVALID_ID);
+                    path_cost += forward_graph.weight(edge);
+                }
+                REQUIRE(path_cost == expected);
+            }
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Landmarks on a line", "[ALT]") {
+    // 0 -> 1 -> 2 -> 3
+    std::vector<TestGraph::edge_t> edges{{0, 1, 1}, {1, 2, 2}, {2, 3, 3}};
+    TestGraph forward_graph{4, edges};
+    TestGraph reverse_graph = invert(forward_graph);
+
+    const auto landmarks = select_farthest_landmarks(forward_graph, reverse_graph, 2, 42);
+    REQUIRE(landmarks.num_landmarks() == 2);
+    REQUIRE(landmarks.num_nodes() == 4);
+
+    // a landmark at either end of the line gives exact bounds
+    if (landmarks.ids()[0] == 0 || landmarks.ids()[0] == 3 || landmarks.ids()[1] == 0 ||
+        landmarks.ids()[1] == 3) {
+        REQUIRE(landmarks.lower_bound(0, 3) == 6);
+        REQUIRE(landmarks.lower_bound(1, 2) == 2);
+    }
+    // never a bound against the direction of the edges
+    REQUIRE(landmarks.lower_bound(3, 0) == 0);
+}
+
+TEST_CASE("Bidirectional ALT with avoid landmarks", "[ALT]") {
+    const auto forward_graph = make_grid(12, 10, 1337);
+    const auto reverse_graph = invert(forward_graph);
+
+    const auto landmarks = select_avoid_landmarks(forward_graph, reverse_graph, 4, 42);
+    REQUIRE(landmarks.num_landmarks() == 4);
+    check_alt(forward_graph, reverse_graph, landmarks);
+}
+
+TEST_CASE("Bidirectional ALT with farthest landmarks", "[ALT]") {
+    const auto forward_graph = make_grid(12, 10, 42);
+    const auto reverse_graph = invert(forward_graph);
+
+    const auto landmarks = select_landmarks("farthest", forward_graph, reverse_graph, 4, 42);
+    REQUIRE(landmarks.num_landmarks() == 4);
+    check_alt(forward_graph, reverse_graph, landmarks);
+}
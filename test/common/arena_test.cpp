@@ -0,0 +1,119 @@
+#include "common/arena.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/node_potentials.hpp"
+#include "common/weighted_graph.hpp"
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+TEST_CASE("Arena reuses its blocks after reset", "[Arena]")
+{
+    Arena arena(1024);
+    REQUIRE(arena.capacity() == 0);
+
+    auto *first = arena.allocate(100, 8);
+    auto *second = arena.allocate(100, 64);
+    REQUIRE(first != second);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+    REQUIRE(arena.capacity() == 1024);
+
+    // does not fit into the remaining block
+    REQUIRE(arena.allocate(900, 8) != nullptr);
+    REQUIRE(arena.capacity() > 2048);
+    const auto capacity_before_oversized = arena.capacity();
+
+    // oversized allocations get their own block
+    REQUIRE(arena.allocate(4096, 8) != nullptr);
+    REQUIRE(arena.capacity() > 4096 + capacity_before_oversized);
+    const auto capacity = arena.capacity();
+
+    arena.reset();
+    REQUIRE(arena.capacity() == capacity);
+    REQUIRE(arena.allocate(100, 8) == first);
+
+    arena.release();
+    REQUIRE(arena.capacity() == 0);
+}
+
+TEST_CASE("Arena reuses deallocated buffers of the same size class", "[Arena]")
+{
+    Arena arena(1024);
+
+    auto *first = arena.allocate(100, 8);
+    auto *second = arena.allocate(60, 8);
+    arena.deallocate(first, 100, 8);
+    arena.deallocate(second, 60, 8);
+
+    // 100 and 120 bytes are both rounded up to 128 bytes
+    REQUIRE(arena.allocate(120, 8) == first);
+    REQUIRE(arena.allocate(33, 8) == second);
+    REQUIRE(arena.allocate(100, 8) != first);
+
+    // the free lists are dropped with the rest of the memory
+    auto *third = arena.allocate(16, 8);
+    arena.deallocate(third, 16, 8);
+    arena.reset();
+    REQUIRE(arena.allocate(100, 8) == first);
+}
+
+TEST_CASE("Growing vectors reuse the buffers they left behind", "[Arena]")
+{
+    Arena arena(1u << 16);
+    {
+        std::pmr::vector<int> values(&arena);
+        for (int i = 0; i < 1000; ++i)
+            values.push_back(i);
+    }
+    const auto capacity = arena.capacity();
+
+    for (int repetition = 0; repetition < 100; ++repetition) {
+        std::pmr::vector<int> values(&arena);
+        for (int i = 0; i < 1000; ++i)
+            values.push_back(i);
+    }
+    REQUIRE(arena.capacity() == capacity);
+}
+
+TEST_CASE("Arena backed vectors", "[Arena]")
+{
+    Arena arena(256);
+    std::pmr::vector<int> values(&arena);
+    for (int i = 0; i < 1000; ++i)
+        values.push_back(i);
+    REQUIRE(values.size() == 1000);
+    REQUIRE(values.front() == 0);
+    REQUIRE(values.back() == 999);
+}
+
+TEST_CASE("Node labels keep their labels when copied", "[Arena]")
+{
+    using TestGraph = WeightedGraph<std::tuple<std::int32_t, std::int32_t>>;
+    using label_t = LabelEntryWithParent<TestGraph::weight_t, TestGraph::node_id_t>;
+    using PolicyT = MCDijkstraPolicy<TestGraph, label_t>;
+    PolicyT policy;
+    ZeroNodePotentials<TestGraph> potentials;
+
+    NodeLabels<PolicyT> labels(3);
+    labels.push(1, label_t{0, std::make_tuple(1, 5), 0, 0}, policy, potentials);
+    labels.push(1, label_t{0, std::make_tuple(2, 3), 0, 0}, policy, potentials);
+    labels.pop(1, policy, potentials);
+
+    auto copy = labels;
+    labels.clear();
+    REQUIRE(labels[1].empty());
+    REQUIRE(labels.empty(1));
+
+    REQUIRE(copy[1].size() == 1);
+    REQUIRE(copy.size(1) == 1);
+    REQUIRE(copy.touched_nodes() == std::vector<std::uint32_t>{1});
+
+    auto moved = std::move(copy);
+    moved.clear();
+    REQUIRE(moved.touched_nodes().empty());
+}
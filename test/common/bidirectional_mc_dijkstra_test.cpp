@@ -0,0 +1,351 @@
+#include "common/bidirectional_mc_dijkstra.hpp"
+
+#include "common/graph_transform.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/path.hpp"
+#include "common/weighted_graph.hpp"
+
+#include "ev/charging_function_container.hpp"
+#include "ev/mc_dijkstra.hpp"
+#include "ev/mcc_dijkstra.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::tuple<std::int32_t, std::int32_t>>;
+using TestLabelEntry = LabelEntryWithParent<TestGraph::weight_t, TestGraph::node_id_t>;
+using TestPolicy = MCDijkstraPolicy<TestGraph, TestLabelEntry>;
+
+// Grid with conflicting criteria and some one-way streets. The consumption of an edge also pays
+// for the difference of the altitudes of its nodes, so going downhill can recuperate but no cycle
+// gains energy.
+template <typename GraphT>
+GraphT make_grid(const unsigned width, const unsigned height, const unsigned seed,
+                 const std::int32_t scale = 1, const std::int32_t max_altitude = 0) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(1, 20);
+    std::uniform_int_distribution<unsigned> oneway_distribution(0, 4);
+
+    std::mt19937 altitude_generator(seed);
+    std::uniform_int_distribution<std::int32_t> altitude_distribution(0, max_altitude);
+    std::vector<std::int32_t> altitudes(width * height);
+    for (auto &altitude : altitudes)
+        altitude = altitude_distribution(altitude_generator);
+
+    const auto random_weight = [&](const unsigned from, const unsigned to) {
+        const auto duration = weight_distribution(generator);
+        return std::tuple<std::int32_t, std::int32_t>{
+            scale * duration, scale * (21 - duration + weight_distribution(generator) / 4 +
+                                       altitudes[to] - altitudes[from])};
+    };
+
+    std::vector<typename GraphT::edge_t> edges;
+    const auto add_edge = [&](const unsigned from, const unsigned to) {
+        edges.push_back({from, to, random_weight(from, to)});
+    };
+    const auto id = [width](unsigned x, unsigned y) { return y * width + x; };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            if (x + 1 < width) {
+                add_edge(id(x, y), id(x + 1, y));
+                if (oneway_distribution(generator) > 0)
+                    add_edge(id(x + 1, y), id(x, y));
+            }
+            if (y + 1 < height) {
+                add_edge(id(x, y), id(x, y + 1));
+                if (oneway_distribution(generator) > 0)
+                    add_edge(id(x, y + 1), id(x, y));
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return GraphT{width * height, edges};
+}
+
+// Links and constrains the edges of the path with the policy, returns the cost at every node
+template <typename GraphT, typename PolicyT>
+auto path_costs(const GraphT &graph, const std::vector<typename GraphT::node_id_t> &path,
+                const PolicyT &policy) {
+    std::vector<typename GraphT::weight_t> costs{typename GraphT::weight_t{0, 0}};
+    for (const auto index : irange<std::size_t>(1, path.size())) {
+        const auto edge = graph.edge(path[index - 1], path[index]);
+        REQUIRE(edge != INVALID_ID);
+        auto cost = policy.link(costs.back(), graph.weight(edge));
+        CHECK(!policy.constrain(cost));
+        costs.push_back(cost);
+    }
+    return costs;
+}
+
+// Finds the whole Pareto set: with recuperation stalling at the target drops labels that could
+// still get below the consumption of the target labels
+struct ExhaustivePolicy : ev::DurationConsumptionDijkstraPolicyWithParents {
+    using ev::DurationConsumptionDijkstraPolicyWithParents::DurationConsumptionDijkstraPolicy;
+
+    static constexpr bool enable_stalling = false;
+
+    template <typename QueueT, typename NodeLabelsT>
+    static bool terminate(const QueueT &, const NodeLabelsT &, const node_id_t) {
+        return false;
+    }
+};
+
+// Finds the whole Pareto set: stalling at the target drops labels that could still charge, and
+// the policy would stop once the fastest solution is known
+struct ExhaustiveChargingPolicy : ev::DurationConsumptionChargingDijkstraPolicyWithParents {
+    using ev::DurationConsumptionChargingDijkstraPolicyWithParents::
+        DurationConsumptionChargingDijkstraPolicy;
+
+    static constexpr bool enable_stalling = false;
+
+    template <typename QueueT, typename NodeLabelsT>
+    static bool terminate(const QueueT &, const NodeLabelsT &, const node_id_t) {
+        return false;
+    }
+};
+} // namespace
+
+TEST_CASE("Bidirectional search finds the same Pareto sets", "[bidirectional mc dijkstra]") {
+    const auto graph = make_grid<TestGraph>(8, 8, 1337);
+    const auto reverse_graph = invert(graph);
+    const TestPolicy policy;
+
+    MinIDQueue queue(graph.num_nodes());
+    NodeLabels<TestPolicy> reference_labels(graph.num_nodes());
+    LabelHeap<TestLabelEntry> forward_heap(graph.num_nodes());
+    LabelHeap<TestLabelEntry> backward_heap(graph.num_nodes());
+    BidirectionalNodeLabels<TestPolicy, TestPolicy> labels(graph.num_nodes());
+
+    for (const auto start : {0u, 27u, 63u}) {
+        for (const auto target : {0u, 7u, 36u, 56u, 63u}) {
+            const auto reference =
+                mc_dijkstra(start, target, graph, queue, reference_labels, policy);
+            const auto results = bidirectional_mc_dijkstra(start, target, graph, reverse_graph,
+                                                           forward_heap, backward_heap, labels,
+                                                           policy, policy);
+
+            REQUIRE(results.size() == reference.size());
+            for (const auto index : irange<std::size_t>(0, results.size())) {
+                REQUIRE(results[index].cost == reference[index].cost);
+
+                const auto[path, costs] =
+                    get_path_with_costs(start, target, results[index], labels);
+                CHECK(path.front() == start);
+                CHECK(path.back() == target);
+                CHECK(costs == path_costs(graph, path, policy));
+                CHECK(costs.back() == results[index].cost);
+            }
+        }
+    }
+}
+
+TEST_CASE("Bidirectional search applies the capacity at the middle",
+          "[bidirectional mc dijkstra]") {
+    const auto graph = make_grid<ev::DurationConsumptionGraph>(8, 8, 42);
+    const auto reverse_graph = invert(graph);
+
+    MinIDQueue queue(graph.num_nodes());
+    LabelHeap<ev::DurationConsumptionLabelEntryWithParent> forward_heap(graph.num_nodes());
+    LabelHeap<ev::DurationConsumptionRestLabelEntryWithParent> backward_heap(graph.num_nodes());
+
+    using Policy = ev::DurationConsumptionDijkstraPolicyWithParents;
+    using BackwardPolicy = ev::DurationConsumptionBackwardDijkstraPolicyWithParents;
+    NodeLabels<Policy> reference_labels(graph.num_nodes());
+    BidirectionalNodeLabels<Policy, BackwardPolicy> labels(graph.num_nodes());
+
+    std::size_t num_infeasible = 0;
+    for (const auto capacity : {40, 80, 120, INF_WEIGHT}) {
+        const Policy policy{0, 0, capacity};
+        const BackwardPolicy backward_policy{0, 0, capacity};
+        for (const auto start : {0u, 9u, 63u}) {
+            for (const auto target : {7u, 36u, 56u, 63u}) {
+                const auto reference =
+                    mc_dijkstra(start, target, graph, queue, reference_labels, policy);
+                const auto results = bidirectional_mc_dijkstra(
+                    start, target, graph, reverse_graph, forward_heap, backward_heap, labels,
+                    policy, backward_policy);
+
+                // both stop once the fastest solution is known
+                REQUIRE(results.empty() == reference.empty());
+                if (!results.empty()) {
+                    CHECK(results.front().cost == reference.front().cost);
+                }
+                for (const auto &solution : results) {
+                    CHECK(std::get<1>(solution.cost) <= capacity);
+                }
+                num_infeasible += results.empty();
+            }
+        }
+    }
+    // the capacity needs to rule out some queries
+    CHECK(num_infeasible > 0);
+}
+
+TEST_CASE("Bidirectional search with recuperation", "[bidirectional mc dijkstra]") {
+    using BackwardPolicy = ev::DurationConsumptionBackwardDijkstraPolicyWithParents;
+
+    SECTION("Energy that can not be recuperated on a full battery") {
+        const std::vector<ev::DurationConsumptionGraph::edge_t> edges{
+            {0, 1, {10, 200}}, {1, 2, {10, 500}}, {2, 3, {10, -100}}};
+        const ev::DurationConsumptionGraph graph{4, edges};
+        const auto reverse_graph = invert(graph);
+
+        MinIDQueue queue(graph.num_nodes());
+        NodeLabels<ev::DurationConsumptionDijkstraPolicyWithParents> reference_labels(
+            graph.num_nodes());
+        LabelHeap<ev::DurationConsumptionLabelEntryWithParent> forward_heap(graph.num_nodes());
+        LabelHeap<ev::DurationConsumptionRestLabelEntryWithParent> backward_heap(
+            graph.num_nodes());
+        BidirectionalNodeLabels<ev::DurationConsumptionDijkstraPolicyWithParents, BackwardPolicy>
+            labels(graph.num_nodes());
+
+        for (const auto capacity : {700, INF_WEIGHT}) {
+            const ev::DurationConsumptionDijkstraPolicyWithParents policy{0, 0, capacity};
+            const auto reference = mc_dijkstra(0, 3, graph, queue, reference_labels, policy);
+            const auto results =
+                bidirectional_mc_dijkstra(0, 3, graph, reverse_graph, forward_heap,
+                                          backward_heap, labels, policy,
+                                          BackwardPolicy{0, 0, capacity});
+
+            REQUIRE(reference.size() == 1);
+            REQUIRE(results.size() == 1);
+            const ev::DurationConsumptionGraph::weight_t cost{30, 600};
+            CHECK(reference.front().cost == cost);
+            CHECK(results.front().cost == cost);
+        }
+    }
+
+    SECTION("Same Pareto sets as the unidirectional search") {
+        const auto graph = make_grid<ev::DurationConsumptionGraph>(8, 8, 7, 1, 30);
+        const auto reverse_graph = invert(graph);
+
+        MinIDQueue queue(graph.num_nodes());
+        NodeLabels<ExhaustivePolicy> reference_labels(graph.num_nodes());
+        LabelHeap<ev::DurationConsumptionLabelEntryWithParent> forward_heap(graph.num_nodes());
+        LabelHeap<ev::DurationConsumptionRestLabelEntryWithParent> backward_heap(
+            graph.num_nodes());
+        BidirectionalNodeLabels<ExhaustivePolicy, BackwardPolicy> labels(graph.num_nodes());
+
+        std::size_t num_solutions = 0;
+        for (const auto capacity : {20, 40, INF_WEIGHT}) {
+            const ExhaustivePolicy policy{0, 0, capacity};
+            const BackwardPolicy backward_policy{0, 0, capacity};
+            for (const auto start : {0u, 9u, 63u}) {
+                for (const auto target : {7u, 36u, 56u, 63u}) {
+                    const auto reference =
+                        mc_dijkstra(start, target, graph, queue, reference_labels,
+                                    ZeroNodePotentials<ev::DurationConsumptionGraph>{}, policy);
+                    const auto results = bidirectional_mc_dijkstra(
+                        start, target, graph, reverse_graph, forward_heap, backward_heap, labels,
+                        policy, backward_policy);
+                    num_solutions += results.size();
+
+                    REQUIRE(results.size() == reference.size());
+                    for (const auto index : irange<std::size_t>(0, results.size())) {
+                        REQUIRE(results[index].cost == reference[index].cost);
+
+                        const auto[path, costs] =
+                            get_path_with_costs(start, target, results[index], labels);
+                        CHECK(path.front() == start);
+                        CHECK(path.back() == target);
+                        CHECK(costs == path_costs(graph, path, policy));
+                        CHECK(costs.back() == results[index].cost);
+                    }
+                }
+            }
+        }
+        CHECK(num_solutions > 0);
+    }
+}
+
+TEST_CASE("Bidirectional search with charging stations", "[bidirectional mc dijkstra]") {
+    // durations in deci-seconds and consumptions in deci-Wh
+    const auto graph =
+        make_grid<ev::DurationConsumptionGraph>(6, 6, 1337, common::to_fixed(100));
+    const auto reverse_graph = invert(graph);
+
+    const double capacity = 5000;
+    std::vector<double> charging_rates(graph.num_nodes(), 0);
+    charging_rates[14] = 22000;
+    charging_rates[21] = 50000;
+    const ev::ChargingFunctionContainer chargers{charging_rates, ev::ChargingModel{capacity}};
+
+    MinIDQueue queue(graph.num_nodes());
+
+    SECTION("Same Pareto sets as the unidirectional search") {
+        using BackwardPolicy = ev::DurationConsumptionBackwardDijkstraPolicyWithParents;
+        const ExhaustiveChargingPolicy policy{0, 0, common::to_fixed(capacity),
+                                              common::to_fixed(60), chargers};
+        const BackwardPolicy backward_policy{0, 0, common::to_fixed(capacity)};
+        NodeLabels<ExhaustiveChargingPolicy> reference_labels(graph.num_nodes());
+        LabelHeap<ev::DurationConsumptionLabelEntryWithParent> forward_heap(graph.num_nodes());
+        LabelHeap<ev::DurationConsumptionRestLabelEntryWithParent> backward_heap(
+            graph.num_nodes());
+        BidirectionalNodeLabels<ExhaustiveChargingPolicy, BackwardPolicy> labels(
+            graph.num_nodes());
+
+        std::size_t num_charging = 0;
+        for (const auto start : {0u, 5u, 30u}) {
+            for (const auto target : {35u, 20u}) {
+                const auto reference =
+                    mc_dijkstra(start, target, graph, queue, reference_labels,
+                                ZeroNodePotentials<ev::DurationConsumptionGraph>{}, policy);
+                const auto results = bidirectional_mc_dijkstra(
+                    start, target, graph, reverse_graph, forward_heap, backward_heap, labels,
+                    policy, backward_policy);
+
+                REQUIRE(results.size() == reference.size());
+                for (const auto index : irange<std::size_t>(0, results.size())) {
+                    CHECK(results[index].cost == reference[index].cost);
+
+                    const auto path = get_path(start, target, results[index], labels);
+                    CHECK(path.front() == start);
+                    CHECK(path.back() == target);
+                    CHECK(path == get_path(start, target, reference[index], reference_labels));
+                    // a charging stop shows up as the same node twice
+                    num_charging +=
+                        std::adjacent_find(path.begin(), path.end()) != path.end();
+                }
+            }
+        }
+        // some solutions need to charge after the middle of the path
+        CHECK(num_charging > 0);
+    }
+
+    SECTION("Same fastest solutions as the unidirectional search") {
+        NodeLabels<ev::DurationConsumptionChargingDijkstraPolicyWithParents> reference_labels(
+            graph.num_nodes());
+        ev::BidirectionalMCCDijkstraContext context{0, 0, 10, capacity, 60, graph, reverse_graph,
+                                                    chargers};
+
+        std::size_t num_solutions = 0;
+        for (const auto start : {0u, 5u, 30u}) {
+            for (const auto target : {35u, 20u}) {
+                const auto reference =
+                    ev::mcc_dijkstra(start, target, graph, chargers, queue, reference_labels,
+                                     common::to_fixed(capacity), 0, 0, 10, common::to_fixed(60));
+                const auto results = context(start, target);
+                num_solutions += results.size();
+
+                // both stop once the fastest solution is known, the bidirectional search also
+                // returns the solutions that are faster than the sum of its min keys
+                REQUIRE(results.empty() == reference.empty());
+                if (!results.empty()) {
+                    CHECK(results.front().cost == reference.front().cost);
+                }
+                for (const auto &solution : results) {
+                    CHECK(std::get<1>(solution.cost) <= common::to_fixed(capacity));
+                }
+            }
+        }
+        CHECK(num_solutions > 0);
+    }
+}
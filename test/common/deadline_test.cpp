@@ -0,0 +1,83 @@
+#include "common/deadline.hpp"
+
+#include "common/id_queue.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::tuple<std::int32_t, std::int32_t>>;
+using TestLabelEntry = LabelEntry<TestGraph::weight_t, TestGraph::node_id_t>;
+using TestLabels = NodeLabels<MCDijkstraPolicy<TestGraph, TestLabelEntry>>;
+} // namespace
+
+TEST_CASE("Deadline expires", "[deadline]") {
+    auto &deadline = Deadline::get();
+
+    deadline.reset();
+    for (auto i = 0u; i < 10 * Deadline::CHECK_INTERVAL; ++i)
+        REQUIRE(!deadline.expired());
+    CHECK(!deadline.is_expired());
+
+    deadline.reset(0);
+    CHECK(deadline.expired());
+    CHECK(deadline.is_expired());
+
+    // only checks the clock every CHECK_INTERVAL calls
+    deadline.reset(0.001);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    for (auto i = 0u; i + 1 < Deadline::CHECK_INTERVAL; ++i)
+        REQUIRE(!deadline.expired());
+    CHECK(deadline.expired());
+    CHECK(deadline.expired());
+
+    deadline.reset();
+    std::thread([&] { deadline.cancel(); }).join();
+    CHECK(deadline.expired());
+
+    deadline.reset();
+    CHECK(!deadline.expired());
+}
+
+TEST_CASE("Scoped deadline is removed when the query throws", "[deadline]") {
+    try {
+        const ScopedDeadline deadline(0);
+        CHECK(deadline.is_expired());
+        throw std::runtime_error("query failed");
+    } catch (const std::runtime_error &) {
+    }
+    CHECK(!Deadline::get().is_set());
+    CHECK(!Deadline::get().expired());
+}
+
+TEST_CASE("Deadline stops mc_dijkstra", "[deadline]") {
+    // 0 -> 1 -> 2 -> 3
+    //      ^---------|
+    std::vector<TestGraph::edge_t> edges{
+        {0, 1, {1, 2}}, {1, 2, {1, 3}}, {2, 3, {1, 4}}, {3, 1, {1, 2}}};
+    TestGraph graph{4, edges};
+
+    MinIDQueue queue(graph.num_nodes());
+    TestLabels labels(graph.num_nodes());
+
+    auto &deadline = Deadline::get();
+
+    deadline.reset(0);
+    auto results_1 = mc_dijkstra(0, 3, graph, queue, labels);
+    CHECK(results_1.empty());
+    CHECK(deadline.is_expired());
+
+    deadline.reset();
+    auto results_2 = mc_dijkstra(0, 3, graph, queue, labels);
+    std::vector<TestLabelEntry> reference_2{{3, {3, 9}}};
+    CHECK(results_2 == reference_2);
+    CHECK(!deadline.is_expired());
+}
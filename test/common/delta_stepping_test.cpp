@@ -0,0 +1,110 @@
+#include "common/delta_stepping.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::int32_t>;
+using TestCostVector = CostVector<TestGraph>;
+
+// Grid with random weights and some one-way streets, weights are shifted by a random
+// potential to get negative weights without negative cycles
+TestGraph make_grid(const unsigned width, const unsigned height, const unsigned seed,
+                    const bool negative) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(1, 100);
+    std::uniform_int_distribution<unsigned> oneway_distribution(0, 9);
+    std::uniform_int_distribution<std::int32_t> potential_distribution(0, negative ? 500 : 0);
+
+    std::vector<std::int32_t> potential(width * height);
+    for (auto &p : potential)
+        p = potential_distribution(generator);
+
+    std::vector<TestGraph::edge_t> edges;
+    const auto id = [width](unsigned x, unsigned y) { return y * width + x; };
+    const auto add_edge = [&](const unsigned from, const unsigned to) {
+        edges.push_back(
+            {from, to, weight_distribution(generator) - potential[from] + potential[to]});
+    };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            if (x + 1 < width) {
+                add_edge(id(x, y), id(x + 1, y));
+                if (oneway_distribution(generator) > 0)
+                    add_edge(id(x + 1, y), id(x, y));
+            }
+            if (y + 1 < height) {
+                add_edge(id(x, y), id(x, y + 1));
+                if (oneway_distribution(generator) > 0)
+                    add_edge(id(x, y + 1), id(x, y));
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return TestGraph{width * height, edges};
+}
+
+void check_delta_stepping(const TestGraph &graph, const std::size_t num_threads,
+                          const std::int32_t delta) {
+    MinIDQueue queue(graph.num_nodes());
+    DeltaStepping search(graph.num_nodes(), num_threads, delta);
+    TestCostVector reference_costs(graph.num_nodes(), INF_WEIGHT);
+    TestCostVector costs(graph.num_nodes(), INF_WEIGHT);
+
+    for (auto start = 0u; start < graph.num_nodes(); start += 13) {
+        dijkstra_to_all(start, graph, queue, reference_costs);
+        dijkstra_to_all(start, graph, search, costs);
+        for (const auto node : graph.nodes()) {
+            REQUIRE(costs[node] == reference_costs[node]);
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Delta-stepping with non-negative weights", "[DeltaStepping]") {
+    const auto graph = make_grid(30, 20, 1337, false);
+
+    check_delta_stepping(graph, 1, 0);
+    check_delta_stepping(graph, 4, 0);
+    check_delta_stepping(graph, 3, 1);
+    check_delta_stepping(graph, 2, 1000);
+}
+
+TEST_CASE("Delta-stepping with negative weights", "[DeltaStepping]") {
+    const auto graph = make_grid(30, 20, 42, true);
+
+    check_delta_stepping(graph, 1, 0);
+    check_delta_stepping(graph, 4, 0);
+    check_delta_stepping(graph, 2, 25);
+}
+
+TEST_CASE("Delta-stepping with unreachable nodes", "[DeltaStepping]") {
+    // 0 -> 1 -> 2    3 -> 0
+    std::vector<TestGraph::edge_t> edges{{0, 1, 3}, {1, 2, 4}, {3, 0, 1}};
+    const TestGraph graph{4, edges};
+
+    DeltaStepping search(graph.num_nodes(), 2);
+    TestCostVector costs(graph.num_nodes(), INF_WEIGHT);
+    dijkstra_to_all(1u, graph, search, costs);
+    REQUIRE(costs[0] == INF_WEIGHT);
+    REQUIRE(costs[1] == 0);
+    REQUIRE(costs[2] == 4);
+    REQUIRE(costs[3] == INF_WEIGHT);
+
+    // copies share nothing but the configuration
+    auto copy = search;
+    REQUIRE(copy.threads() == 2);
+    dijkstra_to_all(3u, graph, copy, costs);
+    REQUIRE(costs[0] == 1);
+    REQUIRE(costs[2] == 8);
+}
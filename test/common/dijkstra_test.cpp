@@ -404,3 +404,35 @@ TEST_CASE("Reference graph searches with uni-directional", "[dijkstra]") {
     const auto[path_8, costs_8] = common::get_path_with_labels<Graph>(2, 2, parents, costs);
     REQUIRE(reference_path_8 == path_8);
 }
+
+TEST_CASE("Dijkstra to targets", "[dijkstra]") {
+    // 0 -> 1 -> 2 -> 3 -> 4
+    //      |              ^
+    //      |--------------|      5
+    std::vector<TestGraph::edge_t> edges{{0, 1, 1}, {1, 2, 1}, {1, 4, 10}, {2, 3, 1}, {3, 4, 1}};
+    TestGraph graph{6, edges};
+
+    MinIDQueue queue(graph.num_nodes());
+    TestCostVector costs(graph.num_nodes(), INF_WEIGHT);
+
+    std::vector<TestGraph::node_id_t> settled;
+    const auto record = [&](const auto id) { settled.push_back(id); };
+
+    std::vector<TestGraph::node_id_t> targets{2, 1, 2};
+    std::vector<TestGraph::weight_t> reference_costs_1{2, 1, 2};
+    std::vector<TestGraph::node_id_t> reference_settled_1{0, 1, 2};
+    REQUIRE(reference_costs_1 == dijkstra_to_targets(0, targets, graph, queue, costs, record));
+    // stops once the last target is settled
+    REQUIRE(reference_settled_1 == settled);
+
+    targets = {4, 0};
+    std::vector<TestGraph::weight_t> reference_costs_2{4, 0};
+    REQUIRE(reference_costs_2 == dijkstra_to_targets(0, targets, graph, queue, costs));
+
+    settled.clear();
+    targets = {5, 3};
+    std::vector<TestGraph::weight_t> reference_costs_3{INF_WEIGHT, 3};
+    std::vector<TestGraph::node_id_t> reference_settled_3{0, 1, 2, 3, 4};
+    REQUIRE(reference_costs_3 == dijkstra_to_targets(0, targets, graph, queue, costs, record));
+    REQUIRE(reference_settled_3 == settled);
+}
@@ -11,6 +11,8 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <memory_resource>
 #include <vector>
 
 using namespace charge;
@@ -49,6 +51,28 @@ TEST_CASE("Test oneways with FP", "[mc dijkstra]") {
             common::get_path(0, 3, results_3.front(), labels_with_parents));
 }
 
+TEST_CASE("FP links the labels into the arena of the labels", "[fp dijkstra]") {
+    std::vector<TestGraph::edge_t> edges{{0, 1, ev::make_constant(1, 2)},
+                                         {1, 2, ev::make_constant(1, 3)}};
+    TestGraph graph{3, edges};
+
+    MinIDQueue queue(graph.num_nodes());
+    TestLabelsWithParents labels(graph.num_nodes());
+
+    const auto results = fp_dijkstra(0, 2, graph, queue, labels);
+    REQUIRE(results.size() == 1);
+
+    const auto &settled = labels[2];
+    REQUIRE(settled.size() == 1);
+    CHECK(settled.front().cost.functions.get_allocator().resource() == labels.resource());
+
+    // the results are copies that outlive the arena
+    const auto *default_resource = std::pmr::get_default_resource();
+    CHECK(results.front().cost.functions.get_allocator().resource() == default_resource);
+    labels.clear();
+    CHECK(results.front().cost == PiecewieseDecHypOrLinFunction{ev::make_constant(2, 5)});
+}
+
 TEST_CASE("Test full graph with FP", "[fp dijkstra]") {
     // 0 --- 1 --- 2
     // |  \  |     |
@@ -114,6 +138,17 @@ TEST_CASE("Test full graph with FP", "[fp dijkstra]") {
     REQUIRE(reference_path_1 == common::get_path(0, 8, results_4.front(), labels_with_parents));
     REQUIRE(reference_path_2 == common::get_path(0, 8, results_4[1], labels_with_parents));
     REQUIRE(reference_path_3 == common::get_path(0, 8, results_4.back(), labels_with_parents));
+    // the settled labels keep their deltas apart, label() puts them back together
+    static_assert(TestLabelsWithParents::has_cold_deltas);
+    static_assert(!is_delta_label<TestLabelsWithParents::settled_label_t>::value);
+    REQUIRE(labels_with_parents[8].size() == results_4.size());
+    REQUIRE(labels_with_parents.settled_deltas.size() == labels_with_parents.settled_labels.size());
+    for (const auto entry_id : irange<std::size_t>(0, results_4.size())) {
+        const auto label = labels_with_parents.label(8, entry_id);
+        const auto result = std::find(results_4.begin(), results_4.end(), label);
+        REQUIRE(result != results_4.end());
+        CHECK(label.delta.size() == result->delta.size());
+    }
 
     auto results_5 = fp_dijkstra(0, 6, graph, queue, labels_with_parents);
     std::vector<TestGraph::node_id_t> reference_path_4{0, 3, 6};
@@ -358,3 +358,74 @@ TEST_CASE("Test charging with FPC - with tradeoffs", "[fpc dijkstra]") {
     CHECK(best_2.cost.min_x() == 6);
     CHECK(best_2.cost(best_2.cost.min_x()) == 1980);
 }
+
+namespace {
+template <typename LabelEntryT>
+struct LimitedChargingPolicy
+    : public common::FPDijkstraWeightedNodePolicy<TestGraph, LabelEntryT, TestNodeWeights> {
+    using Parent = common::FPDijkstraWeightedNodePolicy<TestGraph, LabelEntryT, TestNodeWeights>;
+    using Parent::Parent;
+
+    static bool constrain(typename Parent::cost_t &cost) {
+        cost.limit_from_y(0, 2000);
+        return cost.functions.empty();
+    }
+};
+} // namespace
+
+TEST_CASE("Recompute deltas along the path with FPC", "[fpc dijkstra]") {
+    // same graph as above, 1 is a charging station
+    //
+    // 0 -> (1) -> 2 -> 3
+    //       ^
+    // 4 ----|
+    std::vector<TestGraph::edge_t> edges{
+        {0, 1, ev::LimitedTradeoffFunction(1, 10, HyperbolicFunction{4000, 0, 100})},
+        {1, 2, ev::LimitedTradeoffFunction(4, 8, HyperbolicFunction{640, 0, 90})},
+        {2, 3, ev::make_constant(1, 1800)},
+        {4, 1, ev::make_constant(1, 50)}};
+    TestGraph graph{5, edges};
+
+    using TestLabelEntryWithParentOnly =
+        LabelEntryWithParentOnly<TestGraph::weight_t, TestGraph::node_id_t>;
+    using PolicyWithParents = LimitedChargingPolicy<TestLabelEntryWithParent>;
+    using PolicyWithParentsOnly = LimitedChargingPolicy<TestLabelEntryWithParentOnly>;
+
+    PiecewieseDecLinearFunction cf{{
+        {0, 4, LinearFunction{-400, 0, 2000}},
+        {4, 12, LinearFunction{-50, 4, 400}},
+    }};
+    TestNodeWeights node_weights{{false, true, false, false, false},
+                                 {{}, StatefulPiecewieseDecLinearFunction{cf}, {}, {}, {}}};
+
+    MinIDQueue queue(graph.num_nodes());
+    NodeLabels<PolicyWithParents> labels_with_parents(graph.num_nodes());
+    NodeLabels<PolicyWithParentsOnly> labels_with_parents_only(graph.num_nodes());
+    const PolicyWithParentsOnly policy{node_weights};
+
+    for (const auto start : {0, 4}) {
+        auto results = fp_dijkstra(start, 3, graph, queue, labels_with_parents,
+                                   PolicyWithParents{node_weights});
+        auto results_only =
+            fp_dijkstra(start, 3, graph, queue, labels_with_parents_only, policy);
+        REQUIRE(results.size() == results_only.size());
+
+        for (const auto index : irange<std::size_t>(0, results.size())) {
+            auto[path, path_labels] =
+                get_path_with_labels(start, 3, results[index], labels_with_parents);
+            auto[path_only, path_labels_only, deltas] = get_path_with_deltas(
+                start, 3, results_only[index], labels_with_parents_only, graph, policy);
+            REQUIRE(path == path_only);
+            REQUIRE(deltas.size() == path_labels.size());
+
+            for (const auto hop : irange<std::size_t>(1, path_labels.size())) {
+                const auto &cost = path_labels_only[hop].cost;
+                const auto &delta = path_labels[hop].delta;
+                for (const auto step : irange(0, 5)) {
+                    const auto x = cost.min_x() + (cost.max_x() - cost.min_x()) * step / 4.;
+                    CHECK(deltas[hop](x) == Approx(delta(std::max(delta.min_x(), x))));
+                }
+            }
+        }
+    }
+}
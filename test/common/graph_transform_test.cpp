@@ -68,3 +68,76 @@ TEST_CASE("Computing turn graph", "[graph transform]") {
 
     CHECK(turns == reference_turns);
 }
+
+namespace {
+template <typename NodeT> bool is_permutation(const std::vector<NodeT> &old_to_new) {
+    std::vector<NodeT> sorted = old_to_new;
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t index = 0; index < sorted.size(); ++index) {
+        if (sorted[index] != index)
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("Locality orders of the nodes", "[graph transform]") {
+    // 0 - 3 - 1    5 - 4
+    //     |
+    //     2
+    std::vector<AdjGraph::edge_t> input_edges{{0, 3}, {1, 3}, {2, 3}, {3, 0}, {3, 1}, {3, 2},
+                                              {4, 5}, {5, 4}};
+    auto graph = AdjGraph{6, input_edges};
+
+    auto bfs = bfsOrder(graph);
+    std::vector<AdjGraph::node_id_t> reference_bfs{0, 2, 3, 1, 4, 5};
+    CHECK(bfs == reference_bfs);
+
+    auto dfs = dfsOrder(graph);
+    CHECK(is_permutation(dfs));
+    CHECK(dfs[0] == 0);
+    CHECK(dfs[3] == 1);
+    CHECK(dfs[4] == 4);
+
+    // 0 - 1 - 3
+    // |
+    // 2
+    std::vector<AdjGraph::edge_t> tree_edges{{0, 1}, {0, 2}, {1, 0}, {1, 3}, {2, 0}, {3, 1}};
+    auto tree = AdjGraph{4, tree_edges};
+    std::vector<AdjGraph::node_id_t> reference_tree_bfs{0, 1, 2, 3};
+    CHECK(bfsOrder(tree) == reference_tree_bfs);
+    // preorder: the subtree of 1 is numbered before 2
+    std::vector<AdjGraph::node_id_t> reference_tree_dfs{0, 1, 3, 2};
+    CHECK(dfsOrder(tree) == reference_tree_dfs);
+
+    // the quadrants of the Hilbert curve are visited in the order
+    // lower left, upper left, upper right, lower right
+    std::vector<Coordinate> coordinates{Coordinate::from_floating(9, 1),
+                                        Coordinate::from_floating(9, 9),
+                                        Coordinate::from_floating(1, 9),
+                                        Coordinate::from_floating(1, 1)};
+    auto hilbert = hilbertOrder(coordinates);
+    std::vector<std::uint32_t> reference_hilbert{3, 2, 1, 0};
+    CHECK(hilbert == reference_hilbert);
+}
+
+TEST_CASE("Permuting a graph keeps its edges", "[graph transform]") {
+    using Graph = FunctionGraph<LinearFunction>;
+    std::vector<Graph::edge_t> input_edges{{0, 1, {0, 0, ConstantFunction{0}}}, //
+                                           {0, 2, {1, 1, ConstantFunction{0}}}, //
+                                           {1, 2, {2, 2, ConstantFunction{0}}}, //
+                                           {2, 0, {3, 3, ConstantFunction{0}}}};
+    auto graph = Graph{3, input_edges};
+    std::vector<Graph::node_id_t> old_to_new{2, 0, 1};
+
+    auto permuted = permuteGraph(graph, old_to_new);
+    std::vector<Graph::edge_t> reference_edges{{0, 1, {2, 2, ConstantFunction{0}}}, //
+                                               {1, 2, {3, 3, ConstantFunction{0}}}, //
+                                               {2, 0, {0, 0, ConstantFunction{0}}}, //
+                                               {2, 1, {1, 1, ConstantFunction{0}}}};
+    CHECK(permuted.edges() == reference_edges);
+
+    std::vector<int> values{10, 11, 12};
+    std::vector<int> reference_values{11, 12, 10};
+    CHECK(permuteNodes(values, old_to_new) == reference_values);
+}
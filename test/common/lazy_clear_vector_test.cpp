@@ -3,6 +3,9 @@
 
 #include "catch.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 using namespace charge;
@@ -69,3 +72,57 @@ TEST_CASE("Simple lazy clear vector test", "[LazyClearVector]")
     REQUIRE(test_vector_2[2] == 5);
 }
 
+namespace
+{
+template <typename VectorT> void test_generation_overflow()
+{
+    using counter_t = typename VectorT::counter_t;
+
+    VectorT test_vector(3, 5);
+    const auto &const_vector = test_vector;
+    test_vector[0] = 1;
+    test_vector[2] = 3;
+    REQUIRE(const_vector[0] == 1);
+    REQUIRE(const_vector[1] == 5);
+    REQUIRE(test_vector.peek(2) == 3);
+
+    // a value written in every generation has to survive until the next clear,
+    // even across the overflow of the generation counter
+    const auto num_clears = std::min<std::uint64_t>(
+        2 * static_cast<std::uint64_t>(std::numeric_limits<counter_t>::max()), 1u << 17);
+    for (std::uint64_t idx = 0; idx < num_clears; ++idx)
+    {
+        test_vector.clear();
+        REQUIRE(const_vector[0] == 5);
+        REQUIRE(const_vector[2] == 5);
+        test_vector[0] = static_cast<int>(idx % 7);
+        REQUIRE(test_vector[0] == static_cast<int>(idx % 7));
+    }
+    test_vector.clear();
+    REQUIRE(test_vector[0] == 5);
+    REQUIRE(test_vector[1] == 5);
+    REQUIRE(test_vector[2] == 5);
+}
+}
+
+TEST_CASE("Lazy clear vectors with different generation widths", "[LazyClearVector]")
+{
+    test_generation_overflow<LazyClearVector<int, std::uint8_t>>();
+    test_generation_overflow<LazyClearVector<int, std::uint16_t>>();
+    test_generation_overflow<LazyClearVector<int, std::uint32_t>>();
+    test_generation_overflow<PackedLazyClearVector<int, std::uint8_t>>();
+    test_generation_overflow<PackedLazyClearVector<int, std::uint16_t>>();
+    test_generation_overflow<PackedLazyClearVector<int, std::uint32_t>>();
+}
+
+TEST_CASE("Lazy clear vector of bools", "[LazyClearVector]")
+{
+    LazyClearVector<bool, std::uint8_t> test_vector(2, false);
+    for (auto idx : irange(0, 600))
+    {
+        test_vector.clear();
+        test_vector[idx % 2] = true;
+        REQUIRE(test_vector[idx % 2]);
+        REQUIRE(!test_vector[(idx + 1) % 2]);
+    }
+}
@@ -0,0 +1,101 @@
+#include "common/many_to_many.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/graph_transform.hpp"
+#include "common/id_queue.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::int32_t>;
+using TestCostVector = CostVector<TestGraph>;
+
+// Grid with random weights and some one-way streets
+TestGraph make_grid(const unsigned width, const unsigned height, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(1, 100);
+    std::uniform_int_distribution<unsigned> oneway_distribution(0, 9);
+
+    std::vector<TestGraph::edge_t> edges;
+    const auto id = [width](unsigned x, unsigned y) { return y * width + x; };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            if (x + 1 < width) {
+                edges.push_back({id(x, y), id(x + 1, y), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x + 1, y), id(x, y), weight_distribution(generator)});
+            }
+            if (y + 1 < height) {
+                edges.push_back({id(x, y), id(x, y + 1), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x, y + 1), id(x, y), weight_distribution(generator)});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return TestGraph{width * height, edges};
+}
+
+void check_table(const TestGraph &graph, const std::vector<TestGraph::weight_t> &table,
+                 const std::vector<TestGraph::node_id_t> &sources,
+                 const std::vector<TestGraph::node_id_t> &targets) {
+    MinIDQueue queue(graph.num_nodes());
+    TestCostVector costs(graph.num_nodes(), INF_WEIGHT);
+
+    REQUIRE(table.size() == sources.size() * targets.size());
+    for (auto source_index = 0u; source_index < sources.size(); ++source_index) {
+        dijkstra_to_all(sources[source_index], graph, queue, costs);
+        for (auto target_index = 0u; target_index < targets.size(); ++target_index) {
+            CHECK(table[source_index * targets.size() + target_index] ==
+                  costs[targets[target_index]]);
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Many-to-many table on a grid", "[ManyToMany]") {
+    const auto forward_graph = make_grid(12, 10, 1337);
+    const auto reverse_graph = invert(forward_graph);
+    ManyToMany<TestGraph> many_to_many(forward_graph, reverse_graph);
+
+    // more targets than sources searches forward
+    std::vector<TestGraph::node_id_t> few{0, 17, 17, 119};
+    std::vector<TestGraph::node_id_t> many{3, 5, 8, 13, 21, 34, 55, 89, 0};
+    check_table(forward_graph, many_to_many(few, many), few, many);
+    // more sources than targets searches backward
+    check_table(forward_graph, many_to_many(many, few, 2), many, few);
+
+    std::vector<TestGraph::node_id_t> none;
+    REQUIRE(many_to_many(none, many).empty());
+    REQUIRE(many_to_many(few, none).empty());
+}
+
+TEST_CASE("Many-to-many table with shifted weights", "[ManyToMany]") {
+    // 0 -> 1 -> 2 <-> 3 with negative weights going downhill
+    std::vector<TestGraph::edge_t> edges{{0, 1, 5}, {1, 2, -2}, {2, 3, 4}, {3, 2, -3}};
+    const TestGraph graph{4, edges};
+    const std::vector<std::int32_t> potential{10, 10, 6, 10};
+
+    auto shifted_graph = graph;
+    for (const auto start : shifted_graph.nodes()) {
+        for (const auto edge : shifted_graph.edges(start)) {
+            shifted_graph.weight(edge) += potential[start] - potential[shifted_graph.target(edge)];
+            REQUIRE(shifted_graph.weight(edge) >= 0);
+        }
+    }
+    const auto reverse_graph = invert(shifted_graph);
+    ManyToMany<TestGraph> many_to_many(shifted_graph, reverse_graph, potential);
+
+    const std::vector<TestGraph::node_id_t> sources{0, 3};
+    const std::vector<TestGraph::node_id_t> targets{1, 2, 3, 0};
+    const std::vector<TestGraph::weight_t> reference{5, 3, 7, 0, INF_WEIGHT, -3, 0, INF_WEIGHT};
+    REQUIRE(many_to_many(sources, targets) == reference);
+}
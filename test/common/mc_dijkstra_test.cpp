@@ -2,10 +2,13 @@
 
 #include "common/id_queue.hpp"
 #include "common/path.hpp"
+#include "common/search_space.hpp"
 #include "common/weighted_graph.hpp"
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
 using namespace charge;
@@ -49,6 +52,57 @@ TEST_CASE("Test oneways with MC", "[mc dijkstra]") {
     REQUIRE(reference_labels_1 == result_labels_1);
 }
 
+TEST_CASE("Clearing the labels only resets touched nodes", "[mc dijkstra]") {
+    // 0 -> 1 -> 2 -> 3    4 -> 5
+    //      ^---------|
+    std::vector<TestGraph::edge_t> edges{
+        {0, 1, {1, 2}}, {1, 2, {1, 3}}, {2, 3, {1, 4}}, {3, 1, {1, 2}}, {4, 5, {1, 1}}};
+    TestGraph graph{6, edges};
+    std::vector<Coordinate> coordinates(graph.num_nodes());
+
+    MinIDQueue queue(graph.num_nodes());
+    TestLabels labels(graph.num_nodes());
+
+    mc_dijkstra(0, 3, graph, queue, labels);
+    auto touched_1 = labels.touched_nodes();
+    std::sort(touched_1.begin(), touched_1.end());
+    std::vector<TestGraph::node_id_t> reference_touched_1{0, 1, 2, 3};
+    CHECK(touched_1 == reference_touched_1);
+    auto search_space_1 = get_search_space(labels, coordinates);
+    REQUIRE(search_space_1.size() == 4);
+    CHECK(search_space_1.front().id == 0);
+    CHECK(search_space_1.back().id == 3);
+
+    auto results = mc_dijkstra(4, 5, graph, queue, labels);
+    std::vector<TestLabelEntry> reference{{1, {1, 1}}};
+    CHECK(results == reference);
+    std::vector<TestGraph::node_id_t> reference_touched_2{4, 5};
+    CHECK(labels.touched_nodes() == reference_touched_2);
+    // only touched nodes own label lists
+    CHECK(labels.settled_labels.size() == 2);
+    CHECK(labels.unsettled_labels.size() == 2);
+    // settled costs are mirrored into the hot skyline used by the dominance checks
+    static_assert(TestLabels::has_skyline);
+    REQUIRE(labels.settled_costs.size() == 2);
+    for (const auto slot : {0, 1}) {
+        REQUIRE(labels.settled_costs[slot].size() == labels.settled_labels[slot].size());
+        for (const auto index : irange<std::size_t>(0, labels.settled_costs[slot].size())) {
+            CHECK(labels.settled_costs[slot][index] == labels.settled_labels[slot][index].cost);
+        }
+    }
+    for (const auto node : {0, 1, 2, 3}) {
+        CHECK(labels[node].empty());
+        CHECK(labels.empty(node));
+    }
+    CHECK(get_search_space(labels, coordinates).size() == 2);
+
+    labels.clear();
+    CHECK(labels.touched_nodes().empty());
+    CHECK(labels.settled_labels.empty());
+    CHECK(labels[4].empty());
+    CHECK(labels[5].empty());
+}
+
 TEST_CASE("Test full graph with MC", "[mc dijkstra]") {
     // 0 --- 1 --- 2
     // |  \  |     |
@@ -126,6 +180,51 @@ TEST_CASE("Test full graph with MC", "[mc dijkstra]") {
     REQUIRE(reference_path_6 == common::get_path(0, 5, results_6.back(), labels_with_parents));
 }
 
+TEST_CASE("Global label heap finds the same Pareto sets", "[mc dijkstra]") {
+    // random 6x6 grid with conflicting criteria
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::int32_t> dist(1, 20);
+    std::vector<TestGraph::edge_t> edges;
+    const std::int32_t width = 6;
+    for (const auto node : irange<std::int32_t>(0, width * width)) {
+        const auto x = node % width;
+        const auto y = node / width;
+        for (const auto &[dx, dy] : {std::make_tuple(-1, 0), std::make_tuple(1, 0),
+                                    std::make_tuple(0, -1), std::make_tuple(0, 1)}) {
+            if (x + dx < 0 || x + dx >= width || y + dy < 0 || y + dy >= width)
+                continue;
+            const auto duration = dist(gen);
+            edges.push_back({static_cast<std::uint32_t>(node),
+                             static_cast<std::uint32_t>(node + dx + dy * width),
+                             {duration, 21 - duration + dist(gen) / 4}});
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    TestGraph graph{static_cast<std::size_t>(width * width), edges};
+
+    MinIDQueue queue(graph.num_nodes());
+    LabelHeap<TestLabelEntryWithParent> heap;
+    TestLabelsWithParents queue_labels(graph.num_nodes());
+    TestLabelsWithParents heap_labels(graph.num_nodes());
+    const MCDijkstraPolicy<TestGraph, TestLabelEntryWithParent> policy;
+
+    for (const auto start : {0u, 7u, 20u}) {
+        for (const auto target : graph.nodes()) {
+            const auto queue_results = mc_dijkstra(start, target, graph, queue, queue_labels);
+            const auto heap_results =
+                mc_dijkstra(start, target, graph, heap, heap_labels, policy);
+
+            REQUIRE(heap_results.size() == queue_results.size());
+            for (const auto index : irange<std::size_t>(0, heap_results.size())) {
+                REQUIRE(heap_results[index].cost == queue_results[index].cost);
+                const auto path = get_path(start, target, heap_results[index], heap_labels);
+                CHECK(path.front() == start);
+                CHECK(path.back() == target);
+            }
+        }
+    }
+}
+
 TEST_CASE("Reference graph searches with MC", "[mc dijkstra]") {
     //                        8
     //                        |
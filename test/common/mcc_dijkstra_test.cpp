@@ -2,6 +2,7 @@
 
 #include "common/id_queue.hpp"
 #include "common/node_weights_container.hpp"
+#include "common/parallel_mc_dijkstra.hpp"
 #include "common/path.hpp"
 #include "common/piecewise_functions_aliases.hpp"
 #include "common/weighted_graph.hpp"
@@ -362,4 +363,29 @@ TEST_CASE("Test charging with MCC - with tradeoffs", "[mcc dijkstra]") {
     auto best_2 = results_2.front();
     CHECK(common::from_fixed(std::get<0>(best_2.cost)) == Approx(6));
     CHECK(common::from_fixed(std::get<1>(best_2.cost)) <= 2000);
+
+    // same searches with one global label heap
+    LabelHeap<LimitedTestPolicy::label_t> heap;
+    NodeLabels<LimitedTestPolicy> heap_labels(graph.num_nodes());
+    for (const auto &[start, target] : {std::make_tuple(0, 3), std::make_tuple(4, 3)}) {
+        const auto queue_results =
+            mc_dijkstra(start, target, graph, queue, labels, LimitedTestPolicy{node_weights});
+        const auto heap_results =
+            mc_dijkstra(start, target, graph, heap, heap_labels, LimitedTestPolicy{node_weights});
+        REQUIRE(heap_results.size() == queue_results.size());
+        for (const auto index : irange<std::size_t>(0, heap_results.size())) {
+            CHECK(heap_results[index].cost == queue_results[index].cost);
+            CHECK(get_path(start, target, heap_results[index], heap_labels) ==
+                  get_path(start, target, queue_results[index], labels));
+        }
+
+        // and with the parallel Pareto queue
+        ParetoQueueSearch<LimitedTestPolicy> search(graph.num_nodes(), 2);
+        const auto parallel_results =
+            mc_dijkstra(start, target, graph, search, heap_labels, LimitedTestPolicy{node_weights});
+        REQUIRE(parallel_results.size() == queue_results.size());
+        for (const auto index : irange<std::size_t>(0, parallel_results.size())) {
+            CHECK(parallel_results[index].cost == queue_results[index].cost);
+        }
+    }
 }
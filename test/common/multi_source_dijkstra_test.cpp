@@ -0,0 +1,129 @@
+#include "common/multi_source_dijkstra.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::int32_t>;
+using TestCostVector = CostVector<TestGraph>;
+
+// Grid with random weights and some one-way streets
+TestGraph make_grid(const unsigned width, const unsigned height, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(0, 100);
+    std::uniform_int_distribution<unsigned> oneway_distribution(0, 4);
+
+    std::vector<TestGraph::edge_t> edges;
+    const auto id = [width](unsigned x, unsigned y) { return y * width + x; };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            if (x + 1 < width) {
+                edges.push_back({id(x, y), id(x + 1, y), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x + 1, y), id(x, y), weight_distribution(generator)});
+            }
+            if (y + 1 < height) {
+                edges.push_back({id(x, y), id(x, y + 1), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x, y + 1), id(x, y), weight_distribution(generator)});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return TestGraph{width * height, edges};
+}
+} // namespace
+
+TEST_CASE("Multi-source Dijkstra to all nodes", "[MultiSourceDijkstra]") {
+    const auto graph = make_grid(20, 15, 1337);
+    MultiSourceDijkstra<8, TestGraph> search(graph);
+    MinIDQueue queue(graph.num_nodes());
+    TestCostVector costs(graph.num_nodes(), INF_WEIGHT);
+
+    // the same source twice and less sources than lanes
+    for (const auto &sources : std::vector<std::vector<TestGraph::node_id_t>>{
+             {0, 17, 42, 42, 299, 150, 151, 3}, {7, 100, 250}}) {
+        search.run(sources, {});
+        for (auto lane = 0u; lane < sources.size(); ++lane) {
+            dijkstra_to_all(sources[lane], graph, queue, costs);
+            for (const auto node : graph.nodes()) {
+                REQUIRE(search.cost(node, lane) == costs[node]);
+            }
+        }
+        for (auto lane = sources.size(); lane < 8; ++lane) {
+            for (const auto node : graph.nodes()) {
+                REQUIRE(search.cost(node, lane) == INF_WEIGHT);
+            }
+        }
+    }
+}
+
+TEST_CASE("Multi-source Dijkstra counts closer nodes", "[MultiSourceDijkstra]") {
+    const auto graph = make_grid(20, 15, 42);
+    MultiSourceDijkstra<4, TestGraph> search(graph);
+    using lanes_t = MultiSourceDijkstra<4, TestGraph>::lanes_t;
+    MinIDQueue queue(graph.num_nodes());
+    TestCostVector costs(graph.num_nodes(), INF_WEIGHT);
+
+    const std::vector<TestGraph::node_id_t> sources{3, 77, 201, 299};
+    const std::vector<TestGraph::node_id_t> targets{5, 78, 120};
+    search.run(sources, {targets, targets, targets, targets});
+
+    std::vector<lanes_t> thresholds(targets.size());
+    for (auto index = 0u; index < targets.size(); ++index) {
+        for (auto lane = 0u; lane < sources.size(); ++lane) {
+            thresholds[index].costs[lane] = search.cost(targets[index], lane);
+        }
+    }
+    const auto counts = count_smaller(search, thresholds);
+
+    for (auto lane = 0u; lane < sources.size(); ++lane) {
+        dijkstra_to_all(sources[lane], graph, queue, costs);
+        for (auto index = 0u; index < targets.size(); ++index) {
+            const auto target_cost = costs[targets[index]];
+            REQUIRE(search.cost(targets[index], lane) == target_cost);
+
+            std::int32_t num_closer = 0;
+            for (const auto node : graph.nodes()) {
+                num_closer += costs[node] < target_cost;
+            }
+            REQUIRE(counts[index].costs[lane] == num_closer);
+        }
+    }
+}
+
+TEST_CASE("Multi-source Dijkstra with different targets per lane", "[MultiSourceDijkstra]") {
+    const auto graph = make_grid(20, 15, 7);
+    MultiSourceDijkstra<8, TestGraph> search(graph);
+    MinIDQueue queue(graph.num_nodes());
+    TestCostVector costs(graph.num_nodes(), INF_WEIGHT);
+
+    // close and far targets, a lane with two targets and the source as target
+    const std::vector<TestGraph::node_id_t> sources{0, 21, 150, 299, 42};
+    const std::vector<std::vector<TestGraph::node_id_t>> targets{
+        {1}, {299}, {151, 0}, {299}, {180}};
+    search.run(sources, targets);
+
+    for (auto lane = 0u; lane < sources.size(); ++lane) {
+        dijkstra_to_all(sources[lane], graph, queue, costs);
+        std::int32_t max_target_cost = 0;
+        for (const auto target : targets[lane]) {
+            REQUIRE(search.cost(target, lane) == costs[target]);
+            max_target_cost = std::max(max_target_cost, costs[target]);
+        }
+        for (const auto node : graph.nodes()) {
+            if (costs[node] < max_target_cost)
+                REQUIRE(search.cost(node, lane) == costs[node]);
+        }
+    }
+}
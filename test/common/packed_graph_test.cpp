@@ -0,0 +1,77 @@
+#include "common/packed_graph.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/fp_dijkstra.hpp"
+#include "common/id_queue.hpp"
+
+#include "ev/graph.hpp"
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+TEST_CASE("Packed graph has the same edges as the weighted graph", "[PackedWeightedGraph]") {
+    // 0 -> 1 -> 3
+    // |    ^
+    // v    |
+    // 2 ---|    4
+    std::vector<WeightedGraph<std::int32_t>::edge_t> edges{
+        {0, 1, 3}, {0, 2, 1}, {1, 3, 5}, {2, 1, 1}};
+    WeightedGraph<std::int32_t> graph{5, edges};
+    PackedWeightedGraph<std::int32_t> packed{graph};
+
+    REQUIRE(packed.num_nodes() == graph.num_nodes());
+    REQUIRE(packed.num_edges() == graph.num_edges());
+    for (const auto node : graph.nodes()) {
+        REQUIRE(packed.begin(node) == graph.begin(node));
+        REQUIRE(packed.end(node) == graph.end(node));
+        for (const auto edge : graph.edges(node)) {
+            CHECK(packed.target(edge) == graph.target(edge));
+            CHECK(packed.weight(edge) == graph.weight(edge));
+        }
+    }
+    CHECK(packed.edges() == graph.edges());
+    CHECK(packed.edge(2, 1) == graph.edge(2, 1));
+    CHECK(packed.edge(4, 0) == INVALID_ID);
+
+    MinIDQueue queue(graph.num_nodes());
+    CostVector<WeightedGraph<std::int32_t>> costs(graph.num_nodes(), INF_WEIGHT);
+    CostVector<PackedWeightedGraph<std::int32_t>> packed_costs(graph.num_nodes(), INF_WEIGHT);
+    dijkstra_to_all(0, graph, queue, costs);
+    dijkstra_to_all(0, packed, queue, packed_costs);
+    for (const auto node : graph.nodes()) {
+        CHECK(costs[node] == packed_costs[node]);
+    }
+    CHECK(packed_costs[3] == 7);
+}
+
+TEST_CASE("Packed tradeoff edges are cache line aligned", "[PackedWeightedGraph]") {
+    static_assert(alignof(ev::PackedTradeoffGraph::EdgeRecord) == CACHE_LINE_SIZE);
+    static_assert(sizeof(ev::PackedTradeoffGraph::EdgeRecord) == CACHE_LINE_SIZE);
+
+    std::vector<HypLinGraph::edge_t> edges{{0, 1, ev::make_constant(1, 2)},
+                                           {0, 2, ev::make_constant(2, 1)},
+                                           {1, 3, ev::make_constant(1, 4)},
+                                           {2, 3, ev::make_constant(1, 3)}};
+    HypLinGraph graph{4, edges};
+    ev::PackedTradeoffGraph packed{graph};
+    for (const auto edge : irange<HypLinGraph::edge_id_t>(0, packed.num_edges())) {
+        // target and weight of an edge share one cache line
+        const auto address = reinterpret_cast<std::uintptr_t>(&packed.weight(edge));
+        const auto offset = address % CACHE_LINE_SIZE;
+        CHECK(offset + sizeof(HypLinGraph::weight_t) <= CACHE_LINE_SIZE);
+    }
+
+    using LabelEntryT = LabelEntry<HypLinGraph::weight_t, HypLinGraph::node_id_t>;
+    using PolicyT = FPDijkstraPolicy<HypLinGraph, LabelEntryT>;
+    MinIDQueue queue(graph.num_nodes());
+    NodeLabels<PolicyT> labels(graph.num_nodes());
+    const auto results = fp_dijkstra(0, 3, graph, queue, labels, PolicyT{});
+    const auto packed_results = fp_dijkstra(0, 3, packed, queue, labels, PolicyT{});
+    REQUIRE(results.size() == 2);
+    CHECK(results == packed_results);
+}
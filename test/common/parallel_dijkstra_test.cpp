@@ -0,0 +1,123 @@
+#include "common/parallel_dijkstra.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/graph_transform.hpp"
+#include "common/id_queue.hpp"
+#include "common/path.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::int32_t>;
+using TestCostVector = CostVector<TestGraph>;
+using TestParentVector = ParentVector<TestGraph>;
+
+// Grid with random weights and some one-way streets
+TestGraph make_grid(const unsigned width, const unsigned height, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(0, 100);
+    std::uniform_int_distribution<unsigned> oneway_distribution(0, 4);
+
+    std::vector<TestGraph::edge_t> edges;
+    const auto id = [width](unsigned x, unsigned y) { return y * width + x; };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            if (x + 1 < width) {
+                edges.push_back({id(x, y), id(x + 1, y), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x + 1, y), id(x, y), weight_distribution(generator)});
+            }
+            if (y + 1 < height) {
+                edges.push_back({id(x, y), id(x, y + 1), weight_distribution(generator)});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x, y + 1), id(x, y), weight_distribution(generator)});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return TestGraph{width * height, edges};
+}
+} // namespace
+
+TEST_CASE("Parallel bidirectional Dijkstra", "[dijkstra]") {
+    const auto forward_graph = make_grid(15, 12, 1337);
+    const auto reverse_graph = invert(forward_graph);
+    const auto num_nodes = forward_graph.num_nodes();
+
+    MinIDQueue queue(num_nodes);
+    MinIDQueue forward_queue(num_nodes);
+    MinIDQueue reverse_queue(num_nodes);
+    TestCostVector costs(num_nodes, INF_WEIGHT);
+    TestCostVector forward_costs(num_nodes, INF_WEIGHT);
+    TestCostVector reverse_costs(num_nodes, INF_WEIGHT);
+    TestParentVector forward_parents(num_nodes, INVALID_ID);
+    TestParentVector reverse_parents(num_nodes, INVALID_ID);
+    ParallelDijkstraState<TestGraph> state(num_nodes);
+
+    for (auto start = 0u; start < num_nodes; start += 5) {
+        dijkstra_to_all(start, forward_graph, queue, costs);
+        for (auto target = 0u; target < num_nodes; target += 3) {
+            TestGraph::node_id_t middle;
+            const auto cost = parallel_dijkstra(start, target, forward_graph, reverse_graph,
+                                                forward_queue, reverse_queue, forward_costs,
+                                                reverse_costs, forward_parents, reverse_parents,
+                                                middle, state);
+            REQUIRE(cost == costs[target]);
+
+            if (cost != INF_WEIGHT) {
+                const auto path = get_path<TestGraph>(start, middle, target, forward_parents,
+                                                      reverse_parents);
+                REQUIRE(path.front() == start);
+                REQUIRE(path.back() == target);
+                TestGraph::weight_t path_cost = 0;
+                for (auto index = 0u; index + 1 < path.size(); ++index) {
+                    auto edge = forward_graph.edge(path[index], path[index + 1]);
+                    REQUIRE(edge != INVALID_ID);
+                    path_cost += forward_graph.weight(edge);
+                }
+                REQUIRE(path_cost == cost);
+            } else {
+                REQUIRE(middle == INVALID_ID);
+            }
+        }
+    }
+}
+
+TEST_CASE("Parallel bidirectional Dijkstra on oneways", "[dijkstra]") {
+    // 0 -> 1 -> 2 -> 3
+    //      ^---------|
+    std::vector<TestGraph::edge_t> edges{{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 1, 1}};
+    TestGraph forward_graph{4, edges};
+    TestGraph reverse_graph = invert(forward_graph);
+
+    MinIDQueue forward_queue(4);
+    MinIDQueue reverse_queue(4);
+    TestCostVector forward_costs(4, INF_WEIGHT);
+    TestCostVector reverse_costs(4, INF_WEIGHT);
+    TestParentVector forward_parents(4, INVALID_ID);
+    TestParentVector reverse_parents(4, INVALID_ID);
+    ParallelDijkstraState<TestGraph> state(4);
+    // copies share nothing with the original
+    auto state_copy = state;
+    TestGraph::node_id_t middle;
+
+    const auto query = [&](const auto start, const auto target) {
+        return parallel_dijkstra(start, target, forward_graph, reverse_graph, forward_queue,
+                                 reverse_queue, forward_costs, reverse_costs, forward_parents,
+                                 reverse_parents, middle, state_copy);
+    };
+    REQUIRE(query(0u, 3u) == 3);
+    REQUIRE(query(3u, 0u) == INF_WEIGHT);
+    REQUIRE(query(1u, 3u) == 2);
+    REQUIRE(query(3u, 1u) == 1);
+    REQUIRE(query(2u, 2u) == 0);
+    REQUIRE(middle == 2);
+}
@@ -0,0 +1,114 @@
+#include "common/parallel_mc_dijkstra.hpp"
+
+#include "common/id_queue.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/path.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::tuple<std::int32_t, std::int32_t>>;
+using TestLabelEntry = LabelEntryWithParent<TestGraph::weight_t, TestGraph::node_id_t>;
+using TestPolicy = MCDijkstraPolicy<TestGraph, TestLabelEntry>;
+
+// Grid with conflicting criteria and some one-way streets
+TestGraph make_grid(const unsigned width, const unsigned height, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(1, 20);
+    std::uniform_int_distribution<unsigned> oneway_distribution(0, 4);
+
+    const auto random_weight = [&]() {
+        const auto duration = weight_distribution(generator);
+        return std::tuple<std::int32_t, std::int32_t>{
+            duration, 21 - duration + weight_distribution(generator) / 4};
+    };
+
+    std::vector<TestGraph::edge_t> edges;
+    const auto id = [width](unsigned x, unsigned y) { return y * width + x; };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            if (x + 1 < width) {
+                edges.push_back({id(x, y), id(x + 1, y), random_weight()});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x + 1, y), id(x, y), random_weight()});
+            }
+            if (y + 1 < height) {
+                edges.push_back({id(x, y), id(x, y + 1), random_weight()});
+                if (oneway_distribution(generator) > 0)
+                    edges.push_back({id(x, y + 1), id(x, y), random_weight()});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return TestGraph{width * height, edges};
+}
+} // namespace
+
+TEST_CASE("Pareto queue search finds the same Pareto sets", "[parallel mc dijkstra]") {
+    const auto graph = make_grid(8, 8, 1337);
+    const TestPolicy policy;
+
+    MinIDQueue queue(graph.num_nodes());
+    NodeLabels<TestPolicy> reference_labels(graph.num_nodes());
+    NodeLabels<TestPolicy> labels(graph.num_nodes());
+
+    for (const auto num_threads : {1, 4}) {
+        for (const auto batch_size : {1, 5, 1024}) {
+            ParetoQueueSearch<TestPolicy> search(graph.num_nodes(), num_threads, batch_size);
+            CHECK(search.threads() == num_threads);
+
+            for (const auto start : {0u, 27u, 63u}) {
+                for (const auto target : {7u, 36u, 56u, 63u}) {
+                    const auto reference =
+                        mc_dijkstra(start, target, graph, queue, reference_labels, policy);
+                    const auto results = mc_dijkstra(start, target, graph, search, labels, policy);
+
+                    REQUIRE(results.size() == reference.size());
+                    for (const auto index : irange<std::size_t>(0, results.size())) {
+                        REQUIRE(results[index].cost == reference[index].cost);
+
+                        // the path has to add up to the cost of the label
+                        const auto path = get_path(start, target, results[index], labels);
+                        CHECK(path.front() == start);
+                        CHECK(path.back() == target);
+                        TestGraph::weight_t path_cost{0, 0};
+                        for (const auto path_index : irange<std::size_t>(1, path.size())) {
+                            const auto edge = graph.edge(path[path_index - 1], path[path_index]);
+                            REQUIRE(edge != INVALID_ID);
+                            path_cost = policy.link(path_cost, graph.weight(edge));
+                        }
+                        CHECK(path_cost == results[index].cost);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Copying a Pareto queue search keeps the configuration", "[parallel mc dijkstra]") {
+    const auto graph = make_grid(3, 3, 42);
+    const TestPolicy policy;
+
+    ParetoQueueSearch<TestPolicy> search(graph.num_nodes(), 3, 2);
+    NodeLabels<TestPolicy> labels(graph.num_nodes());
+    mc_dijkstra(0, 8, graph, search, labels, policy);
+
+    auto copy = search;
+    CHECK(copy.threads() == 3);
+
+    NodeLabels<TestPolicy> copy_labels(graph.num_nodes());
+    const auto results = mc_dijkstra(0, 8, graph, copy, copy_labels, policy);
+    const auto reference = mc_dijkstra(0, 8, graph, search, labels, policy);
+    REQUIRE(results.size() == reference.size());
+    for (const auto index : irange<std::size_t>(0, results.size())) {
+        CHECK(results[index].cost == reference[index].cost);
+    }
+}
@@ -0,0 +1,128 @@
+#include "common/radix_id_queue.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/weighted_graph.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::int32_t>;
+using TestCostVector = CostVector<TestGraph>;
+}
+
+TEST_CASE("Simple radix queue operations", "[RadixMinIDQueue]") {
+    RadixMinIDQueue queue(5);
+
+    REQUIRE(queue.empty());
+    queue.push({0, 10});
+    queue.push({1, 3});
+    queue.push({2, 7});
+    queue.push({3, 3});
+    REQUIRE(queue.size() == 4);
+    REQUIRE(queue.contains_id(2));
+    REQUIRE(!queue.contains_id(4));
+    REQUIRE(queue.get_key(0) == 10);
+
+    REQUIRE(queue.peek().key == 3);
+    auto first = queue.pop();
+    auto second = queue.pop();
+    REQUIRE(first.key == 3);
+    REQUIRE(second.key == 3);
+    REQUIRE(first.id != second.id);
+
+    // keys can still be decreased down to the last removed key
+    REQUIRE(queue.decrease_key({0, 5}));
+    REQUIRE(!queue.decrease_key({2, 8}));
+    REQUIRE(queue.increase_key({2, 9}));
+    queue.push({4, 3});
+
+    REQUIRE(queue.pop().id == 4);
+    REQUIRE(queue.pop().id == 0);
+    REQUIRE(queue.pop().key == 9);
+    REQUIRE(queue.empty());
+
+    queue.push({1, 100});
+    queue.clear();
+    REQUIRE(queue.empty());
+    REQUIRE(!queue.contains_id(1));
+    // after a clear smaller keys are valid again
+    queue.push({1, 1});
+    REQUIRE(queue.pop().key == 1);
+}
+
+TEST_CASE("Radix queue matches MinIDQueue", "[RadixMinIDQueue]") {
+    const unsigned num_ids = 1000;
+    RadixMinIDQueue radix_queue(num_ids);
+    MinIDQueue heap_queue(num_ids);
+
+    std::mt19937 generator(1337);
+    std::uniform_int_distribution<unsigned> id_distribution(0, num_ids - 1);
+    std::uniform_int_distribution<std::int32_t> delta_distribution(0, 1 << 8);
+
+    // keys are unique per id so both queues need to agree on the order
+    const auto make_key = [&](std::int32_t last_key, unsigned id) {
+        return (last_key / num_ids + 1 + delta_distribution(generator)) * num_ids + id;
+    };
+
+    std::int32_t last_key = 0;
+    for (auto round = 0; round < 10000; ++round) {
+        const auto id = id_distribution(generator);
+        const std::int32_t key = make_key(last_key, id);
+
+        REQUIRE(radix_queue.contains_id(id) == heap_queue.contains_id(id));
+        if (radix_queue.contains_id(id)) {
+            REQUIRE(radix_queue.decrease_key({id, key}) == heap_queue.decrease_key({id, key}));
+        } else {
+            radix_queue.push({id, key});
+            heap_queue.push({id, key});
+        }
+        // peek() counts as removal for the monotonicity of the radix queue
+        REQUIRE(radix_queue.peek().key == heap_queue.peek().key);
+        last_key = heap_queue.peek().key;
+
+        if (round % 3 == 0) {
+            const auto radix_top = radix_queue.pop();
+            const auto heap_top = heap_queue.pop();
+            REQUIRE(radix_top.id == heap_top.id);
+            REQUIRE(radix_top.key == heap_top.key);
+        }
+        REQUIRE(radix_queue.size() == heap_queue.size());
+    }
+
+    while (!heap_queue.empty()) {
+        REQUIRE(radix_queue.pop().id == heap_queue.pop().id);
+    }
+    REQUIRE(radix_queue.empty());
+}
+
+TEST_CASE("Dijkstra with radix queue", "[RadixMinIDQueue]") {
+    // 0 -> 1 -> 2 -> 3 -> 4
+    // |              ^
+    // |--------------|
+    std::vector<TestGraph::edge_t> edges{{0, 1, 1}, {0, 3, 5}, {1, 2, 1}, {2, 3, 1}, {3, 4, 0}};
+    TestGraph graph{5, edges};
+
+    RadixMinIDQueue radix_queue(graph.num_nodes());
+    MinIDQueue heap_queue(graph.num_nodes());
+    TestCostVector radix_costs(graph.num_nodes(), INF_WEIGHT);
+    TestCostVector heap_costs(graph.num_nodes(), INF_WEIGHT);
+
+    for (const auto start : graph.nodes()) {
+        dijkstra_to_all(start, graph, radix_queue, radix_costs);
+        dijkstra_to_all(start, graph, heap_queue, heap_costs);
+        for (const auto node : graph.nodes()) {
+            REQUIRE(radix_costs[node] == heap_costs[node]);
+        }
+    }
+
+    dijkstra_to_all(0, graph, radix_queue, radix_costs);
+    REQUIRE(radix_costs[3] == 3);
+    REQUIRE(radix_costs[4] == 3);
+}
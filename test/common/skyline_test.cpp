@@ -0,0 +1,195 @@
+#include "common/skyline.hpp"
+
+#include "common/domination.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/weighted_graph.hpp"
+
+#include "ev/charging_function_container.hpp"
+#include "ev/mcc_dijkstra.hpp"
+
+#include <catch.hpp>
+
+#include <memory_resource>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using cost_t = std::tuple<std::int32_t, std::int32_t>;
+
+std::vector<cost_t> to_vector(const Skyline<cost_t> &skyline) {
+    std::vector<cost_t> costs;
+    for (std::size_t index = 0; index < skyline.size(); ++index) {
+        costs.push_back(skyline[index]);
+    }
+    return costs;
+}
+
+// Same as the MCC policy but checks dominance by scanning the settled labels
+struct ScanningChargingPolicy : ev::DurationConsumptionChargingDijkstraPolicyWithParents {
+    using ev::DurationConsumptionChargingDijkstraPolicyWithParents::
+        DurationConsumptionChargingDijkstraPolicy;
+    static constexpr bool sorted_skyline = false;
+};
+} // namespace
+
+TEST_CASE("Insert into skyline", "[skyline]") {
+    Skyline<cost_t> skyline(std::pmr::new_delete_resource());
+
+    CHECK(skyline.insert(cost_t{5, 5}));
+    CHECK(skyline.insert(cost_t{3, 7}));
+    CHECK(skyline.insert(cost_t{7, 2}));
+    const std::vector<cost_t> reference_1{{3, 7}, {5, 5}, {7, 2}};
+    CHECK(to_vector(skyline) == reference_1);
+
+    // dominated or equal
+    CHECK(!skyline.insert(cost_t{5, 5}));
+    CHECK(!skyline.insert(cost_t{6, 5}));
+    CHECK(!skyline.insert(cost_t{8, 2}));
+    CHECK(to_vector(skyline) == reference_1);
+
+    // dominates {5, 5} and {7, 2}
+    CHECK(skyline.insert(cost_t{5, 1}));
+    const std::vector<cost_t> reference_2{{3, 7}, {5, 1}};
+    CHECK(to_vector(skyline) == reference_2);
+
+    // same first criterion but better
+    CHECK(skyline.insert(cost_t{3, 6}));
+    const std::vector<cost_t> reference_3{{3, 6}, {5, 1}};
+    CHECK(to_vector(skyline) == reference_3);
+
+    const auto range = skyline.range();
+    CHECK(!range.any_within(2, 100));
+    CHECK(range.any_within(3, 6));
+    CHECK(!range.any_within(4, 5));
+    CHECK(range.any_within(5, 1));
+    CHECK(!range.any_within(100, 0));
+}
+
+TEST_CASE("Skyline dominance matches linear scan", "[skyline]") {
+    using TestGraph = WeightedGraph<cost_t>;
+    using PolicyT =
+        MCDijkstraPolicy<TestGraph, LabelEntry<TestGraph::weight_t, TestGraph::node_id_t>>;
+    static_assert(has_sorted_skyline<PolicyT>::value);
+
+    std::mt19937 gen(1337);
+
+    // small ranges cover the block scan, large ones the binary search
+    for (const std::int32_t max_value : {50, 2000}) {
+        std::uniform_int_distribution<std::int32_t> dist(0, max_value);
+        for (const std::int32_t epsilon : {0, 3, 20}) {
+            std::vector<cost_t> all;
+            Skyline<cost_t> skyline(std::pmr::new_delete_resource());
+            for (auto round = 0; round < 2000; ++round) {
+                const cost_t cost{dist(gen), dist(gen)};
+
+                bool linear = false;
+                for (const auto &lhs : all) {
+                    linear = linear ||
+                             epsilon_dominates_lexicographical(lhs, cost, epsilon, epsilon);
+                }
+                const auto range = skyline.range();
+                REQUIRE(range.any_within(std::get<0>(cost) + epsilon,
+                                         std::get<1>(cost) + epsilon) == linear);
+
+                if (epsilon == 0) {
+                    const auto[policy_dominated, policy_modified] =
+                        PolicyT::clip_dominated(range, cost);
+                    CHECK(policy_dominated == linear);
+                    CHECK(policy_modified == linear);
+                    CHECK(PolicyT::dominates(range, cost) == PolicyT::dominates(all, cost));
+                }
+
+                all.push_back(cost);
+                skyline.insert(cost);
+
+                for (std::size_t index = 1; index < skyline.size(); ++index) {
+                    REQUIRE(std::get<0>(skyline[index - 1]) < std::get<0>(skyline[index]));
+                    REQUIRE(std::get<1>(skyline[index - 1]) > std::get<1>(skyline[index]));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Block scan matches scalar scan", "[skyline]") {
+    std::vector<std::int32_t> firsts;
+    std::vector<std::int32_t> seconds;
+    for (std::int32_t index = 0; index < 37; ++index) {
+        firsts.push_back(2 * index);
+        seconds.push_back(100 - 2 * index);
+    }
+
+    for (std::int32_t first_bound = -1; first_bound < 80; ++first_bound) {
+        for (std::int32_t second_bound = 20; second_bound < 102; ++second_bound) {
+            for (const std::size_t size : {0, 5, 8, 16, 37}) {
+                const auto scalar = detail::any_within_bounds<std::int32_t, std::int32_t>(
+                    firsts.data(), seconds.data(), size, first_bound, second_bound);
+                REQUIRE(detail::any_within_bounds(firsts.data(), seconds.data(), size,
+                                                  first_bound, second_bound) == scalar);
+            }
+        }
+    }
+}
+
+TEST_CASE("MCC searches with and without the skyline agree", "[skyline]") {
+    using SkylinePolicy = ev::DurationConsumptionChargingDijkstraPolicyWithParents;
+    static_assert(NodeLabels<SkylinePolicy>::has_skyline);
+    static_assert(!NodeLabels<ScanningChargingPolicy>::has_skyline);
+
+    // random grid, durations in deci-seconds and consumptions in deci-Wh
+    const unsigned width = 8;
+    std::mt19937 gen(1337);
+    std::uniform_int_distribution<std::int32_t> dist(1, 20);
+    std::vector<ev::DurationConsumptionGraph::edge_t> edges;
+    for (unsigned node = 0; node < width * width; ++node) {
+        for (const auto neighbour : {node + 1, node + width}) {
+            if ((neighbour == node + 1 && neighbour % width == 0) || neighbour >= width * width)
+                continue;
+            for (const auto &[from, to] : {std::make_pair(node, neighbour),
+                                          std::make_pair(neighbour, node)}) {
+                const auto duration = dist(gen);
+                edges.push_back({from, to, {to_fixed(50) * duration,
+                                            to_fixed(50) * (21 - duration + dist(gen) / 4)}});
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    const ev::DurationConsumptionGraph graph{width * width, edges};
+
+    const double capacity = 5000;
+    std::vector<double> charging_rates(graph.num_nodes(), 0);
+    charging_rates[19] = 22000;
+    charging_rates[36] = 50000;
+    const ev::ChargingFunctionContainer chargers{charging_rates, ev::ChargingModel{capacity}};
+
+    MinIDQueue queue(graph.num_nodes());
+    NodeLabels<SkylinePolicy> skyline_labels(graph.num_nodes());
+    NodeLabels<ScanningChargingPolicy> scanning_labels(graph.num_nodes());
+    const SkylinePolicy skyline_policy{0, 0, to_fixed(capacity), to_fixed(60), chargers};
+    const ScanningChargingPolicy scanning_policy{0, 0, to_fixed(capacity), to_fixed(60),
+                                                 chargers};
+    const ZeroNodePotentials<ev::DurationConsumptionGraph> potentials;
+
+    std::size_t num_solutions = 0;
+    for (const auto start : {0u, 7u, 56u}) {
+        for (const auto target : {63u, 27u}) {
+            const auto skyline_results =
+                mc_dijkstra(start, target, graph, queue, skyline_labels, potentials,
+                            skyline_policy);
+            const auto scanning_results =
+                mc_dijkstra(start, target, graph, queue, scanning_labels, potentials,
+                            scanning_policy);
+            num_solutions += skyline_results.size();
+
+            REQUIRE(skyline_results.size() == scanning_results.size());
+            for (const auto index : irange<std::size_t>(0, skyline_results.size())) {
+                CHECK(skyline_results[index].cost == scanning_results[index].cost);
+            }
+        }
+    }
+    CHECK(num_solutions > 0);
+}
@@ -0,0 +1,214 @@
+#include "common/soa_id_queue.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/fp_dijkstra.hpp"
+#include "common/id_queue.hpp"
+#include "common/mc_dijkstra.hpp"
+#include "common/weighted_graph.hpp"
+
+#include "ev/limited_tradeoff_function.hpp"
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace charge;
+using namespace charge::common;
+
+namespace {
+using TestGraph = WeightedGraph<std::int32_t>;
+using TestCostVector = CostVector<TestGraph>;
+
+template <typename QueueT> void test_simple_operations() {
+    QueueT queue(20);
+
+    REQUIRE(queue.empty());
+    queue.push({0, 10});
+    queue.push({1, 3});
+    queue.push({2, 7});
+    queue.push({3, 3});
+    REQUIRE(queue.size() == 4);
+    REQUIRE(queue.contains_id(2));
+    REQUIRE(!queue.contains_id(4));
+    REQUIRE(queue.get_key(0) == 10);
+
+    REQUIRE(queue.peek().key == 3);
+    auto first = queue.pop();
+    auto second = queue.pop();
+    REQUIRE(first.key == 3);
+    REQUIRE(second.key == 3);
+    REQUIRE(first.id != second.id);
+    REQUIRE(!queue.contains_id(first.id));
+
+    REQUIRE(queue.decrease_key({0, 5}));
+    REQUIRE(!queue.decrease_key({2, 8}));
+    REQUIRE(queue.increase_key({2, 9}));
+    REQUIRE(!queue.increase_key({2, 1}));
+    queue.push({4, 3});
+
+    REQUIRE(queue.pop().id == 4);
+    REQUIRE(queue.pop().id == 0);
+    REQUIRE(queue.pop().key == 9);
+    REQUIRE(queue.empty());
+
+    // enough elements for more than one level of full children blocks
+    for (unsigned id = 0; id < 20; ++id)
+        queue.push({id, static_cast<std::int32_t>((id * 7) % 20)});
+    queue.clear();
+    REQUIRE(queue.empty());
+    REQUIRE(!queue.contains_id(1));
+    queue.push({1, 1});
+    REQUIRE(queue.pop().key == 1);
+}
+
+template <typename QueueT> void test_matches_min_id_queue() {
+    const unsigned num_ids = 1000;
+    QueueT soa_queue(num_ids);
+    MinIDQueue heap_queue(num_ids);
+
+    std::mt19937 generator(1337);
+    std::uniform_int_distribution<unsigned> id_distribution(0, num_ids - 1);
+    std::uniform_int_distribution<std::int32_t> key_distribution(0, 1 << 16);
+
+    // keys are unique per id so both queues need to agree on the order
+    const auto make_key = [&](unsigned id) { return key_distribution(generator) * num_ids + id; };
+
+    for (auto round = 0; round < 20000; ++round) {
+        const auto id = id_distribution(generator);
+        const std::int32_t key = make_key(id);
+
+        REQUIRE(soa_queue.contains_id(id) == heap_queue.contains_id(id));
+        if (soa_queue.contains_id(id)) {
+            if (round % 2 == 0) {
+                REQUIRE(soa_queue.decrease_key({id, key}) == heap_queue.decrease_key({id, key}));
+            } else {
+                REQUIRE(soa_queue.increase_key({id, key}) == heap_queue.increase_key({id, key}));
+            }
+            REQUIRE(soa_queue.get_key(id) == heap_queue.get_key(id));
+        } else {
+            soa_queue.push({id, key});
+            heap_queue.push({id, key});
+        }
+        REQUIRE(soa_queue.peek().id == heap_queue.peek().id);
+        REQUIRE(soa_queue.peek().key == heap_queue.peek().key);
+
+        if (round % 3 == 0) {
+            const auto soa_top = soa_queue.pop();
+            const auto heap_top = heap_queue.pop();
+            REQUIRE(soa_top.id == heap_top.id);
+            REQUIRE(soa_top.key == heap_top.key);
+        }
+        REQUIRE(soa_queue.size() == heap_queue.size());
+
+        if (round % 5000 == 4999) {
+            soa_queue.clear();
+            heap_queue.clear();
+        }
+    }
+
+    while (!heap_queue.empty()) {
+        REQUIRE(soa_queue.pop().id == heap_queue.pop().id);
+    }
+    REQUIRE(soa_queue.empty());
+}
+} // namespace
+
+TEST_CASE("Simple SoA queue operations", "[SoAMinIDQueue]") {
+    test_simple_operations<SoAMinIDQueue<2>>();
+    test_simple_operations<SoAMinIDQueue<4>>();
+    test_simple_operations<SoAMinIDQueue<8>>();
+    test_simple_operations<SoAMinIDQueue<16>>();
+}
+
+TEST_CASE("SoA queue matches MinIDQueue", "[SoAMinIDQueue]") {
+    test_matches_min_id_queue<SoAMinIDQueue<4>>();
+    test_matches_min_id_queue<SoAMinIDQueue<8>>();
+}
+
+TEST_CASE("Dijkstra with SoA queue", "[SoAMinIDQueue]") {
+    const unsigned num_nodes = 500;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<unsigned> node_distribution(0, num_nodes - 1);
+    std::uniform_int_distribution<std::int32_t> weight_distribution(0, 100);
+
+    std::vector<TestGraph::edge_t> edges;
+    for (auto index = 0u; index < 4 * num_nodes; ++index) {
+        edges.push_back({node_distribution(generator), node_distribution(generator),
+                         weight_distribution(generator)});
+    }
+    std::sort(edges.begin(), edges.end());
+    TestGraph graph{num_nodes, edges};
+
+    SoAMinIDQueue<8> soa_queue(graph.num_nodes());
+    MinIDQueue heap_queue(graph.num_nodes());
+    TestCostVector soa_costs(graph.num_nodes(), INF_WEIGHT);
+    TestCostVector heap_costs(graph.num_nodes(), INF_WEIGHT);
+
+    for (auto start = 0u; start < num_nodes; start += 7) {
+        dijkstra_to_all(start, graph, soa_queue, soa_costs);
+        dijkstra_to_all(start, graph, heap_queue, heap_costs);
+        for (const auto node : graph.nodes()) {
+            REQUIRE(soa_costs[node] == heap_costs[node]);
+        }
+    }
+}
+
+TEST_CASE("Label setting searches with SoA queue", "[SoAMinIDQueue]") {
+    // 0 --- 1 --- 2
+    // |  \  |     |
+    // 3 --- 4 --- 5
+    // |     |  \  |
+    // 6 --- 7 --- 8
+    const std::vector<std::tuple<unsigned, unsigned, std::int32_t, std::int32_t>> grid{
+        {0, 1, 1, 1}, {0, 3, 1, 1}, {0, 4, 5, 1}, {1, 0, 1, 1}, {1, 2, 1, 1}, {1, 4, 1, 1},
+        {2, 1, 1, 1}, {2, 5, 1, 1}, {3, 0, 1, 1}, {3, 4, 1, 1}, {3, 6, 1, 1}, {4, 1, 1, 1},
+        {4, 3, 1, 1}, {4, 5, 1, 1}, {4, 7, 1, 1}, {4, 8, 5, 1}, {5, 2, 1, 1}, {5, 4, 1, 1},
+        {5, 8, 1, 1}, {6, 3, 1, 1}, {6, 7, 1, 1}, {7, 4, 1, 1}, {7, 6, 1, 1}, {7, 8, 1, 1},
+        {8, 5, 1, 1}, {8, 7, 1, 1}};
+
+    SECTION("mc_dijkstra") {
+        using MCGraph = WeightedGraph<std::tuple<std::int32_t, std::int32_t>>;
+        using Entry = LabelEntry<MCGraph::weight_t, MCGraph::node_id_t>;
+        std::vector<MCGraph::edge_t> edges;
+        for (const auto &[from, to, x, y] : grid)
+            edges.push_back({from, to, {x, y}});
+        MCGraph graph{9, edges};
+
+        MinIDQueue heap_queue(graph.num_nodes());
+        SoAMinIDQueue<8> soa_queue(graph.num_nodes());
+        NodeLabels<MCDijkstraPolicy<MCGraph, Entry>> heap_labels(graph.num_nodes());
+        NodeLabels<MCDijkstraPolicy<MCGraph, Entry, SoAMinIDQueue<8>>> soa_labels(
+            graph.num_nodes());
+
+        for (auto start = 0u; start < graph.num_nodes(); ++start) {
+            for (auto target = 0u; target < graph.num_nodes(); ++target) {
+                const auto heap_result = mc_dijkstra(start, target, graph, heap_queue, heap_labels);
+                const auto soa_result = mc_dijkstra(start, target, graph, soa_queue, soa_labels);
+                REQUIRE(heap_result == soa_result);
+            }
+        }
+    }
+
+    SECTION("fp_dijkstra") {
+        using Entry = LabelEntry<HypLinGraph::weight_t, HypLinGraph::node_id_t>;
+        std::vector<HypLinGraph::edge_t> edges;
+        for (const auto &[from, to, x, y] : grid)
+            edges.push_back({from, to, ev::make_constant(x, y)});
+        HypLinGraph graph{9, edges};
+
+        MinIDQueue heap_queue(graph.num_nodes());
+        SoAMinIDQueue<4> soa_queue(graph.num_nodes());
+        NodeLabels<FPDijkstraPolicy<HypLinGraph, Entry>> heap_labels(graph.num_nodes());
+        NodeLabels<FPDijkstraPolicy<HypLinGraph, Entry, SoAMinIDQueue<4>>> soa_labels(
+            graph.num_nodes());
+
+        for (auto start = 0u; start < graph.num_nodes(); ++start) {
+            for (auto target = 0u; target < graph.num_nodes(); ++target) {
+                const auto heap_result = fp_dijkstra(start, target, graph, heap_queue, heap_labels);
+                const auto soa_result = fp_dijkstra(start, target, graph, soa_queue, soa_labels);
+                REQUIRE(heap_result == soa_result);
+            }
+        }
+    }
+}
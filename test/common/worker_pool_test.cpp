@@ -0,0 +1,48 @@
+#include "common/worker_pool.hpp"
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace charge::common;
+
+TEST_CASE("Worker pool reuses its threads for every job", "[WorkerPool]") {
+    WorkerPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    std::vector<std::thread::id> first_ids(pool.size());
+    pool.run([&](const std::size_t thread_index) {
+        first_ids[thread_index] = std::this_thread::get_id();
+    });
+    CHECK(first_ids[0] == std::this_thread::get_id());
+
+    for (auto job = 0; job < 100; ++job) {
+        std::vector<std::thread::id> ids(pool.size());
+        std::atomic<int> sum{0};
+        pool.run([&](const std::size_t thread_index) {
+            ids[thread_index] = std::this_thread::get_id();
+            sum += job;
+        });
+        // all calls returned before run returns
+        REQUIRE(sum == 4 * job);
+        REQUIRE(ids == first_ids);
+    }
+}
+
+TEST_CASE("Worker pool of one thread runs on the caller", "[WorkerPool]") {
+    WorkerPool pool(1);
+    REQUIRE(pool.size() == 1);
+
+    const auto caller_id = std::this_thread::get_id();
+    std::size_t num_calls = 0;
+    std::thread::id id;
+    pool.run([&](const std::size_t thread_index) {
+        CHECK(thread_index == 0);
+        id = std::this_thread::get_id();
+        ++num_calls;
+    });
+    CHECK(num_calls == 1);
+    CHECK(id == caller_id);
+}
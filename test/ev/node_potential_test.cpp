@@ -1,5 +1,6 @@
 #include "ev/node_potentials.hpp"
 #include "ev/graph_transform.hpp"
+#include "common/delta_stepping.hpp"
 #include "common/graph_transform.hpp"
 
 #include <catch.hpp>
@@ -72,4 +73,15 @@ TEST_CASE("Check omega potential", "[omega potential]")
     CHECK(potential.key(5, 12000, path_45) == 25000);
     CHECK(potential.key(6, 18000, path_56) == 25000);
     CHECK(potential.key(3, 24000, path_63) == 25000);
+
+    // same potentials with the parallel search
+    common::DeltaStepping delta_stepping(graph.num_nodes(), 2);
+    potential.recompute(delta_stepping, 3);
+
+    CHECK(potential.key(0, 0, ev::make_constant(0, 0)) == 8000);
+    CHECK(potential.key(1, 3000, path_01) == 8000);
+    CHECK(potential.key(4, 6000, path_04) == 25000);
+    CHECK(potential.key(5, 12000, path_45) == 25000);
+    CHECK(potential.key(6, 18000, path_56) == 25000);
+    CHECK(potential.key(3, 24000, path_63) == 25000);
 }
@@ -0,0 +1,149 @@
+#include "ev/turn_graph_view.hpp"
+
+#include "common/dijkstra.hpp"
+#include "common/graph_transform.hpp"
+#include "common/hyperbolic_function.hpp"
+#include "common/id_queue.hpp"
+
+#include "ev/fp_dijkstra.hpp"
+#include "ev/graph_transform.hpp"
+#include "ev/mc_dijkstra.hpp"
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace charge;
+
+namespace {
+// 0 --- 1 --- 2
+//       |     |
+//       3 --- 4 --- 5
+ev::TradeoffGraph make_graph() {
+    std::vector<ev::TradeoffGraph::edge_t> edges;
+    const auto add = [&](const ev::TradeoffGraph::node_id_t from,
+                          const ev::TradeoffGraph::node_id_t to, const auto &weight) {
+        edges.push_back({from, to, weight});
+        edges.push_back({to, from, weight});
+    };
+    add(0, 1, ev::make_constant(3, 300));
+    add(1, 2, ev::LimitedTradeoffFunction{3, 7, common::HyperbolicFunction{2500, 2, 100}});
+    add(1, 3, ev::make_constant(6, 100));
+    add(2, 4, ev::make_constant(2, 50));
+    add(3, 4, ev::LimitedTradeoffFunction{2, 3, common::HyperbolicFunction{1000, 1, 200}});
+    add(4, 5, ev::make_constant(4, 200));
+    std::sort(edges.begin(), edges.end());
+    return ev::TradeoffGraph{6, edges};
+}
+
+std::vector<common::Coordinate> make_coordinates() {
+    return {common::Coordinate::from_floating(0.00, 0.01),
+            common::Coordinate::from_floating(0.01, 0.01),
+            common::Coordinate::from_floating(0.02, 0.01),
+            common::Coordinate::from_floating(0.01, 0.00),
+            common::Coordinate::from_floating(0.02, 0.00),
+            common::Coordinate::from_floating(0.03, 0.00)};
+}
+} // namespace
+
+TEST_CASE("Turn graph view has the edges of the turn graph", "[turn graph view]") {
+    const auto graph = make_graph();
+    const auto coordinates = make_coordinates();
+    common::StaticTurnCostModel<ev::TradeoffGraph::Base> model(coordinates);
+
+    const auto turn_graph = common::toTurnGraph<ev::TradeoffGraph::Base>(graph, model);
+    const ev::TradeoffTurnGraph view(graph, ev::TradeoffTurnCost{model});
+
+    REQUIRE(view.num_nodes() == turn_graph.num_nodes());
+
+    std::vector<ev::TradeoffGraph::edge_t> view_edges;
+    for (auto node = 0u; node < view.num_nodes(); ++node) {
+        CHECK(view.start_node(node) == common::edgeToStartNode(graph)[node]);
+        for (auto edge = view.begin(node); edge < view.end(node); ++edge) {
+            view_edges.push_back({node, view.target(edge), view.weight(edge)});
+        }
+    }
+
+    CHECK(view_edges == turn_graph.edges());
+}
+
+TEST_CASE("Searches on the turn graph view", "[turn graph view]") {
+    const auto graph = make_graph();
+    const auto coordinates = make_coordinates();
+    common::StaticTurnCostModel<ev::TradeoffGraph::Base> model(coordinates);
+
+    const auto turn_graph =
+        ev::TradeoffGraph{common::toTurnGraph<ev::TradeoffGraph::Base>(graph, model)};
+    const auto num_edges = graph.num_edges();
+
+    SECTION("dijkstra") {
+        const auto duration_graph = ev::tradeoff_to_min_duration(turn_graph);
+        const ev::MinDurationTurnGraph view(graph, ev::MinDurationTurnCost{model});
+
+        common::MinIDQueue queue(num_edges);
+        common::CostVector<ev::DurationGraph> costs(num_edges, common::INF_WEIGHT);
+        common::ParentVector<ev::DurationGraph> parents(num_edges, common::INVALID_ID);
+        common::CostVector<ev::MinDurationTurnGraph> view_costs(num_edges, common::INF_WEIGHT);
+        common::ParentVector<ev::MinDurationTurnGraph> view_parents(num_edges,
+                                                                    common::INVALID_ID);
+
+        for (auto start = 0u; start < num_edges; ++start) {
+            for (auto target = 0u; target < num_edges; ++target) {
+                const auto cost = common::dijkstra(
+                    start, target, duration_graph, queue, costs, parents,
+                    common::terminate_key_min<ev::DurationGraph, common::MinIDQueue>);
+                const auto view_cost = common::dijkstra(
+                    start, target, view, queue, view_costs, view_parents,
+                    common::terminate_key_min<ev::MinDurationTurnGraph, common::MinIDQueue>);
+                CHECK(cost == view_cost);
+            }
+        }
+    }
+
+    SECTION("fp_dijkstra") {
+        const ev::TradeoffTurnGraph view(graph, ev::TradeoffTurnCost{model});
+
+        common::MinIDQueue queue(num_edges);
+        common::NodeLabels<ev::TradeoffDijkstraPolicyWithParents> labels(num_edges);
+        common::NodeLabels<ev::TradeoffDijkstraPolicyWithParents> view_labels(num_edges);
+
+        for (auto start = 0u; start < num_edges; ++start) {
+            for (auto target = 0u; target < num_edges; ++target) {
+                const auto result = ev::fp_dijkstra(start, target, turn_graph, queue, labels);
+                const auto view_result =
+                    ev::fp_dijkstra(start, target, view, queue, view_labels);
+                CHECK(result == view_result);
+            }
+        }
+    }
+
+    SECTION("mc_dijkstra") {
+        constexpr std::uint32_t NUM_SAMPLES = 3;
+        const ev::SampledTurnGraph<NUM_SAMPLES> view(graph,
+                                                     ev::SampledTurnCost<NUM_SAMPLES>{model});
+
+        // materialize the same samples
+        std::vector<ev::DurationConsumptionGraph::edge_t> sampled_edges;
+        for (auto node = 0u; node < view.num_nodes(); ++node) {
+            for (auto edge = view.begin(node); edge < view.end(node); ++edge) {
+                sampled_edges.push_back({node, view.target(edge), view.weight(edge)});
+            }
+        }
+        REQUIRE(sampled_edges.size() == NUM_SAMPLES * turn_graph.num_edges());
+        const ev::DurationConsumptionGraph sampled_graph(num_edges, sampled_edges);
+
+        common::MinIDQueue queue(num_edges);
+        common::NodeLabels<ev::DurationConsumptionDijkstraPolicyWithParents> labels(num_edges);
+        common::NodeLabels<ev::DurationConsumptionDijkstraPolicyWithParents> view_labels(
+            num_edges);
+
+        for (auto start = 0u; start < num_edges; ++start) {
+            for (auto target = 0u; target < num_edges; ++target) {
+                const auto result = ev::mc_dijkstra(start, target, sampled_graph, queue, labels);
+                const auto view_result =
+                    ev::mc_dijkstra(start, target, view, queue, view_labels);
+                CHECK(result == view_result);
+            }
+        }
+    }
+}
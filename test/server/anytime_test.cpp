@@ -0,0 +1,105 @@
+#include "server/handlers/anytime.hpp"
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace charge;
+using namespace charge::server;
+
+namespace {
+// Finds one route per query starting with the given run and cancels the deadline in the
+// given run
+struct FakeContext {
+    std::vector<int> operator()(const std::uint32_t, const std::uint32_t) {
+        if (++runs == cancel_run)
+            common::Deadline::get().cancel();
+        return runs >= first_reachable_run ? std::vector<int>{runs} : std::vector<int>{};
+    }
+
+    double x_eps = 0;
+    double y_eps = 0;
+    int runs = 0;
+    int cancel_run = 0;
+    int first_reachable_run = 1;
+};
+
+auto to_results(const std::vector<int> &solutions) {
+    std::vector<RouteResult> results(solutions.size());
+    for (auto index = 0u; index < solutions.size(); ++index)
+        results[index].path = {static_cast<std::uint32_t>(solutions[index])};
+    return results;
+}
+} // namespace
+
+TEST_CASE("Anytime routes refine until the deadline", "[anytime]") {
+    const auto &epsilons = handlers::detail::ANYTIME_EPSILONS;
+    auto &deadline = common::Deadline::get();
+
+    SECTION("Without deadline only the finest epsilons are used") {
+        deadline.reset();
+        FakeContext context;
+        auto results = handlers::detail::anytime_route(context, 0, 1, to_results);
+        CHECK(context.runs == 1);
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].x_epsilon == std::get<0>(epsilons.back()));
+        CHECK(results[0].y_epsilon == std::get<1>(epsilons.back()));
+        CHECK(!results[0].partial);
+    }
+
+    SECTION("Refines until the finest epsilons") {
+        deadline.reset(60);
+        FakeContext context;
+        auto results = handlers::detail::anytime_route(context, 0, 1, to_results);
+        CHECK(context.runs == static_cast<int>(epsilons.size()));
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].path.front() == epsilons.size());
+        CHECK(results[0].x_epsilon == std::get<0>(epsilons.back()));
+        CHECK(!deadline.is_expired());
+    }
+
+    SECTION("Keeps the last complete answer if a refinement expires") {
+        deadline.reset(60);
+        FakeContext context;
+        context.cancel_run = 2;
+        auto results = handlers::detail::anytime_route(context, 0, 1, to_results);
+        CHECK(context.runs == 2);
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].path.front() == 1);
+        CHECK(results[0].x_epsilon == std::get<0>(epsilons.front()));
+        CHECK(results[0].y_epsilon == std::get<1>(epsilons.front()));
+        // the answer is complete for its epsilons
+        CHECK(!deadline.is_expired());
+    }
+
+    SECTION("Returns the partial answer if the first run expires") {
+        deadline.reset(60);
+        FakeContext context;
+        context.cancel_run = 1;
+        auto results = handlers::detail::anytime_route(context, 0, 1, to_results);
+        CHECK(context.runs == 1);
+        REQUIRE(results.size() == 1);
+        CHECK(deadline.is_expired());
+    }
+
+    SECTION("Keeps refining if a coarse run finds no route") {
+        deadline.reset(60);
+        FakeContext context;
+        context.first_reachable_run = 2;
+        auto results = handlers::detail::anytime_route(context, 0, 1, to_results);
+        CHECK(context.runs == static_cast<int>(epsilons.size()));
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].x_epsilon == std::get<0>(epsilons.back()));
+    }
+
+    SECTION("Tries all epsilons if the target is unreachable") {
+        deadline.reset(60);
+        FakeContext context;
+        context.first_reachable_run = static_cast<int>(epsilons.size()) + 1;
+        auto results = handlers::detail::anytime_route(context, 0, 1, to_results);
+        CHECK(context.runs == static_cast<int>(epsilons.size()));
+        CHECK(results.empty());
+    }
+
+    deadline.reset();
+}
@@ -11,11 +11,37 @@
 #include <catch.hpp>
 
 #include <algorithm>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 using namespace charge;
 using namespace charge::server;
 
+namespace {
+// Copy of a data directory in the temporary directory that is removed again
+struct TemporaryCopy {
+    TemporaryCopy(const std::string &from, const std::string &name)
+        : path((std::filesystem::temp_directory_path() /
+                (name + "_" + std::to_string(std::random_device{}())))
+                   .string()) {
+        std::filesystem::copy(from, path, std::filesystem::copy_options::recursive);
+    }
+    ~TemporaryCopy() {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+
+    TemporaryCopy(const TemporaryCopy &) = delete;
+    TemporaryCopy &operator=(const TemporaryCopy &) = delete;
+
+    const std::string path;
+};
+} // namespace
+
 void test_algorithm(
     const Charge &charge, const Charge::Algorithm algorithm,
     const std::vector<std::tuple<common::Coordinate, common::Coordinate>>
@@ -245,4 +271,55 @@ TEST_CASE("Start server", "[Server]") {
     test_algorithm(charge, Charge::Algorithm::FASTEST_BI_DIJKSTRA, queries, references);
     test_algorithm(charge, Charge::Algorithm::MCC_DIJKSTRA, queries, references);
     test_algorithm(charge, Charge::Algorithm::FPC_DIJKSTRA, queries, references);
+
+    const Charge parallel_fastest(base, 16000.0f,
+                                  {Charge::Algorithm::FASTEST_PARALLEL_BI_DIJKSTRA});
+    test_algorithm(parallel_fastest, Charge::Algorithm::FASTEST_PARALLEL_BI_DIJKSTRA, queries,
+                   references);
+
+    SECTION("Landmarks of a different graph are rejected") {
+        // work on a copy, so the stale landmarks never end up in the shared fixture
+        const TemporaryCopy copy(base, "charge_test_stale_landmarks");
+
+        // distances of a graph with one node less
+        common::Landmarks<ev::DurationGraph> stale{{0, 3}, std::vector<std::int32_t>(2 * 10, 0),
+                                                   std::vector<std::int32_t>(2 * 10, 0)};
+        common::files::write_landmarks(copy.path, stale);
+        CHECK_THROWS_WITH(Charge(copy.path, 16000.0f), Catch::Contains("don't match the graph"));
+    }
+
+    SECTION("Concurrent queries use their own contexts") {
+        constexpr std::size_t NUM_THREADS = 4;
+        const Charge parallel_charge(base, 16000.0f, Charge::ALL_ALGORITHMS, NUM_THREADS);
+
+        for (const auto algorithm : {Charge::Algorithm::MCC_DIJKSTRA,
+                                     Charge::Algorithm::FPC_DIJKSTRA}) {
+            // Catch assertions are not thread safe, only collect the paths
+            std::vector<std::vector<std::vector<std::uint32_t>>> paths(NUM_THREADS);
+            std::vector<std::thread> threads;
+            for (auto thread : common::irange<std::size_t>(0, NUM_THREADS)) {
+                threads.emplace_back([&, thread] {
+                    for (auto repetition = 0; repetition < 10; ++repetition) {
+                        for (const auto &[start_coord, target_coord] : queries) {
+                            auto start = parallel_charge.nearest(start_coord);
+                            auto target = parallel_charge.nearest(target_coord);
+                            paths[thread].push_back(
+                                parallel_charge.route(algorithm, start.id, target.id)
+                                    .front()
+                                    .path);
+                        }
+                    }
+                });
+            }
+            for (auto &thread : threads)
+                thread.join();
+
+            for (const auto &thread_paths : paths) {
+                REQUIRE(thread_paths.size() == 10 * references.size());
+                for (auto index : common::irange<std::size_t>(0, thread_paths.size())) {
+                    CHECK(thread_paths[index] == references[index % references.size()].path);
+                }
+            }
+        }
+    }
 }
@@ -0,0 +1,86 @@
+#include "server/handlers/context_pool.hpp"
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace charge;
+using namespace charge::server;
+
+namespace {
+struct CountingContext {
+    int id;
+    int queries = 0;
+};
+} // namespace
+
+TEST_CASE("Context pool reuses returned contexts", "[context pool]") {
+    int num_made = 0;
+    handlers::ContextPool<CountingContext> pool(2, [&] {
+        return std::make_unique<CountingContext>(CountingContext{num_made++});
+    });
+    CHECK(pool.size() == 1);
+    CHECK(pool.capacity() == 2);
+
+    {
+        auto first = pool.checkout();
+        first->queries++;
+        CHECK(first->id == 0);
+
+        // only created once the first context is busy
+        auto second = pool.checkout();
+        CHECK(second->id == 1);
+        CHECK(pool.size() == 2);
+    }
+
+    auto context = pool.checkout();
+    CHECK(pool.size() == 2);
+    CHECK(num_made == 2);
+    CHECK((context->id == 0 || context->id == 1));
+}
+
+TEST_CASE("Context pool never hands out a context twice", "[context pool]") {
+    constexpr std::size_t NUM_CONTEXTS = 3;
+    constexpr int NUM_THREADS = 8;
+    constexpr int NUM_QUERIES = 200;
+
+    std::atomic<int> num_made{0};
+    handlers::ContextPool<CountingContext> pool(NUM_CONTEXTS, [&] {
+        return std::make_unique<CountingContext>(CountingContext{num_made++});
+    });
+
+    std::atomic<int> in_use{0};
+    std::atomic<int> max_in_use{0};
+    std::vector<std::thread> threads;
+    for (auto thread = 0; thread < NUM_THREADS; ++thread) {
+        threads.emplace_back([&] {
+            for (auto query = 0; query < NUM_QUERIES; ++query) {
+                auto context = pool.checkout();
+                auto current = ++in_use;
+                auto max = max_in_use.load();
+                while (current > max && !max_in_use.compare_exchange_weak(max, current)) {
+                }
+                // a data race here would lose increments
+                context->queries++;
+                std::this_thread::yield();
+                --in_use;
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    CHECK(max_in_use <= static_cast<int>(NUM_CONTEXTS));
+    CHECK(num_made <= static_cast<int>(NUM_CONTEXTS));
+    CHECK(pool.size() == static_cast<std::size_t>(num_made));
+
+    int total = 0;
+    std::vector<handlers::ContextPool<CountingContext>::Handle> handles;
+    for (auto index = 0; index < num_made; ++index) {
+        handles.push_back(pool.checkout());
+        total += handles.back()->queries;
+    }
+    CHECK(total == NUM_THREADS * NUM_QUERIES);
+}
@@ -110,6 +110,7 @@ TEST_CASE("Start http server", "[HTTP]") {
         "/route?algorithm=fastest_bi_dijkstra&start=0&target=9",
         "/nearest?lon=0.0&lat=0.0",
         "/nearest?lon=5.0&lat=1.0",
+        "/table?sources=0,9&targets=1,9",
     };
 
     const Charge charge(base, 16000.0f);
@@ -142,7 +143,10 @@ TEST_CASE("Start http server", "[HTTP]") {
         "duration\":1.9}]}],\"start\":0,\"target\":9}",
 
         "{\"coordinate\":[0.0,0.0],\"id\":0}",
-        "{\"coordinate\":[5,1],\"id\":10}"
+        "{\"coordinate\":[5,1],\"id\":10}",
+
+        "{\"consumptions\":[[1,5],[4,0.0]],\"durations\":[[0.1,1.9],[2.6,0.0]],"
+        "\"sources\":[0,9],\"targets\":[1,9]}"
 
     };
 
@@ -150,6 +154,22 @@ TEST_CASE("Start http server", "[HTTP]") {
     CHECK(results[1] == references[1]);
     CHECK(results[2] == references[2]);
     CHECK(results[3] == references[3]);
+    CHECK(results[4] == references[4]);
+
+    // an expired deadline before any route was found
+    httplib::Client client("localhost", 5000);
+    auto timeout = client.Get("/route?algorithm=mc_dijkstra&start=0&target=9&timeout_ms=0");
+    REQUIRE(timeout);
+    CHECK(timeout->status == 503);
+    CHECK(timeout->body == "{\"error\":\"Query timed out.\"}");
+
+    // ids that don't fit into 32 bit are rejected instead of truncated
+    auto overflow = client.Get("/table?sources=0,4294967296&targets=1");
+    REQUIRE(overflow);
+    CHECK(overflow->status == 400);
+    auto too_long = client.Get("/table?sources=0&targets=99999999999999999999999");
+    REQUIRE(too_long);
+    CHECK(too_long->status == 400);
 
     server.stop();
 }